@@ -374,6 +374,26 @@ static void make_nav_sat(void) {
   write_output("nav_sat.ubx");
 }
 
+/* A frame with an all zero body for every message of UBX_MESSAGE_LIST */
+static void make_empty_messages(void) {
+  uint8_t frame[4096];
+  uint16_t frame_len;
+
+#define MAKE_EMPTY_MESSAGE(CLASS, MSG, name)                              \
+  {                                                                       \
+    ubx_##name msg;                                                       \
+    memset(&msg, 0, sizeof(msg));                                         \
+    msg.class_id = UBX_CLASS_##CLASS;                                     \
+    msg.msg_id = UBX_MSG_##CLASS##_##MSG;                                 \
+    frame_len = ubx_encode_frame(msg.class_id, msg.msg_id, &msg, frame);  \
+    msg.length = frame_len - 8;                                           \
+    frame_len = ubx_encode_frame(msg.class_id, msg.msg_id, &msg, frame);  \
+    write_file(#name "_empty.ubx", frame, frame_len);                     \
+  }
+  UBX_MESSAGE_LIST(MAKE_EMPTY_MESSAGE)
+#undef MAKE_EMPTY_MESSAGE
+}
+
 void make_ubx_testcases(void) {
   make_rawx();
   make_sfrbx_gps();
@@ -381,4 +401,5 @@ void make_ubx_testcases(void) {
   make_sfrbx_gal();
   make_sfrbx_bds();
   make_nav_sat();
+  make_empty_messages();
 }
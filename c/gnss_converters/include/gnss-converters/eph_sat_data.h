@@ -1,13 +1,20 @@
 #ifndef GNSS_CONVERTERS_EPH_SAT_DATA_H
 #define GNSS_CONVERTERS_EPH_SAT_DATA_H
 
+#include <stdbool.h>
 #include <swiftnav/signal.h>
 
+/* The last_eph members hold the ephemeris bearing bits of the set last turned
+ * into an ephemeris (time of transmission and parity excluded), a complete
+ * set matching them is skipped without being decoded again. */
+
 struct sat_data {
   struct subframe {
     u32 words[10];
   } sf[3];
   unsigned vmask;
+  u32 last_eph[3][9];
+  bool last_eph_valid;
 };
 
 struct gal_sat_data {
@@ -15,6 +22,8 @@ struct gal_sat_data {
     u32 words[8];
   } pg[5];
   unsigned vmask;
+  u32 last_eph[5][5];
+  bool last_eph_valid;
 };
 
 struct glo_sat_data {
@@ -23,6 +32,10 @@ struct glo_sat_data {
   } string[5];
   unsigned vmask;
   u16 curr_superframe_id;
+  u32 last_eph[5][3];
+  s32 last_eph_fcn;
+  s32 last_eph_leap_seconds;
+  bool last_eph_valid;
 };
 
 struct eph_sat_data {
@@ -30,6 +43,10 @@ struct eph_sat_data {
   struct sat_data bds_sat_data[NUM_SATS_BDS];
   struct gal_sat_data gal_sat_data[NUM_SATS_GAL];
   struct glo_sat_data glo_sat_data[NUM_SATS_GLO];
+  /* Complete subframe sets turned into an SBP ephemeris, and those skipped
+   * because they were identical to the previous one of the satellite */
+  u32 eph_emitted;
+  u32 eph_skipped;
 };
 
 #endif
@@ -27,9 +27,19 @@ extern "C" {
 
 #define DEFAULT_IXCOM_SENDER_ID 4711
 
+#define IXCOM_MAX_IMU_BATCH 64
+
 struct ixcom_sbp_state {
   u8 read_buffer[IXCOM_BUFFER_SIZE];
+  /* end of the bytes buffered in read_buffer */
   size_t index;
+  /* start of the first frame in read_buffer which is yet to be handled */
+  size_t offset;
+  /* length of the validated frame at offset, 0 if there is none */
+  size_t frame_length;
+  /* checksum over the first crc_length bytes of the frame at offset */
+  u16 crc;
+  size_t crc_length;
   u16 sender_id;
   int (*read_stream_func)(u8 *buf, size_t len, void *context);
   void (*cb_ixcom_to_sbp)(u16 sender_id,
@@ -38,6 +48,11 @@ struct ixcom_sbp_state {
                           void *context);
   void *context;
   u8 imu_raw_msgs_sent;
+  /* IMURAW frames held back for batching, see ixcom_sbp_set_imu_batching() */
+  XCOMmsg_IMURAW imu_batch[IXCOM_MAX_IMU_BATCH];
+  size_t imu_batch_length;
+  size_t imu_batch_max_frames;
+  u32 imu_batch_max_span_ms;
 };
 
 void ixcom_sbp_init(struct ixcom_sbp_state *state,
@@ -48,6 +63,29 @@ void ixcom_sbp_init(struct ixcom_sbp_state *state,
                     void *context);
 void ixcom_handle_frame(struct ixcom_sbp_state *state);
 void ixcom_set_sender_id(struct ixcom_sbp_state *state, u16 sender_id);
+
+/**
+ * Enables batching of IMURAW frames for high rate IMU streams. Up to
+ * `max_frames` consecutive frames are held back and then converted and sent
+ * in one go. A batch is sent early once it spans `max_span_ms` (in GPS time),
+ * if the next frame is further than that from the first frame of the batch,
+ * if a frame of another type arrives, or at the end of the stream. A
+ * `max_frames` of 0 or 1 disables batching. It is capped at
+ * IXCOM_MAX_IMU_BATCH.
+ *
+ * The bound is in IMU time, so it only holds while frames keep arriving. If
+ * the input stalls, up to `max_frames` - 1 frames wait for the next frame.
+ * Callers reading from a live link should call ixcom_sbp_flush() when a read
+ * times out.
+ */
+void ixcom_sbp_set_imu_batching(struct ixcom_sbp_state *state,
+                                size_t max_frames,
+                                u32 max_span_ms);
+
+/**
+ * Sends the IMURAW frames held back for batching, if there are any.
+ */
+void ixcom_sbp_flush(struct ixcom_sbp_state *state);
 int ixcom_sbp_process(struct ixcom_sbp_state *state,
                       int (*read_stream_func)(u8 *buff,
                                               size_t len,
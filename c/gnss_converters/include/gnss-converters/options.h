@@ -21,12 +21,17 @@ typedef enum verbosity_level_e {
   VERB_HIGHEST
 } verbosity_level_t;
 
+/* Number of GLO bands (L1, L2) with user supplied FCN biases */
+#define SBP_GLO_FCN_BIAS_BANDS 2
+
 extern float sbp_signal_biases[CODE_COUNT];
-extern float sbp_glo_code_bias[2];
-extern float sbp_glo_phase_bias[2];
+extern float sbp_glo_code_bias[SBP_GLO_FCN_BIAS_BANDS];
+extern float sbp_glo_phase_bias[SBP_GLO_FCN_BIAS_BANDS];
 extern bool constellation_mask[CONSTELLATION_COUNT];
 extern verbosity_level_t verbosity_level;
 
+int glo_fcn_bias_band(code_t code);
+void glo_fcn_band_bias(u8 band, u8 glo_fcn, double *p_code, double *p_phase);
 void msm_glo_fcn_bias(const rtcm_msm_header *header,
                       u8 signal_index,
                       u8 glo_fcn,
@@ -51,14 +51,19 @@ typedef enum {
   UNSUPPORTED_CODE_MAX
 } unsupported_code_t;
 
-/* A struct for storing either an SSR orbit correction message
-or an SSR clock correction message. Used for combining the
-separate messages into a combined message */
+/* A struct for storing either the SSR orbit correction or the SSR clock
+correction of a single satellite. Used for combining the separate messages
+into a combined message as soon as the matching correction arrives */
 typedef struct {
   union {
-    rtcm_msg_clock clock;
-    rtcm_msg_orbit orbit;
+    rtcm_msg_ssr_clock_corr clock;
+    rtcm_msg_ssr_orbit_corr orbit;
   } data;
+  /* Header fields of the message the correction came from, a pair is only
+  formed when both corrections share the same epoch and IOD SSR */
+  uint32_t epoch_time;
+  uint8_t iod_ssr;
+  uint8_t update_interval;
   /* Only one of these can be true at once (or neither) */
   bool contains_clock; /* True if clock contains data */
   bool contains_orbit; /* True if orbit contains data */
@@ -66,6 +71,9 @@ typedef struct {
 
 typedef bool (*rtcm_sbp_unix_time_callback_t)(int64_t *now);
 
+/* Number of 32 bit words needed to hold one bit for every code_t value */
+#define RTCM_MEAS_CODE_MASK_WORDS ((CODE_COUNT + 31) / 32)
+
 /** Represent measurement info of single satellite. Satellite info is
  * transmitted under a range of signal (eg L1/L2/L5). Each signal has a code and
  * CNO. */
@@ -75,15 +83,44 @@ struct rtcm_meas_sat_signal {
     code_t code;
   } sig_data[RTCM_MAX_SINGLE_SAT_SIGNAL];
   uint8_t n_signal;
+  /* Generation of the map in which this entry was last written. The entry is
+   * treated as empty unless it matches rtcm3_sbp_state::cons_meas_epoch */
+  uint32_t epoch;
+  /* Bitset of the codes held in sig_data, indexed by code_t */
+  uint32_t code_mask[RTCM_MEAS_CODE_MASK_WORDS];
 };
 
-/** Represent info of single constellation, including a list of gnss satellites
-and maximum number of satellites. */
+/** Represent info of single constellation as a list of gnss satellites. */
 struct rtcm_gnss_signal {
-  uint8_t max_n_sat;
   struct rtcm_meas_sat_signal sat_data[MAX_NUM_SATS];
 };
 
+/** FCN and FCN dependent biases of a GLO satellite, resolved once and reused
+ * for every MSM cell of the satellite. */
+struct rtcm_glo_sat_cache {
+  /* The entry is stale unless it matches rtcm3_sbp_state::glo_sat_generation
+   * and the current sbp_glo_code_bias / sbp_glo_phase_bias ratios */
+  uint32_t generation;
+  float code_bias_ratio[2];
+  float phase_bias_ratio[2];
+  /* FCN from the MSM satellite info the entry was resolved with */
+  u8 fcn_from_sat_info;
+  u8 glo_fcn;
+  /* Indexed by FCN bias band (L1, L2) */
+  double code_bias_m[2];
+  double phase_bias_c[2];
+};
+
+/** Last GLO time of day resolved into GPS time, messages of the same epoch
+ * share the result. */
+struct rtcm_glo_time_cache {
+  bool valid;
+  u32 tod_ms;
+  int8_t leap_seconds;
+  gps_time_t rover_time;
+  gps_time_t obs_time;
+};
+
 struct rtcm3_sbp_state {
   bool has_cached_time;
   bool cached_gps_time_known;
@@ -139,15 +176,24 @@ struct rtcm3_sbp_state {
   bool sent_code_warning[UNSUPPORTED_CODE_MAX];
   /* GLO FCN map, indexed by 1-based PRN */
   u8 glo_sv_id_fcn_map[NUM_SATS_GLO + 1];
-  /* The cache for storing the first message before combining the separate
-  orbit and clock messages into a combined SBP message */
-  ssr_orbit_clock_cache orbit_clock_cache[CONSTELLATION_COUNT];
+  /* Per satellite FCN cache, indexed by 1-based PRN. Bumping the generation
+   * (on 1020 and 1230) invalidates all entries */
+  struct rtcm_glo_sat_cache glo_sat_cache[NUM_SATS_GLO + 1];
+  uint32_t glo_sat_generation;
+  struct rtcm_glo_time_cache glo_time_cache;
+  /* The per satellite cache for storing the first correction before combining
+  the separate orbit and clock messages into a combined SBP message. Indexed
+  by constellation and SSR satellite ID */
+  ssr_orbit_clock_cache orbit_clock_cache[CONSTELLATION_COUNT]
+                                         [MAX_SSR_SATELLITES];
   uint8_t fifo_buf[RTCM3_FIFO_SIZE];
   fifo_t fifo;
   struct eph_sat_data eph_data;
   sbp_state_t sbp_state;
 
-  /* Track azel and meas full msg when receiving stgsv msg */
+  /* Track azel and meas full msg when receiving stgsv msg. The full msgs are
+   * only initialised once the first stgsv msg arrives on the stream */
+  bool stgsv_initialized;
   uint32_t tow_ms_azel;
   uint32_t tow_ms_meas;
   sbp_msg_t msg_azel_full;
@@ -161,6 +207,8 @@ struct rtcm3_sbp_state {
    * the array is stored in the order of constellation enum defined in
    * rtcm_constellation_t. Info is extracted from the observation msgs. */
   struct rtcm_gnss_signal cons_meas_map[RTCM_CONSTELLATION_COUNT];
+  /* Current generation of cons_meas_map, bumping it invalidates all entries */
+  uint32_t cons_meas_epoch;
 };
 
 /**
@@ -316,6 +364,14 @@ int rtcm2sbp_process(struct rtcm3_sbp_state *state,
                                              size_t len,
                                              void *context));
 
+size_t rtcm2sbp_process_buffer(struct rtcm3_sbp_state *state,
+                               const uint8_t *data,
+                               size_t length);
+
+size_t rtcm2sbp_frame_boundary(const uint8_t *data,
+                               size_t length,
+                               size_t offset);
+
 #ifdef __cplusplus
 }
 #endif
@@ -19,11 +19,16 @@
 #include <libsbp/v4/observation.h>
 #include <libsbp/v4/orientation.h>
 #include <libsbp/v4/tracking.h>
+#include <stddef.h>
 
 /* Max number of sats visible in an epoch */
 #define MAX_SATS 256
 #define MAX_FUSED_WAGON_MSGS (SBP_MAX_PAYLOAD_LEN / sizeof(uint16_t))
 
+/* Room for all the sentences of one epoch when they are delivered as one
+ * block, see sbp2nmea_epoch_block_set() */
+#define SBP2NMEA_EPOCH_BUF_LEN 4096
+
 typedef enum sbp2nmea_nmea_id {
   SBP2NMEA_NMEA_GGA = 0,
   SBP2NMEA_NMEA_RMC = 1,
@@ -101,6 +106,14 @@ typedef struct sbp2nmea_state {
    * noise in the SOG. */
   float cog_update_threshold_mps;
   double last_non_stationary_cog;
+
+  /* Length aware output, used instead of cb_sbp_to_nmea when set. The
+   * sentences are not NUL terminated when delivered as an epoch block. */
+  void (*cb_sbp_to_nmea_buf)(const char *buf, size_t len, void *ctx);
+  bool epoch_block;
+  uint32_t epoch_tow;
+  size_t epoch_len;
+  char epoch_buf[SBP2NMEA_EPOCH_BUF_LEN];
 } sbp2nmea_t;
 
 #ifdef __cplusplus
@@ -112,6 +125,13 @@ void sbp2nmea_init(sbp2nmea_t *state,
                    void (*cb_sbp_to_nmea)(char *msg, void *ctx),
                    void *ctx);
 
+void sbp2nmea_init_buf(sbp2nmea_t *state,
+                       sbp2nmea_mode_t mode,
+                       void (*cb_sbp_to_nmea_buf)(const char *buf,
+                                                  size_t len,
+                                                  void *ctx),
+                       void *ctx);
+
 void sbp2nmea(sbp2nmea_t *state,
               const sbp_msg_t *sbp_msg,
               sbp2nmea_sbp_id_t sbp_id);
@@ -124,6 +144,14 @@ uint8_t sbp2nmea_num_obs_get(const sbp2nmea_t *state);
 const sbp_v4_gnss_signal_t *sbp2nmea_nav_sids_get(const sbp2nmea_t *state);
 
 void sbp2nmea_to_str(const sbp2nmea_t *state, char *sentence);
+void sbp2nmea_to_buf(sbp2nmea_t *state, char *sentence, size_t len);
+
+/* With epoch blocks enabled the sentences of an epoch are collected and
+ * handed to cb_sbp_to_nmea_buf in one call. A block is delivered once every
+ * sentence due on the epoch has been sent, or at the latest when the next
+ * epoch starts or sbp2nmea_flush() is called. */
+void sbp2nmea_epoch_block_set(sbp2nmea_t *state, bool epoch_block);
+void sbp2nmea_flush(sbp2nmea_t *state);
 
 const sbp_msg_t *sbp2nmea_msg_get(const sbp2nmea_t *state,
                                   sbp2nmea_sbp_id_t id,
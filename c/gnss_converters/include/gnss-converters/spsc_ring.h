@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 Swift Navigation Inc.
+ * Contact: Swift Navigation <dev@swiftnav.com>
+ *
+ * This source is subject to the license found in the file 'LICENSE' which must
+ * be be distributed together with this source. All other rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#ifndef GNSS_CONVERTERS_SPSC_RING_H
+#define GNSS_CONVERTERS_SPSC_RING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Lock-free single producer / single consumer byte ring.
+ *
+ * Exactly one thread may call spsc_ring_write() and spsc_ring_close(), and
+ * exactly one (other) thread may call spsc_ring_read(). The statistics
+ * accessors may be called from either thread. The index and counter fields
+ * are only ever accessed through C11 atomics inside spsc_ring.c, they are
+ * declared as plain integers here so that the header remains usable from
+ * C99 and C++ translation units.
+ */
+typedef struct {
+  uint8_t *buffer;   /**< caller owned storage */
+  size_t mask;       /**< storage size - 1, size must be a power of two */
+  size_t head;       /**< total bytes written, owned by the producer */
+  size_t tail;       /**< total bytes read, owned by the consumer */
+  size_t dropped;    /**< total bytes dropped because the ring was full */
+  size_t high_water; /**< largest occupancy observed by the producer */
+  size_t closed;     /**< non-zero once the producer has finished */
+} spsc_ring_t;
+
+/**
+ * Initializes the ring on top of caller provided storage.
+ *
+ * @param ring ring to initialize
+ * @param buffer storage for the ring
+ * @param size size of the storage, must be a non-zero power of two
+ * @return true on success, false if size is not a power of two
+ */
+bool spsc_ring_init(spsc_ring_t *ring, uint8_t *buffer, size_t size);
+
+/**
+ * Appends a chunk of bytes to the ring (producer side). The chunk is either
+ * written in full or, if there isn't enough free space, dropped in full and
+ * accounted for in the drop counter. Keeping chunks whole means the consumer
+ * only ever sees a gap between two reads rather than a torn read.
+ *
+ * @return number of bytes written, either 0 or len
+ */
+size_t spsc_ring_write(spsc_ring_t *ring, const uint8_t *data, size_t len);
+
+/**
+ * Marks the ring as closed (producer side), no further writes may follow.
+ */
+void spsc_ring_close(spsc_ring_t *ring);
+
+/**
+ * Copies up to len of the oldest bytes out of the ring (consumer side).
+ *
+ * @return number of bytes copied, 0 if the ring is empty
+ */
+size_t spsc_ring_read(spsc_ring_t *ring, uint8_t *data, size_t len);
+
+/**
+ * @return true once the producer closed the ring and all bytes were consumed
+ */
+bool spsc_ring_drained(const spsc_ring_t *ring);
+
+/**
+ * @return number of bytes currently held in the ring
+ */
+size_t spsc_ring_occupancy(const spsc_ring_t *ring);
+
+/**
+ * @return total number of bytes dropped by spsc_ring_write()
+ */
+size_t spsc_ring_dropped(const spsc_ring_t *ring);
+
+/**
+ * @return largest occupancy seen by the producer since initialization
+ */
+size_t spsc_ring_high_water(const spsc_ring_t *ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNSS_CONVERTERS_SPSC_RING_H */
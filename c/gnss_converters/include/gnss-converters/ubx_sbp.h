@@ -17,6 +17,7 @@
 #include <gnss-converters/time_truth_v2.h>
 #include <libsbp/sbp.h>
 #include <libsbp/v4/gnss.h>
+#include <libsbp/v4/imu.h>
 #include <libsbp/v4/navigation.h>
 #include <libsbp/v4/observation.h>
 #include <libsbp/v4/orientation.h>
@@ -40,6 +41,8 @@ extern "C" {
 #define UBX_LENGTH_BYTE_COUNT (2)
 #define UBX_CHECKSUM_BYTE_COUNT (2)
 
+/* Frames are decoded in place from the read buffer, so it must be able to hold
+ * the largest frame accepted (excluding the sync characters) */
 #define UBX_BUFFER_SIZE 4096
 #define UBX_FRAME_SIZE 4096
 
@@ -63,6 +66,26 @@ struct ubx_esf_state {
   bool weeknumber_set;
 };
 
+/* Syncs data between HNR_PVT and NAV_PVT */
+struct ubx_pvt_state {
+  u8 num_sats;
+  u8 flags;
+  u8 fix_type;
+};
+
+/* Upper bound on the SBP messages produced from one ESF-RAW frame: at most
+ * 128 samples make 21 IMU_RAW messages, preceded by up to 2 IMU_AUX. */
+#define UBX_ESF_RAW_MAX_SBP_MSGS 23
+
+/* Output slot of the batched ESF-RAW conversion */
+struct ubx_sbp_imu_msg {
+  sbp_msg_type_t msg_type; /* SbpMsgImuRaw or SbpMsgImuAux */
+  union {
+    sbp_msg_imu_raw_t imu_raw;
+    sbp_msg_imu_aux_t imu_aux;
+  } msg;
+};
+
 struct ubx_sbp_state {
   u8 read_buffer[UBX_BUFFER_SIZE];
   size_t index;
@@ -76,6 +99,7 @@ struct ubx_sbp_state {
   void *context;
   bool use_hnr;
   struct ubx_esf_state esf_state;
+  struct ubx_pvt_state pvt_state;
 
   struct eph_sat_data eph_data;
   u32 last_tow_ms;
@@ -91,6 +115,13 @@ struct ubx_sbp_state {
 
 int16_t ubx_convert_temperature_to_bmi160(double temperature_degrees);
 
+/**
+ * Maps a UBX gnssId / sigId pair onto the matching SBP code.
+ *
+ * @return CODE_INVALID for any pair without an SBP equivalent
+ */
+code_t ubx_convert_gnssid_sigid(u8 gnss_id, u8 sig_id);
+
 void ubx_sbp_init(struct ubx_sbp_state *state,
                   void (*cb_ubx_to_sbp)(uint16_t sender_id,
                                         sbp_msg_type_t msg_type,
@@ -103,6 +134,28 @@ void ubx_set_sender_id(struct ubx_sbp_state *state, u16 sender_id);
 void ubx_set_hnr_flag(struct ubx_sbp_state *state, bool use_hnr);
 int ubx_sbp_process(struct ubx_sbp_state *state,
                     int (*read_stream_func)(u8 *buff, size_t len, void *ctx));
+size_t ubx_sbp_process_buffer(struct ubx_sbp_state *state,
+                              const u8 *data,
+                              size_t length);
+size_t ubx_sbp_frame_boundary(const u8 *data, size_t length, size_t offset);
+
+/**
+ * Converts every IMU sample of an ESF-RAW frame in one go, writing the
+ * resulting IMU_RAW and IMU_AUX messages to `msgs` in the order in which
+ * they would otherwise have been passed to the converter callback. Each
+ * IMU_AUX carries the gyro temperature that was current at the sample it
+ * precedes. The callback is not invoked.
+ *
+ * @param state pointer to converter object
+ * @param frame ESF-RAW frame, as handed to ubx_handle_frame()
+ * @param msgs output buffer, UBX_ESF_RAW_MAX_SBP_MSGS entries always suffice
+ * @param max_msgs number of entries in `msgs`
+ * @return number of messages written
+ */
+size_t ubx_convert_esf_raw(struct ubx_sbp_state *state,
+                           swiftnav_bytestream_t *frame,
+                           struct ubx_sbp_imu_msg *msgs,
+                           size_t max_msgs);
 
 /**
  * Offers the means for users to enlist time estimator instance which the
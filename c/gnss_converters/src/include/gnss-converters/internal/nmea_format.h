@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 Swift Navigation Inc.
+ * Contact: Swift Navigation <dev@swiftnav.com>
+ *
+ * This source is subject to the license found in the file 'LICENSE' which must
+ * be be distributed together with this source. All other rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#ifndef GNSS_CONVERTERS_INTERNAL_NMEA_FORMAT_H
+#define GNSS_CONVERTERS_INTERNAL_NMEA_FORMAT_H
+
+#include <stdint.h>
+
+/* Largest number of decimals supported by nmea_format_fixed() */
+#define NMEA_FORMAT_MAX_DECIMALS 9
+
+/**
+ * Output cursor for the NMEA field emitters.
+ *
+ * The emitters behave exactly like successive snprintf(ptr, end - ptr, ...)
+ * calls: output is truncated to fit, the buffer is always NUL terminated and
+ * ptr is advanced by the untruncated length but never past end. The NMEA
+ * checksum, i.e. the XOR of all the bytes written, is updated on the fly.
+ */
+typedef struct {
+  char *ptr;        /**< next write position */
+  char *end;        /**< end of the usable buffer */
+  uint8_t checksum; /**< XOR of the bytes written so far */
+} nmea_writer_t;
+
+/** Emits a string verbatim, same as "%s". */
+void nmea_format_str(nmea_writer_t *w, const char *str);
+
+/** Emits a single character, same as "%c". */
+void nmea_format_char(nmea_writer_t *w, char c);
+
+/** Emits an unsigned integer zero padded to width, same as "%0*u". */
+void nmea_format_uint(nmea_writer_t *w, uint32_t value, uint8_t width);
+
+/** Emits a signed integer zero padded to width, same as "%0*d". */
+void nmea_format_int(nmea_writer_t *w, int32_t value, uint8_t width);
+
+/**
+ * Emits a fixed decimal number zero padded to width, same as "%0*.*f".
+ *
+ * The value is rounded on its exact binary representation like printf does.
+ * Values which are too large for the integer path, non finite values and the
+ * rare values that lie too close to a rounding tie to be decided reliably are
+ * handed over to snprintf, so the output is always byte identical to it.
+ */
+void nmea_format_fixed(nmea_writer_t *w,
+                       double value,
+                       uint8_t width,
+                       uint8_t decimals);
+
+/**
+ * Emits the absolute value of an angle as NMEA degrees and minutes, i.e. the
+ * degrees zero padded to deg_width followed by the minutes as "%010.7f".
+ *
+ * The angle is rounded to 1e-8 degrees before it is split so that the
+ * minutes never read 60, the split itself is done in integer arithmetic.
+ */
+void nmea_format_deg_min(nmea_writer_t *w, double degrees, uint8_t deg_width);
+
+#endif /* GNSS_CONVERTERS_INTERNAL_NMEA_FORMAT_H */
@@ -243,9 +243,10 @@ void rtcm3_bds_eph_to_sbp(const rtcm_msg_eph *msg_eph,
                           sbp_msg_ephemeris_bds_t *sbp_bds_eph,
                           struct rtcm3_sbp_state *state);
 
-void rtcm3_ssr_separate_orbit_clock_to_sbp(const rtcm_msg_clock *msg_clock,
-                                           const rtcm_msg_orbit *msg_orbit,
-                                           struct rtcm3_sbp_state *state);
+void rtcm3_ssr_separate_orbit_to_sbp(const rtcm_msg_orbit *msg_orbit,
+                                     struct rtcm3_sbp_state *state);
+void rtcm3_ssr_separate_clock_to_sbp(const rtcm_msg_clock *msg_clock,
+                                     struct rtcm3_sbp_state *state);
 void rtcm3_ssr_orbit_clock_to_sbp(const rtcm_msg_orbit_clock *msg_orbit_clock,
                                   struct rtcm3_sbp_state *state);
 void rtcm3_ssr_code_bias_to_sbp(const rtcm_msg_code_bias *msg_code_biases,
@@ -253,6 +254,15 @@ void rtcm3_ssr_code_bias_to_sbp(const rtcm_msg_code_bias *msg_code_biases,
 void rtcm3_ssr_phase_bias_to_sbp(const rtcm_msg_phase_bias *msg_phase_biases,
                                  struct rtcm3_sbp_state *state);
 
+/* Streaming variants of the SSR bias converters, these decode the RTCM message
+ * straight off the bitstream and emit the SBP message of each satellite as
+ * soon as its biases have been read, without going through the full
+ * rtcm_msg_code_bias/rtcm_msg_phase_bias tables. */
+void rtcm3_ssr_code_bias_bitstream_to_sbp(swiftnav_in_bitstream_t *buff,
+                                          struct rtcm3_sbp_state *state);
+void rtcm3_ssr_phase_bias_bitstream_to_sbp(swiftnav_in_bitstream_t *buff,
+                                           struct rtcm3_sbp_state *state);
+
 static inline u16 rtcm_stn_to_sbp_sender_id(u16 rtcm_id) {
   /* To avoid conflicts with reserved low number sender ID's we or
    * on the highest nibble as RTCM sender ID's are 12 bit */
@@ -265,6 +275,9 @@ void handle_ndf_frame(const rtcm_msg_ndf *msg_ndf,
 bool rtcm_get_gps_time(gps_time_t *gps_time, struct rtcm3_sbp_state *state);
 bool rtcm_get_leap_seconds(int8_t *leap_seconds, struct rtcm3_sbp_state *state);
 
+/* The STGSV converters append to the message passed in, starting at its
+ * current number of entries, so that multi-part STGSV messages can be
+ * accumulated in place. */
 void rtcm3_stgsv_azel_to_sbp(const rtcm_msg_999_stgsv *rtcm_999_stgsv,
                              sbp_msg_sv_az_el_t *sbp_sv_az_el,
                              const struct rtcm3_sbp_state *state);
@@ -19,6 +19,10 @@ void ixcom_sbp_init(struct ixcom_sbp_state *state,
                     void *context) {
   memset(state, 0, sizeof(*state));
   state->index = 0;
+  state->offset = 0;
+  state->frame_length = 0;
+  state->crc = 0;
+  state->crc_length = 0;
   state->sender_id = DEFAULT_IXCOM_SENDER_ID;
   state->cb_ixcom_to_sbp = cb_ixcom_to_sbp;
   state->context = context;
@@ -29,64 +33,116 @@ void ixcom_set_sender_id(struct ixcom_sbp_state *state, u16 sender_id) {
   state->sender_id = sender_id;
 }
 
-static int read_ixcom_bytes(struct ixcom_sbp_state *state, size_t num_bytes) {
-  assert(state->index + num_bytes < IXCOM_BUFFER_SIZE);
-
-  int ret = state->read_stream_func(
-      state->read_buffer + state->index, num_bytes, state->context);
+void ixcom_sbp_set_imu_batching(struct ixcom_sbp_state *state,
+                                size_t max_frames,
+                                u32 max_span_ms) {
+  ixcom_sbp_flush(state);
+  state->imu_batch_max_frames =
+      max_frames > IXCOM_MAX_IMU_BATCH ? IXCOM_MAX_IMU_BATCH : max_frames;
+  state->imu_batch_max_span_ms = max_span_ms;
+}
 
-  if (ret > 0) {
-    state->index += ret;
-  }
+/*
+ * Move the unhandled bytes to the start of read_buffer to make room for the
+ * rest of a frame
+ */
+static void compact_ixcom_buffer(struct ixcom_sbp_state *state) {
+  size_t available = state->index - state->offset;
+  memmove(state->read_buffer, state->read_buffer + state->offset, available);
+  state->index = available;
+  state->offset = 0;
+}
 
-  return ret;
+/*
+ * Move on to the frame starting at 'offset', dropping the running checksum
+ */
+static void restart_ixcom_frame(struct ixcom_sbp_state *state, size_t offset) {
+  state->offset = offset;
+  state->frame_length = 0;
+  state->crc = 0;
+  state->crc_length = 0;
 }
 
 /** IXCOM Frame:
  * SYNC byte | Message ID | Frame Counter | Reserved | Message Length (2 bytes)
  * | GPS Week (2 bytes) | GPS TOW (8 bytes) | Payload (variable) | CRC16 (2
  * bytes)
+ *
+ * The stream is read in chunks as large as the free space in read_buffer and
+ * framed in memory. Bytes beyond the returned frame stay buffered for the next
+ * call. The checksum is carried along as the bytes of a frame come in, so a
+ * frame split across reads is never checksummed twice. Candidate frames with
+ * an implausible length or a bad checksum are skipped one byte at a time so
+ * that a stray sync byte can't swallow the frames which follow it.
+ *
+ * \return length of the frame at state->offset, or the last return value of
+ * read_stream_func (0 or negative) if no complete frame could be read
  */
 static int read_ixcom_frame(struct ixcom_sbp_state *state) {
-  int ret;
-
-  do {
-    if (state->index == 0) {
-      ret = read_ixcom_bytes(state, 1);
-      if (ret <= 0) {
-        break;
-      }
+  const size_t header_size = sizeof(XCOMHeader);
+  const size_t min_frame_size = sizeof(XCOMHeader) + sizeof(XCOMFooter);
+
+  while (true) {
+    const u8 *start = state->read_buffer + state->offset;
+    size_t available = state->index - state->offset;
+
+    if (available > 0 && start[0] != XCOM_SYNC_BYTE) {
+      const u8 *sync = memchr(start, XCOM_SYNC_BYTE, available);
+      size_t sync_offset = (sync == NULL)
+                               ? state->index
+                               : (size_t)(sync - state->read_buffer);
+      restart_ixcom_frame(state, sync_offset);
+      continue;
+    }
 
-      if (state->read_buffer[0] != XCOM_SYNC_BYTE) {
-        state->index = 0;
+    size_t needed = header_size;
+    if (available >= header_size) {
+      size_t message_length = start[4] | ((size_t)start[5] << 8);
+      if (message_length < min_frame_size ||
+          message_length > IXCOM_BUFFER_SIZE) {
+        restart_ixcom_frame(state, state->offset + 1);
         continue;
       }
-    }
 
-    size_t header_size = sizeof(XCOMHeader);
-    if (state->index > 0 && state->index < header_size) {
-      ret = read_ixcom_bytes(state, header_size - state->index);
-      if (ret <= 0) {
-        break;
+      size_t crc_end = message_length - 2;
+      if (crc_end > available) {
+        crc_end = available;
       }
-    }
-
-    if (state->index >= header_size) {
-      size_t message_length =
-          state->read_buffer[4] + (state->read_buffer[5] << 8);
-
-      ret = read_ixcom_bytes(state, message_length - state->index);
-      if (ret <= 0) {
-        break;
+      state->crc = ixcom_checksum_update(state->crc,
+                                         start + state->crc_length,
+                                         crc_end - state->crc_length);
+      state->crc_length = crc_end;
+
+      if (available >= message_length) {
+#ifndef GNSS_CONVERTERS_DISABLE_CRC_VALIDATION
+        u16 crc = (u16)(start[message_length - 2] |
+                        (start[message_length - 1] << 8));
+        if (state->crc != crc) {
+          restart_ixcom_frame(state, state->offset + 1);
+          continue;
+        }
+#endif
+        state->frame_length = message_length;
+        return (int)message_length;
       }
+      needed = message_length;
+    }
 
-      if (state->index >= message_length) {
-        return message_length;
-      }
+    if (state->offset == state->index) {
+      state->offset = 0;
+      state->index = 0;
+    } else if (state->offset + needed > IXCOM_BUFFER_SIZE) {
+      compact_ixcom_buffer(state);
     }
-  } while (true);
 
-  return ret;
+    int ret = state->read_stream_func(state->read_buffer + state->index,
+                                      IXCOM_BUFFER_SIZE - state->index,
+                                      state->context);
+    if (ret <= 0) {
+      return ret;
+    }
+    state->index += ret;
+  }
 }
 
 /**
@@ -128,43 +184,101 @@ int16_t float_to_s16_clamped(float val) {
   return ret;
 }
 
+static void convert_imuraw(const XCOMmsg_IMURAW *imuraw,
+                           sbp_msg_imu_raw_t *sbp_imuraw) {
+  /* need temp variable since sbp_imuraw is packed struct */
+  u32 tow;
+  u8 tow_f;
+  convert_ixcom_to_sbp_tow(
+      imuraw->header.gps_time_sec, imuraw->header.gps_time_usec, &tow, &tow_f);
+  sbp_imuraw->tow = tow;
+  sbp_imuraw->tow_f = tow_f;
+  const float sbp_scale_acc_4g = (float)(4.0 * 9.80665 / 32768.0);
+  const float radians_to_degrees = (float)(180.0 / M_PI);
+  const float sbp_scale_125_degs = (float)(125.0 / 32768.0);
+  sbp_imuraw->acc_x = float_to_s16_clamped(imuraw->acc[0] / sbp_scale_acc_4g);
+  sbp_imuraw->acc_y = float_to_s16_clamped(imuraw->acc[1] / sbp_scale_acc_4g);
+  sbp_imuraw->acc_z = float_to_s16_clamped(imuraw->acc[2] / sbp_scale_acc_4g);
+  sbp_imuraw->gyr_x = float_to_s16_clamped(
+      imuraw->omg[0] * radians_to_degrees / sbp_scale_125_degs);
+  sbp_imuraw->gyr_y = float_to_s16_clamped(
+      imuraw->omg[1] * radians_to_degrees / sbp_scale_125_degs);
+  sbp_imuraw->gyr_z = float_to_s16_clamped(
+      imuraw->omg[2] * radians_to_degrees / sbp_scale_125_degs);
+}
+
+static void send_imuraw(struct ixcom_sbp_state *state,
+                        const sbp_msg_imu_raw_t *sbp_imuraw) {
+  sbp_msg_t msg;
+  msg.imu_raw = *sbp_imuraw;
+  state->cb_ixcom_to_sbp(state->sender_id, SbpMsgImuRaw, &msg, state->context);
+
+  if (state->imu_raw_msgs_sent % 100 == 0) {
+    send_imu_aux(state);
+    state->imu_raw_msgs_sent = 0;
+  }
+  state->imu_raw_msgs_sent++;
+}
+
+/* GPS time of an iXCOM frame in milliseconds since the start of GPS time */
+static u64 ixcom_time_ms(const XCOMHeader *header) {
+  return (u64)header->gps_week * WEEK_SECS * 1000 +
+         (u64)header->gps_time_sec * 1000 + header->gps_time_usec / 1000;
+}
+
+/**
+ * Converts and sends all of the IMURAW frames held back for batching. The
+ * conversion runs over the whole batch before any message is sent, the
+ * messages then go out back to back.
+ */
+void ixcom_sbp_flush(struct ixcom_sbp_state *state) {
+  assert(state);
+
+  sbp_msg_imu_raw_t sbp_imuraw[IXCOM_MAX_IMU_BATCH];
+  size_t n = state->imu_batch_length;
+  for (size_t i = 0; i < n; i++) {
+    convert_imuraw(&state->imu_batch[i], &sbp_imuraw[i]);
+  }
+  for (size_t i = 0; i < n; i++) {
+    send_imuraw(state, &sbp_imuraw[i]);
+  }
+  state->imu_batch_length = 0;
+}
+
 void handle_imuraw(struct ixcom_sbp_state *state) {
   assert(state);
 
+  const u8 *frame = state->read_buffer + state->offset;
   XCOMmsg_IMURAW imuraw;
-  if (ixcom_decode_imuraw(state->read_buffer, &imuraw) == IXCOM_RC_OK) {
-    sbp_msg_t sbp_imuraw;
-    /* need temp variable since sbp_imuraw is packed struct */
-    u32 tow;
-    u8 tow_f;
-    convert_ixcom_to_sbp_tow(
-        imuraw.header.gps_time_sec, imuraw.header.gps_time_usec, &tow, &tow_f);
-    sbp_imuraw.imu_raw.tow = tow;
-    sbp_imuraw.imu_raw.tow_f = tow_f;
-    const float sbp_scale_acc_4g = (float)(4.0 * 9.80665 / 32768.0);
-    const float radians_to_degrees = (float)(180.0 / M_PI);
-    const float sbp_scale_125_degs = (float)(125.0 / 32768.0);
-    sbp_imuraw.imu_raw.acc_x =
-        float_to_s16_clamped(imuraw.acc[0] / sbp_scale_acc_4g);
-    sbp_imuraw.imu_raw.acc_y =
-        float_to_s16_clamped(imuraw.acc[1] / sbp_scale_acc_4g);
-    sbp_imuraw.imu_raw.acc_z =
-        float_to_s16_clamped(imuraw.acc[2] / sbp_scale_acc_4g);
-    sbp_imuraw.imu_raw.gyr_x = float_to_s16_clamped(
-        imuraw.omg[0] * radians_to_degrees / sbp_scale_125_degs);
-    sbp_imuraw.imu_raw.gyr_y = float_to_s16_clamped(
-        imuraw.omg[1] * radians_to_degrees / sbp_scale_125_degs);
-    sbp_imuraw.imu_raw.gyr_z = float_to_s16_clamped(
-        imuraw.omg[2] * radians_to_degrees / sbp_scale_125_degs);
+  /* the CRC was verified when the frame was found */
+  if (ixcom_decode_imuraw_unchecked(frame, &imuraw) != IXCOM_RC_OK) {
+    return;
+  }
 
-    state->cb_ixcom_to_sbp(
-        state->sender_id, SbpMsgImuRaw, &sbp_imuraw, state->context);
+  if (state->imu_batch_max_frames <= 1) {
+    sbp_msg_imu_raw_t sbp_imuraw;
+    convert_imuraw(&imuraw, &sbp_imuraw);
+    send_imuraw(state, &sbp_imuraw);
+    return;
+  }
 
-    if (state->imu_raw_msgs_sent % 100 == 0) {
-      send_imu_aux(state);
-      state->imu_raw_msgs_sent = 0;
-    }
-    state->imu_raw_msgs_sent++;
+  /* don't let the batch span more than the latency bound */
+  if (state->imu_batch_length > 0 &&
+      ixcom_time_ms(&imuraw.header) >
+          ixcom_time_ms(&state->imu_batch[0].header) +
+              state->imu_batch_max_span_ms) {
+    ixcom_sbp_flush(state);
+  }
+
+  state->imu_batch[state->imu_batch_length++] = imuraw;
+
+  /* send the batch as soon as it covers the latency bound rather than
+   * waiting for a frame past it, which might be a long time coming */
+  if (state->imu_batch_length >= state->imu_batch_max_frames ||
+      ixcom_time_ms(&imuraw.header) >=
+          ixcom_time_ms(&state->imu_batch[0].header) +
+              state->imu_batch_max_span_ms) {
+    ixcom_sbp_flush(state);
   }
 }
 
@@ -174,8 +288,12 @@ void handle_imuraw(struct ixcom_sbp_state *state) {
 void handle_wheeldata(struct ixcom_sbp_state *state) {
   assert(state);
 
+  /* keep the output in stream order */
+  ixcom_sbp_flush(state);
+
+  const u8 *frame = state->read_buffer + state->offset;
   XCOMmsg_WHEELDATA wheeldata;
-  if (ixcom_decode_wheeldata(state->read_buffer, &wheeldata) == IXCOM_RC_OK) {
+  if (ixcom_decode_wheeldata_unchecked(frame, &wheeldata) == IXCOM_RC_OK) {
     sbp_msg_t sbp_wheeldata;
 
     sbp_wheeldata.odometry.tow = wheeldata.header.gps_time_sec * 1000 +
@@ -203,7 +321,7 @@ void handle_wheeldata(struct ixcom_sbp_state *state) {
 
 void ixcom_handle_frame(struct ixcom_sbp_state *state) {
   assert(state);
-  u8 msg_type = state->read_buffer[1];
+  u8 msg_type = state->read_buffer[state->offset + 1];
 
   switch (msg_type) {
     case XCOM_MSGID_IMURAW:
@@ -218,7 +336,7 @@ void ixcom_handle_frame(struct ixcom_sbp_state *state) {
       break;
   }
 
-  state->index = 0;
+  restart_ixcom_frame(state, state->offset + state->frame_length);
 }
 
 /**
@@ -233,7 +351,8 @@ void ixcom_handle_frame(struct ixcom_sbp_state *state) {
  * is the buffer to write data into, `len` is the size of the buffer in bytes,
  * `context` is the context pointer from the `state` argument, the return value
  * is the number of bytes written into `buf` with negative values indicating an
- * error.
+ * error. The stream is read in chunks of up to IXCOM_BUFFER_SIZE bytes, bytes
+ * following the handled frame are kept in `state` for the next call.
  * @return the last value of read_stream_func, either 0 or a negative value
  * indicating an error.
  */
@@ -245,6 +364,8 @@ int ixcom_sbp_process(struct ixcom_sbp_state *state,
 
   ssize_t ret = read_ixcom_frame(state);
   if (ret <= 0) {
+    /* nothing more to add to a pending batch */
+    ixcom_sbp_flush(state);
     return ret;
   }
 
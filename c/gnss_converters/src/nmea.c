@@ -11,10 +11,10 @@
  */
 
 #include <assert.h>
+#include <gnss-converters/internal/nmea_format.h>
 #include <gnss-converters/internal/sbp_nmea_internal.h>
 #include <gnss-converters/nmea.h>
 #include <math.h>
-#include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
 #include <swiftnav/array_tools.h>
@@ -84,17 +84,23 @@ typedef enum talker_id_e {
  */
 #define NMEA_SENTENCE_START(max_len)              \
   char sentence_buf[(max_len) + NMEA_SUFFIX_LEN]; \
-  char *sentence_bufp = sentence_buf;             \
-  char *const sentence_buf_end = sentence_buf + (max_len);
-
-/** NMEA_SENTENCE_PRINTF: use like printf, can use multiple times
-    within a sentence. */
-#define NMEA_SENTENCE_PRINTF(...)                                            \
-  do {                                                                       \
-    sentence_bufp += snprintf(                                               \
-        sentence_bufp, sentence_buf_end - sentence_bufp, __VA_ARGS__);       \
-    if (sentence_bufp >= sentence_buf_end) sentence_bufp = sentence_buf_end; \
-  } while (0)
+  nmea_writer_t sentence = {sentence_buf, sentence_buf + (max_len), 0};
+
+/** NMEA_SENTENCE_STR, _CHAR, _UINT, _INT, _FIXED, _DEG_MIN: append a field
+ * to the sentence, can use multiple times within a sentence. The integer
+ * fields are zero padded to width, fixed decimal fields are printed like
+ * "%.*f" and NMEA_SENTENCE_DEG_MIN prints the absolute value of an angle as
+ * degrees and minutes. See nmea_format.h. */
+#define NMEA_SENTENCE_STR(str) nmea_format_str(&sentence, (str))
+#define NMEA_SENTENCE_CHAR(c) nmea_format_char(&sentence, (c))
+#define NMEA_SENTENCE_UINT(value, width) \
+  nmea_format_uint(&sentence, (value), (width))
+#define NMEA_SENTENCE_INT(value, width) \
+  nmea_format_int(&sentence, (value), (width))
+#define NMEA_SENTENCE_FIXED(value, decimals) \
+  nmea_format_fixed(&sentence, (value), 0, (decimals))
+#define NMEA_SENTENCE_DEG_MIN(degrees, deg_width) \
+  nmea_format_deg_min(&sentence, (degrees), (deg_width))
 
 /** NMEA_SENTENCE_DONE: append checksum and dispatch.
  * \note According to section 5.3.1 of the NMEA 0183 spec, sentences are
@@ -102,10 +108,10 @@ typedef enum talker_id_e {
  *       The call to nmea_output has been modified to remove the NULL.
  *       This will also affect all registered dispatchers
  */
-#define NMEA_SENTENCE_DONE(state)                             \
-  do {                                                        \
-    nmea_append_checksum(sentence_buf, sizeof(sentence_buf)); \
-    nmea_output(state, sentence_buf);                         \
+#define NMEA_SENTENCE_DONE(state)                                        \
+  do {                                                                   \
+    size_t sentence_len = nmea_append_checksum(&sentence, sentence_buf); \
+    nmea_output(state, sentence_buf, sentence_len);                      \
   } while (0)
 
 /* data element for GSV sentence */
@@ -122,70 +128,43 @@ typedef struct {
  *
  * \param state        sbp2nmea context.
  * \param sentence     The NMEA sentence to output.
+ * \param len          Length of the sentence.
  */
-static void nmea_output(const sbp2nmea_t *state, char *sentence) {
-  sbp2nmea_to_str(state, sentence);
+static void nmea_output(sbp2nmea_t *state, char *sentence, size_t len) {
+  sbp2nmea_to_buf(state, sentence, len);
 }
 
-/** Calculate and append the checksum of an NMEA sentence.
- * Calculates the bitwise XOR of the characters in a string until the end of
- * the string or a `*` is encountered. If the first character is `$` then it
- * is skipped.
+/** Append the checksum suffix "*XX\r\n" to an NMEA sentence.
+ * The checksum is the bitwise XOR of the characters of the sentence, it has
+ * been folded in by the writer while the fields were written. If the first
+ * character is `$` then it is excluded.
  *
- * \param s A null-terminated NMEA sentence, up to and optionally
- * including the '*'
+ * \param sentence Writer the sentence was assembled with, it must leave
+ * NMEA_SUFFIX_LEN bytes behind its end for the suffix.
  *
- * \param size Length of the buffer.
+ * \param s Start of the sentence.
  *
+ * \return Length of the sentence including the suffix.
  */
-static void nmea_append_checksum(char *s, size_t size) {
-  u8 sum = 0;
-  char *p = s;
+static size_t nmea_append_checksum(const nmea_writer_t *sentence, char *s) {
+  static const char hex[] = "0123456789ABCDEF";
+  u8 sum = sentence->checksum;
 
   /* '$' header not included in checksum calculation */
-  if (*p == '$') {
-    p++;
-  }
-
-  /* '*'  not included in checksum calculation */
-  while (*p != '*' && *p && p + NMEA_SUFFIX_LEN < s + size) {
-    sum ^= *p;
-    p++;
-  }
-
-  size_t remaining_size = size - (size_t)(p - s);
-  if (remaining_size > 0) {
-    snprintf(p, remaining_size, "*%02X\r\n", sum);
-  }  // truncates without check, will always null terminate
-}
-
-/** Wrapper function for vsnprintf to accommodate return value handling. Updates
- *  buf_ptr accordingly if there's no encoding error. If buffer is full, sets
- *  buf_ptr to buf_end.
- */
-SWIFT_ATTR_FORMAT(3, 4)
-static void vsnprintf_wrap(char **buf_ptr,
-                           char *buf_end,
-                           const char *format,
-                           ...) {
-  va_list args;
-  va_start(args, format);
-
-  /* see clang-tidy bug https://bugs.llvm.org/show_bug.cgi?id=41311 */
-  /* NOLINTNEXTLINE(clang-analyzer-valist.Uninitialized) */
-  int res = vsnprintf(*buf_ptr, buf_end - *buf_ptr, format, args);
-
-  va_end(args);
-
-  if (res < 0) {
-    return;
+  if (*s == '$') {
+    sum ^= (u8)'$';
   }
 
-  *buf_ptr += res;
+  /* a truncated sentence ends with the null termination in its last byte */
+  char *p = sentence->ptr < sentence->end ? sentence->ptr : sentence->end - 1;
+  p[0] = '*';
+  p[1] = hex[sum >> 4];
+  p[2] = hex[sum & 0xF];
+  p[3] = '\r';
+  p[4] = '\n';
+  p[5] = '\0';
 
-  if (*buf_ptr >= buf_end) {
-    *buf_ptr = buf_end;
-  }
+  return (size_t)(p + NMEA_SUFFIX_LEN - 1 - s);
 }
 
 /* Round the nanosecond part to NMEA_UTC_S_DECIMALS and roll the other fields
@@ -243,18 +222,18 @@ void get_utc_time_string(bool time,
                          const sbp_msg_utc_time_t *sbp_utc_time,
                          char *utc_str,
                          u8 size) {
-  char *buf_end = utc_str + size;
+  nmea_writer_t w = {utc_str, utc_str + size, 0};
 
   if (sbp_utc_time->flags == 0) {
     /* print empty fields */
     if (time) {
-      vsnprintf_wrap(&utc_str, buf_end, ",");
+      nmea_format_str(&w, ",");
     }
     if (date) {
       if (trunc_date) {
-        vsnprintf_wrap(&utc_str, buf_end, ",");
+        nmea_format_str(&w, ",");
       } else {
-        vsnprintf_wrap(&utc_str, buf_end, ",,,");
+        nmea_format_str(&w, ",,,");
       }
     }
     return;
@@ -264,33 +243,31 @@ void get_utc_time_string(bool time,
   round_utc_time(&rounded_utc_time);
 
   if (time) {
-    /* Time (UTC) */
-    vsnprintf_wrap(&utc_str,
-                   buf_end,
-                   "%02u%02u%02u.%0*" PRIu32 ",",
-                   rounded_utc_time.hours,
-                   rounded_utc_time.minutes,
-                   rounded_utc_time.seconds,
-                   NMEA_UTC_S_DECIMALS,
-                   rounded_utc_time.ns);
+    /* Time (UTC), "hhmmss.ss," */
+    nmea_format_uint(&w, rounded_utc_time.hours, 2);
+    nmea_format_uint(&w, rounded_utc_time.minutes, 2);
+    nmea_format_uint(&w, rounded_utc_time.seconds, 2);
+    nmea_format_char(&w, '.');
+    nmea_format_uint(&w, rounded_utc_time.ns, NMEA_UTC_S_DECIMALS);
+    nmea_format_char(&w, ',');
   }
 
   if (date) {
     /* Date Stamp */
     if (trunc_date) {
-      vsnprintf_wrap(&utc_str,
-                     buf_end,
-                     "%02u%02u%02u,",
-                     rounded_utc_time.day,
-                     rounded_utc_time.month,
-                     (u8)(rounded_utc_time.year % 100));
+      /* "ddmmyy," */
+      nmea_format_uint(&w, rounded_utc_time.day, 2);
+      nmea_format_uint(&w, rounded_utc_time.month, 2);
+      nmea_format_uint(&w, (u8)(rounded_utc_time.year % 100), 2);
+      nmea_format_char(&w, ',');
     } else {
-      vsnprintf_wrap(&utc_str,
-                     buf_end,
-                     "%02u,%02u,%" PRIu16 ",",
-                     rounded_utc_time.day,
-                     rounded_utc_time.month,
-                     rounded_utc_time.year);
+      /* "dd,mm,yyyy," */
+      nmea_format_uint(&w, rounded_utc_time.day, 2);
+      nmea_format_char(&w, ',');
+      nmea_format_uint(&w, rounded_utc_time.month, 2);
+      nmea_format_char(&w, ',');
+      nmea_format_uint(&w, rounded_utc_time.year, 0);
+      nmea_format_char(&w, ',');
     }
   }
 }
@@ -312,12 +289,12 @@ void get_utc_time_string(bool time,
  */
 void send_gpgga(sbp2nmea_t *state) {
   /* GGA sentence is formed by splitting latitude and longitude
-     into degrees and minutes parts and then printing them separately
-     using printf. Before doing the split we want to take care of
-     the proper rounding. Doing it after the split would lead to the need
+     into degrees and minutes parts and then printing them separately,
+     see nmea_format_deg_min(). Before doing the split we want to take care
+     of the proper rounding. Doing it after the split would lead to the need
      of handling the case of minutes part overflow separately. Otherwise,
-     printf would do the rounding of the minutes part, which could result
-     in printing 60 minutes value.
+     the rounding of the minutes part could result in printing 60 minutes
+     value.
      E.g. doing this way lat = 15.9999999996 would be printed as
      $GPGGA,hhmmss.ss,1600.000000,...
      and NOT
@@ -345,18 +322,8 @@ void send_gpgga(sbp2nmea_t *state) {
     age = sbp_soln_meta->age_corrections;
   }
 
-  double lat = fabs(round(sbp_pos_llh_cov->lat * 1e8) / 1e8);
-  double lon = fabs(round(sbp_pos_llh_cov->lon * 1e8) / 1e8);
-
   char lat_dir = sbp_pos_llh_cov->lat < 0.0 ? 'S' : 'N';
-  assert(lat <= UINT16_MAX);
-  u16 lat_deg = (u16)lat; /* truncation towards zero */
-  double lat_min = (lat - (double)lat_deg) * 60.0;
-
   char lon_dir = sbp_pos_llh_cov->lon < 0.0 ? 'W' : 'E';
-  assert(lon <= UINT16_MAX);
-  u16 lon_deg = (u16)lon; /* truncation towards zero */
-  double lon_min = (lon - (double)lon_deg) * 60.0;
 
   u8 fix_type = NMEA_GGA_QI_INVALID;
   if ((sbp_pos_llh_cov->flags & POSITION_MODE_MASK) != POSITION_MODE_NONE) {
@@ -364,51 +331,53 @@ void send_gpgga(sbp2nmea_t *state) {
   }
 
   NMEA_SENTENCE_START(120);
-  NMEA_SENTENCE_PRINTF("$GPGGA,");
+  NMEA_SENTENCE_STR("$GPGGA,");
 
   char utc[NMEA_TS_MAX_LEN];
   get_utc_time_string(true, false, false, sbp_utc_time, utc, NMEA_TS_MAX_LEN);
-  NMEA_SENTENCE_PRINTF("%s", utc);
+  NMEA_SENTENCE_STR(utc);
 
   if (fix_type != NMEA_GGA_QI_INVALID) {
-    NMEA_SENTENCE_PRINTF("%02u%010.7f,%c,%03u%010.7f,%c,",
-                         lat_deg,
-                         lat_min,
-                         lat_dir,
-                         lon_deg,
-                         lon_min,
-                         lon_dir);
+    NMEA_SENTENCE_DEG_MIN(sbp_pos_llh_cov->lat, 2);
+    NMEA_SENTENCE_CHAR(',');
+    NMEA_SENTENCE_CHAR(lat_dir);
+    NMEA_SENTENCE_CHAR(',');
+    NMEA_SENTENCE_DEG_MIN(sbp_pos_llh_cov->lon, 3);
+    NMEA_SENTENCE_CHAR(',');
+    NMEA_SENTENCE_CHAR(lon_dir);
+    NMEA_SENTENCE_CHAR(',');
   } else {
-    NMEA_SENTENCE_PRINTF(",,,,");
+    NMEA_SENTENCE_STR(",,,,");
   }
-  NMEA_SENTENCE_PRINTF("%01d,", fix_type);
+  NMEA_SENTENCE_UINT(fix_type, 1);
+  NMEA_SENTENCE_CHAR(',');
 
   float geoid_height =
       get_geoid_offset(sbp_pos_llh_cov->lat * D2R, sbp_pos_llh_cov->lon * D2R);
-  if (fix_type == NMEA_GGA_QI_EST) {
-    NMEA_SENTENCE_PRINTF("%02d,,%.2f,M,%.2f,M,",
-                         sbp_pos_llh_cov->n_sats,
-                         sbp_pos_llh_cov->height - (double)geoid_height,
-                         geoid_height);
-  } else if (fix_type != NMEA_GGA_QI_INVALID) {
-    NMEA_SENTENCE_PRINTF("%02d,%.1f,%.2f,M,%.2f,M,",
-                         sbp_pos_llh_cov->n_sats,
-                         round(10 * hdop * 0.01) / 10,
-                         sbp_pos_llh_cov->height - (double)geoid_height,
-                         geoid_height);
+  if (fix_type != NMEA_GGA_QI_INVALID) {
+    NMEA_SENTENCE_UINT(sbp_pos_llh_cov->n_sats, 2);
+    NMEA_SENTENCE_CHAR(',');
+    if (fix_type != NMEA_GGA_QI_EST) {
+      NMEA_SENTENCE_FIXED(round(10 * hdop * 0.01) / 10, 1);
+    }
+    NMEA_SENTENCE_CHAR(',');
+    NMEA_SENTENCE_FIXED(sbp_pos_llh_cov->height - (double)geoid_height, 2);
+    NMEA_SENTENCE_STR(",M,");
+    NMEA_SENTENCE_FIXED(geoid_height, 2);
+    NMEA_SENTENCE_STR(",M,");
   } else {
-    NMEA_SENTENCE_PRINTF(",,,M,,M,");
+    NMEA_SENTENCE_STR(",,,M,,M,");
   }
 
   if ((fix_type == NMEA_GGA_QI_DGPS &&
        ((sbp_pos_llh_cov->flags & POSITION_MODE_MASK) != POSITION_MODE_SBAS)) ||
       (fix_type == NMEA_GGA_QI_FLOAT) || (fix_type == NMEA_GGA_QI_RTK)) {
-    NMEA_SENTENCE_PRINTF(
-        "%.1f,%04d",
-        age * 0.1,
-        sbp2nmea_base_id_get(state) & 0x3FF); /* ID range is 0000 to 1023 */
+    NMEA_SENTENCE_FIXED(age * 0.1, 1);
+    NMEA_SENTENCE_CHAR(',');
+    /* ID range is 0000 to 1023 */
+    NMEA_SENTENCE_UINT(sbp2nmea_base_id_get(state) & 0x3FF, 4);
   } else {
-    NMEA_SENTENCE_PRINTF(",");
+    NMEA_SENTENCE_STR(",");
   }
 
   NMEA_SENTENCE_DONE(state);
@@ -507,7 +476,7 @@ void send_gsa_print(u16 *prns,
                     const u8 num_prns,
                     const sbp_msg_dops_t *sbp_dops,
                     const char *talker,
-                    const sbp2nmea_t *state) {
+                    sbp2nmea_t *state) {
   assert(prns);
   assert(sbp_dops);
 
@@ -518,25 +487,29 @@ void send_gsa_print(u16 *prns,
 
   NMEA_SENTENCE_START(120);
   /* Always automatic mode */
-  NMEA_SENTENCE_PRINTF("$%sGSA,A,%c,", talker, fix_mode);
+  NMEA_SENTENCE_CHAR('$');
+  NMEA_SENTENCE_STR(talker);
+  NMEA_SENTENCE_STR("GSA,A,");
+  NMEA_SENTENCE_CHAR(fix_mode);
+  NMEA_SENTENCE_CHAR(',');
 
   qsort(prns, num_prns, sizeof(u16), gsa_cmp);
 
   for (u8 i = 0; i < GSA_MAX_SV; i++) {
     if (i < num_prns) {
-      NMEA_SENTENCE_PRINTF("%02d,", prns[i]);
-    } else {
-      NMEA_SENTENCE_PRINTF(",");
+      NMEA_SENTENCE_UINT(prns[i], 2);
     }
+    NMEA_SENTENCE_CHAR(',');
   }
 
   if (fix && (NULL != sbp_dops)) {
-    NMEA_SENTENCE_PRINTF("%.1f,%.1f,%.1f",
-                         round(sbp_dops->pdop * 0.1) / 10,
-                         round(sbp_dops->hdop * 0.1) / 10,
-                         round(sbp_dops->vdop * 0.1) / 10);
+    NMEA_SENTENCE_FIXED(round(sbp_dops->pdop * 0.1) / 10, 1);
+    NMEA_SENTENCE_CHAR(',');
+    NMEA_SENTENCE_FIXED(round(sbp_dops->hdop * 0.1) / 10, 1);
+    NMEA_SENTENCE_CHAR(',');
+    NMEA_SENTENCE_FIXED(round(sbp_dops->vdop * 0.1) / 10, 1);
   } else {
-    NMEA_SENTENCE_PRINTF(",,");
+    NMEA_SENTENCE_STR(",,");
   }
 
   NMEA_SENTENCE_DONE(state);
@@ -696,19 +669,9 @@ void send_gprmc(sbp2nmea_t *state) {
   const sbp_msg_utc_time_t *sbp_utc_time =
       &sbp2nmea_msg_get(state, SBP2NMEA_SBP_UTC_TIME, true)->utc_time;
   /* See the relevant comment for the similar code in nmea_gpgga() function
-     for the reasoning behind (... * 1e8 / 1e8) trick */
-  double lat = fabs(round(sbp_pos_llh_cov->lat * 1e8) / 1e8);
-  double lon = fabs(round(sbp_pos_llh_cov->lon * 1e8) / 1e8);
-
+     for the reasoning behind rounding before the degrees/minutes split */
   char lat_dir = sbp_pos_llh_cov->lat < 0.0 ? 'S' : 'N';
-  assert(lat <= UINT16_MAX);
-  u16 lat_deg = (u16)lat; /* truncation towards zero */
-  double lat_min = (lat - (double)lat_deg) * 60.0;
-
   char lon_dir = sbp_pos_llh_cov->lon < 0.0 ? 'W' : 'E';
-  assert(lon <= UINT16_MAX);
-  u16 lon_deg = (u16)lon; /* truncation towards zero */
-  double lon_min = (lon - (double)lon_deg) * 60.0;
 
   char mode = get_nmea_mode_indicator(sbp_pos_llh_cov->flags);
   char status = get_nmea_status(sbp_pos_llh_cov->flags);
@@ -722,46 +685,46 @@ void send_gprmc(sbp2nmea_t *state) {
                &sog_kph);
 
   NMEA_SENTENCE_START(140);
-  NMEA_SENTENCE_PRINTF("$GPRMC,"); /* Command */
+  NMEA_SENTENCE_STR("$GPRMC,"); /* Command */
 
   char utc[NMEA_TS_MAX_LEN];
   get_utc_time_string(true, false, false, sbp_utc_time, utc, NMEA_TS_MAX_LEN);
-  NMEA_SENTENCE_PRINTF("%s", utc);
+  NMEA_SENTENCE_STR(utc);
 
-  NMEA_SENTENCE_PRINTF("%c,", /* Status */
-                       status);
+  NMEA_SENTENCE_CHAR(status); /* Status */
+  NMEA_SENTENCE_CHAR(',');
 
   if ((sbp_pos_llh_cov->flags & POSITION_MODE_MASK) != POSITION_MODE_NONE) {
-    NMEA_SENTENCE_PRINTF("%02u%010.7f,%c,%03u%010.7f,%c,", /* Lat/Lon */
-                         lat_deg,
-                         lat_min,
-                         lat_dir,
-                         lon_deg,
-                         lon_min,
-                         lon_dir);
+    /* Lat/Lon */
+    NMEA_SENTENCE_DEG_MIN(sbp_pos_llh_cov->lat, 2);
+    NMEA_SENTENCE_CHAR(',');
+    NMEA_SENTENCE_CHAR(lat_dir);
+    NMEA_SENTENCE_CHAR(',');
+    NMEA_SENTENCE_DEG_MIN(sbp_pos_llh_cov->lon, 3);
+    NMEA_SENTENCE_CHAR(',');
+    NMEA_SENTENCE_CHAR(lon_dir);
+    NMEA_SENTENCE_CHAR(',');
   } else {
-    NMEA_SENTENCE_PRINTF(",,,,"); /* Lat/Lon */
+    NMEA_SENTENCE_STR(",,,,"); /* Lat/Lon */
   }
 
   if ((sbp_vel_ned->flags & VELOCITY_MODE_MASK) != VELOCITY_MODE_NONE) {
-    NMEA_SENTENCE_PRINTF("%.2f,", sog_knots); /* Speed */
+    NMEA_SENTENCE_FIXED(sog_knots, 2); /* Speed */
+    NMEA_SENTENCE_CHAR(',');
     if ((MS2KNOTS_FACTOR * state->cog_threshold_mps) <= sog_knots) {
-      NMEA_SENTENCE_PRINTF("%.*f,", NMEA_COG_DECIMALS, cog); /* Course */
-    } else {
-      NMEA_SENTENCE_PRINTF(","); /* Course */
+      NMEA_SENTENCE_FIXED(cog, NMEA_COG_DECIMALS); /* Course */
     }
+    NMEA_SENTENCE_CHAR(',');
   } else {
-    NMEA_SENTENCE_PRINTF(",,"); /* Speed, Course */
+    NMEA_SENTENCE_STR(",,"); /* Speed, Course */
   }
 
   char date[NMEA_TS_MAX_LEN];
   get_utc_time_string(false, true, true, sbp_utc_time, date, NMEA_TS_MAX_LEN);
-  NMEA_SENTENCE_PRINTF("%s", date);
+  NMEA_SENTENCE_STR(date);
 
-  NMEA_SENTENCE_PRINTF(
-      ",,"  /* Magnetic Variation */
-      "%c", /* Mode Indicator */
-      mode);
+  NMEA_SENTENCE_STR(",,");  /* Magnetic Variation */
+  NMEA_SENTENCE_CHAR(mode); /* Mode Indicator */
   NMEA_SENTENCE_DONE(state);
 }
 
@@ -793,29 +756,31 @@ void send_gpvtg(sbp2nmea_t *state) {
   char mode = get_nmea_mode_indicator(sbp_pos_llh_cov->flags);
 
   NMEA_SENTENCE_START(120);
-  NMEA_SENTENCE_PRINTF("$GPVTG,"); /* Command */
+  NMEA_SENTENCE_STR("$GPVTG,"); /* Command */
 
   bool vel_valid =
       (sbp_vel_ned->flags & VELOCITY_MODE_MASK) != VELOCITY_MODE_NONE;
 
   if (vel_valid && (MS2KNOTS_FACTOR * state->cog_threshold_mps) <= sog_knots) {
-    NMEA_SENTENCE_PRINTF("%.*f,T,", NMEA_COG_DECIMALS, cog); /* Course */
-  } else {
-    NMEA_SENTENCE_PRINTF(",T,"); /* Course */
+    NMEA_SENTENCE_FIXED(cog, NMEA_COG_DECIMALS); /* Course */
   }
+  NMEA_SENTENCE_STR(",T,");
 
-  NMEA_SENTENCE_PRINTF(",M,"); /* Magnetic Course (omitted) */
+  NMEA_SENTENCE_STR(",M,"); /* Magnetic Course (omitted) */
 
   if (vel_valid) {
     /* Speed (knots, km/hr) */
-    NMEA_SENTENCE_PRINTF("%.2f,N,%.2f,K,", sog_knots, sog_kph);
+    NMEA_SENTENCE_FIXED(sog_knots, 2);
+    NMEA_SENTENCE_STR(",N,");
+    NMEA_SENTENCE_FIXED(sog_kph, 2);
+    NMEA_SENTENCE_STR(",K,");
   } else {
     /* Speed (knots, km/hr) */
-    NMEA_SENTENCE_PRINTF(",N,,K,");
+    NMEA_SENTENCE_STR(",N,,K,");
   }
 
   /* Mode (note this is position mode not velocity mode)*/
-  NMEA_SENTENCE_PRINTF("%c", mode);
+  NMEA_SENTENCE_CHAR(mode);
   NMEA_SENTENCE_DONE(state);
 }
 
@@ -829,16 +794,14 @@ void send_gphdt(sbp2nmea_t *state) {
   const sbp_msg_baseline_heading_t *sbp_baseline_heading =
       &sbp2nmea_msg_get(state, SBP2NMEA_SBP_HDG, false)->baseline_heading;
   NMEA_SENTENCE_START(40);
-  NMEA_SENTENCE_PRINTF("$GPHDT,"); /* Command */
+  NMEA_SENTENCE_STR("$GPHDT,"); /* Command */
   if ((POSITION_MODE_MASK & sbp_baseline_heading->flags) ==
       POSITION_MODE_FIXED) {
-    NMEA_SENTENCE_PRINTF(
-        "%.2f,T",
-        (float)sbp_baseline_heading->heading /
-            MSG_HEADING_SCALE_FACTOR); /* Heading only valid when fixed */
-  } else {
-    NMEA_SENTENCE_PRINTF(",T"); /* Heading only valid when fixed */
+    /* Heading only valid when fixed */
+    NMEA_SENTENCE_FIXED(
+        (float)sbp_baseline_heading->heading / MSG_HEADING_SCALE_FACTOR, 2);
   }
+  NMEA_SENTENCE_STR(",T");
   NMEA_SENTENCE_DONE(state);
 }
 
@@ -853,14 +816,14 @@ void send_gpths(sbp2nmea_t *state) {
   const sbp_msg_pos_llh_cov_t *sbp_pos_llh =
       &sbp2nmea_msg_get(state, SBP2NMEA_SBP_POS_LLH_COV, true)->pos_llh_cov;
   NMEA_SENTENCE_START(40);
-  NMEA_SENTENCE_PRINTF("$GPTHS,"); /* Command */
+  NMEA_SENTENCE_STR("$GPTHS,"); /* Command */
   uint8_t pos_mode = sbp_pos_llh->flags & POSITION_MODE_MASK;
   uint8_t orient_flags =
       SBP_ORIENT_EULER_INS_NAVIGATION_MODE_GET(sbp_orient_euler->flags);
 
   if (pos_mode == POSITION_MODE_NONE ||
       orient_flags == SBP_ORIENT_EULER_INS_NAVIGATION_MODE_INVALID) {
-    NMEA_SENTENCE_PRINTF(",V");  // No data
+    NMEA_SENTENCE_STR(",V");  // No data
   } else {
     // Normally yaw is not the same as heading but in our implementation it can
     // be taken as such
@@ -882,13 +845,14 @@ void send_gpths(sbp2nmea_t *state) {
     yaw /= 1e6f;
 
     // 360.00 is an invalid value in our output, it should wrap around to 0 but
-    // printf isn't going to do that for us
+    // the formatter isn't going to do that for us
     if (yaw >= 359.995) {
       yaw = 0;
     }
 
-    NMEA_SENTENCE_PRINTF(
-        "%.2f,%c", yaw, pos_mode == POSITION_MODE_DEAD_RECKONING ? 'E' : 'A');
+    NMEA_SENTENCE_FIXED(yaw, 2);
+    NMEA_SENTENCE_CHAR(',');
+    NMEA_SENTENCE_CHAR(pos_mode == POSITION_MODE_DEAD_RECKONING ? 'E' : 'A');
   }
   NMEA_SENTENCE_DONE(state);
 }
@@ -905,45 +869,37 @@ void send_gpgll(sbp2nmea_t *state) {
   const sbp_msg_utc_time_t *sbp_utc_time =
       &sbp2nmea_msg_get(state, SBP2NMEA_SBP_UTC_TIME, true)->utc_time;
   /* See the relevant comment for the similar code in nmea_gpgga() function
-     for the reasoning behind (... * 1e8 / 1e8) trick */
-  double lat = fabs(round(sbp_pos_llh_cov->lat * 1e8) / 1e8);
-  double lon = fabs(round(sbp_pos_llh_cov->lon * 1e8) / 1e8);
-
+     for the reasoning behind rounding before the degrees/minutes split */
   char lat_dir = sbp_pos_llh_cov->lat < 0.0 ? 'S' : 'N';
-  assert(lat <= UINT16_MAX);
-  u16 lat_deg = (u16)lat; /* truncation towards zero */
-  double lat_min = (lat - (double)lat_deg) * 60.0;
-
   char lon_dir = sbp_pos_llh_cov->lon < 0.0 ? 'W' : 'E';
-  assert(lon <= UINT16_MAX);
-  u16 lon_deg = (u16)lon; /* truncation towards zero */
-  double lon_min = (lon - (double)lon_deg) * 60.0;
 
   char status = get_nmea_status(sbp_pos_llh_cov->flags);
   char mode = get_nmea_mode_indicator(sbp_pos_llh_cov->flags);
 
   NMEA_SENTENCE_START(120);
-  NMEA_SENTENCE_PRINTF("$GPGLL,"); /* Command */
+  NMEA_SENTENCE_STR("$GPGLL,"); /* Command */
 
   if ((sbp_pos_llh_cov->flags & POSITION_MODE_MASK) != POSITION_MODE_NONE) {
-    NMEA_SENTENCE_PRINTF("%02u%010.7f,%c,%03u%010.7f,%c,", /* Lat/Lon */
-                         lat_deg,
-                         lat_min,
-                         lat_dir,
-                         lon_deg,
-                         lon_min,
-                         lon_dir);
+    /* Lat/Lon */
+    NMEA_SENTENCE_DEG_MIN(sbp_pos_llh_cov->lat, 2);
+    NMEA_SENTENCE_CHAR(',');
+    NMEA_SENTENCE_CHAR(lat_dir);
+    NMEA_SENTENCE_CHAR(',');
+    NMEA_SENTENCE_DEG_MIN(sbp_pos_llh_cov->lon, 3);
+    NMEA_SENTENCE_CHAR(',');
+    NMEA_SENTENCE_CHAR(lon_dir);
+    NMEA_SENTENCE_CHAR(',');
   } else {
-    NMEA_SENTENCE_PRINTF(",,,,"); /* Lat/Lon */
+    NMEA_SENTENCE_STR(",,,,"); /* Lat/Lon */
   }
 
   char utc[NMEA_TS_MAX_LEN];
   get_utc_time_string(true, false, false, sbp_utc_time, utc, NMEA_TS_MAX_LEN);
-  NMEA_SENTENCE_PRINTF("%s", utc);
+  NMEA_SENTENCE_STR(utc);
 
-  NMEA_SENTENCE_PRINTF("%c,%c", /* Status, Mode */
-                       status,
-                       mode);
+  NMEA_SENTENCE_CHAR(status); /* Status, Mode */
+  NMEA_SENTENCE_CHAR(',');
+  NMEA_SENTENCE_CHAR(mode);
   NMEA_SENTENCE_DONE(state);
 }
 
@@ -958,13 +914,13 @@ void send_gpzda(sbp2nmea_t *state) {
       &sbp2nmea_msg_get(state, SBP2NMEA_SBP_UTC_TIME, true)->utc_time;
 
   NMEA_SENTENCE_START(40);
-  NMEA_SENTENCE_PRINTF("$GPZDA,"); /* Command */
+  NMEA_SENTENCE_STR("$GPZDA,"); /* Command */
 
   char utc[NMEA_TS_MAX_LEN];
   get_utc_time_string(true, true, false, sbp_utc_time, utc, NMEA_TS_MAX_LEN);
-  NMEA_SENTENCE_PRINTF("%s", utc);
+  NMEA_SENTENCE_STR(utc);
 
-  NMEA_SENTENCE_PRINTF(","); /* Time zone */
+  NMEA_SENTENCE_STR(","); /* Time zone */
   NMEA_SENTENCE_DONE(state);
 
 } /* send_gpzda() */
@@ -1016,24 +972,30 @@ void send_gpgst(sbp2nmea_t *state) {
   /* Check if no SVs identified */
   if (0 == constellations || fix_type == NMEA_GGA_QI_INVALID) {
     /* At bare minimum, print empty GPGST and be done with it */
-    NMEA_SENTENCE_PRINTF("$GPGST,%s,,,,,,", utc);
+    NMEA_SENTENCE_STR("$GPGST,");
+    NMEA_SENTENCE_STR(utc);
+    NMEA_SENTENCE_STR(",,,,,,");
     NMEA_SENTENCE_DONE(state);
     return;
   }
   if (constellations > 1) {
     /* At bare minimum, print empty GNGST and be done with it */
-    NMEA_SENTENCE_PRINTF("$GNGST,%s", utc);
+    NMEA_SENTENCE_STR("$GNGST,");
+    NMEA_SENTENCE_STR(utc);
   } else {
     for (u8 i = 0; i < TALKER_ID_COUNT; ++i) {
       if (talkers[i] == 1) {
-        NMEA_SENTENCE_PRINTF("$%sGST,%s", talker_id_to_str(i), utc);
+        NMEA_SENTENCE_CHAR('$');
+        NMEA_SENTENCE_STR(talker_id_to_str(i));
+        NMEA_SENTENCE_STR("GST,");
+        NMEA_SENTENCE_STR(utc);
         break;
       }
     }
   }
   /* Currently we have no way of calculating the RMS of the observation
    * residuals at this point so we leave it blank */
-  NMEA_SENTENCE_PRINTF(",");
+  NMEA_SENTENCE_STR(",");
 
   /* Compute the eigenvalues to get the semi-major and semi-minor axis of error
    * ellipse */
@@ -1061,13 +1023,17 @@ void send_gpgst(sbp2nmea_t *state) {
     orientation = 90.0;
   }
 
-  NMEA_SENTENCE_PRINTF("%f,%f,%.1f,%f,%f,%f",
-                       semi_major,
-                       semi_minor,
-                       orientation,
-                       std_n,
-                       std_e,
-                       std_d);
+  NMEA_SENTENCE_FIXED(semi_major, 6);
+  NMEA_SENTENCE_CHAR(',');
+  NMEA_SENTENCE_FIXED(semi_minor, 6);
+  NMEA_SENTENCE_CHAR(',');
+  NMEA_SENTENCE_FIXED(orientation, 1);
+  NMEA_SENTENCE_CHAR(',');
+  NMEA_SENTENCE_FIXED(std_n, 6);
+  NMEA_SENTENCE_CHAR(',');
+  NMEA_SENTENCE_FIXED(std_e, 6);
+  NMEA_SENTENCE_CHAR(',');
+  NMEA_SENTENCE_FIXED(std_d, 6);
 
   NMEA_SENTENCE_DONE(state);
 
@@ -1083,7 +1049,7 @@ void send_gpgst(sbp2nmea_t *state) {
 static void nmea_gsv_print(const u8 n_used,
                            const nmea_gsv_element_t data[],
                            const talker_id_t talker,
-                           const sbp2nmea_t *state) {
+                           sbp2nmea_t *state) {
   const char *talker_str = talker_id_to_str(talker);
 
   u8 n_messages = (n_used + 3) / 4;
@@ -1092,25 +1058,34 @@ static void nmea_gsv_print(const u8 n_used,
 
   for (u8 i = 0; i < n_messages; i++) {
     NMEA_SENTENCE_START(120);
-    NMEA_SENTENCE_PRINTF(
-        "$%sGSV,%u,%u,%02u", talker_str, n_messages, i + 1, n_used);
+    NMEA_SENTENCE_CHAR('$');
+    NMEA_SENTENCE_STR(talker_str);
+    NMEA_SENTENCE_STR("GSV,");
+    NMEA_SENTENCE_UINT(n_messages, 1);
+    NMEA_SENTENCE_CHAR(',');
+    NMEA_SENTENCE_UINT(i + 1, 1);
+    NMEA_SENTENCE_CHAR(',');
+    NMEA_SENTENCE_UINT(n_used, 2);
 
     for (u8 j = 0; j < 4 && n < n_used; n++) {
       u16 sv_id = nmea_get_id(data[n].sid);
 
-      NMEA_SENTENCE_PRINTF(",%02u", sv_id);
+      NMEA_SENTENCE_CHAR(',');
+      NMEA_SENTENCE_UINT(sv_id, 2);
 
+      NMEA_SENTENCE_CHAR(',');
       // NOLINTNEXTLINE
       if (data[n].has_azel) {
-        NMEA_SENTENCE_PRINTF(",%02d,%03u", data[n].el, data[n].az);
+        NMEA_SENTENCE_INT(data[n].el, 2);
+        NMEA_SENTENCE_CHAR(',');
+        NMEA_SENTENCE_UINT(data[n].az, 3);
       } else {
-        NMEA_SENTENCE_PRINTF(",,");
+        NMEA_SENTENCE_CHAR(',');
       }
 
+      NMEA_SENTENCE_CHAR(',');
       if (data[n].has_snr) {
-        NMEA_SENTENCE_PRINTF(",%02u", data[n].snr);
-      } else {
-        NMEA_SENTENCE_PRINTF(",");
+        NMEA_SENTENCE_UINT(data[n].snr, 2);
       }
 
       j++; /* 4 sats per message no matter what */
@@ -1194,7 +1169,7 @@ void send_gsv(sbp2nmea_t *state) {
   if (0 == talkers) {
     /* Print bare minimum */
     NMEA_SENTENCE_START(120);
-    NMEA_SENTENCE_PRINTF("$GPGSV,1,1,0");
+    NMEA_SENTENCE_STR("$GPGSV,1,1,0");
     NMEA_SENTENCE_DONE(state);
   }
 }
@@ -1233,18 +1208,8 @@ void send_pubx(sbp2nmea_t *state) {
   const sbp_msg_soln_meta_t *soln_meta =
       &sbp2nmea_msg_get(state, SBP2NMEA_SBP_SOLN_META, false)->soln_meta;
 
-  double lat = fabs(round(sbp_pos_llh_cov->lat * 1e8) / 1e8);
-  double lon = fabs(round(sbp_pos_llh_cov->lon * 1e8) / 1e8);
-
   char lat_dir = sbp_pos_llh_cov->lat < 0.0 ? 'S' : 'N';
-  assert(lat <= UINT16_MAX);
-  u16 lat_deg = (u16)lat; /* truncation towards zero */
-  double lat_min = (lat - (double)lat_deg) * 60.0;
-
   char lon_dir = sbp_pos_llh_cov->lon < 0.0 ? 'W' : 'E';
-  assert(lon <= UINT16_MAX);
-  u16 lon_deg = (u16)lon; /* truncation towards zero */
-  double lon_min = (lon - (double)lon_deg) * 60.0;
 
   u8 fix_type = NMEA_GGA_QI_INVALID;
   if ((sbp_pos_llh_cov->flags & POSITION_MODE_MASK) != POSITION_MODE_NONE) {
@@ -1252,38 +1217,44 @@ void send_pubx(sbp2nmea_t *state) {
   }
 
   NMEA_SENTENCE_START(120);
-  NMEA_SENTENCE_PRINTF("$PUBX,00,");
+  NMEA_SENTENCE_STR("$PUBX,00,");
 
   // UTC
   char utc[NMEA_TS_MAX_LEN];
   get_utc_time_string(true, false, false, sbp_utc_time, utc, NMEA_TS_MAX_LEN);
-  NMEA_SENTENCE_PRINTF("%s", utc);
+  NMEA_SENTENCE_STR(utc);
 
   // Lat, Lon, AltRef
   if (fix_type != NMEA_GGA_QI_INVALID) {
-    NMEA_SENTENCE_PRINTF("%02u%010.7f,%c,%03u%010.7f,%c,%.2f,",
-                         lat_deg,
-                         lat_min,
-                         lat_dir,
-                         lon_deg,
-                         lon_min,
-                         lon_dir,
-                         sbp_pos_llh_cov->height);
+    NMEA_SENTENCE_DEG_MIN(sbp_pos_llh_cov->lat, 2);
+    NMEA_SENTENCE_CHAR(',');
+    NMEA_SENTENCE_CHAR(lat_dir);
+    NMEA_SENTENCE_CHAR(',');
+    NMEA_SENTENCE_DEG_MIN(sbp_pos_llh_cov->lon, 3);
+    NMEA_SENTENCE_CHAR(',');
+    NMEA_SENTENCE_CHAR(lon_dir);
+    NMEA_SENTENCE_CHAR(',');
+    NMEA_SENTENCE_FIXED(sbp_pos_llh_cov->height, 2);
+    NMEA_SENTENCE_CHAR(',');
   } else {
-    NMEA_SENTENCE_PRINTF(",,,,,");
+    NMEA_SENTENCE_STR(",,,,,");
   }
 
   // NavStat
   const char *nav_stat = get_pubx_nav_stat(sbp_pos_llh_cov->flags);
-  NMEA_SENTENCE_PRINTF("%s,", nav_stat);
+  NMEA_SENTENCE_STR(nav_stat);
+  NMEA_SENTENCE_CHAR(',');
 
   // Hacc, Vacc
   if (fix_type != NMEA_GGA_QI_INVALID) {
     float hacc = sqrtf(sbp_pos_llh_cov->cov_n_n + sbp_pos_llh_cov->cov_e_e);
     float vacc = sqrtf(sbp_pos_llh_cov->cov_d_d);
-    NMEA_SENTENCE_PRINTF("%.1f,%.1f,", hacc, vacc);
+    NMEA_SENTENCE_FIXED(hacc, 1);
+    NMEA_SENTENCE_CHAR(',');
+    NMEA_SENTENCE_FIXED(vacc, 1);
+    NMEA_SENTENCE_CHAR(',');
   } else {
-    NMEA_SENTENCE_PRINTF(",,");
+    NMEA_SENTENCE_STR(",,");
   }
 
   // SOG COG Vvel
@@ -1296,15 +1267,16 @@ void send_pubx(sbp2nmea_t *state) {
                &sog_kph);
 
   if ((sbp_vel_ned->flags & VELOCITY_MODE_MASK) != VELOCITY_MODE_NONE) {
-    NMEA_SENTENCE_PRINTF("%.2f,", sog_kph); /* Speed */
+    NMEA_SENTENCE_FIXED(sog_kph, 2); /* Speed */
+    NMEA_SENTENCE_CHAR(',');
     if ((MS2KNOTS_FACTOR * state->cog_threshold_mps) < sog_knots) {
-      NMEA_SENTENCE_PRINTF("%.*f,", NMEA_COG_DECIMALS, cog); /* Course */
-    } else {
-      NMEA_SENTENCE_PRINTF(","); /* Course */
+      NMEA_SENTENCE_FIXED(cog, NMEA_COG_DECIMALS); /* Course */
     }
-    NMEA_SENTENCE_PRINTF("%.2f,", ((float)sbp_vel_ned->d) / 1000.0);
+    NMEA_SENTENCE_CHAR(',');
+    NMEA_SENTENCE_FIXED(((float)sbp_vel_ned->d) / 1000.0, 2);
+    NMEA_SENTENCE_CHAR(',');
   } else {
-    NMEA_SENTENCE_PRINTF(",,,"); /* Speed, Course, Vvel */
+    NMEA_SENTENCE_STR(",,,"); /* Speed, Course, Vvel */
   }
 
   // Age corrections
@@ -1312,39 +1284,39 @@ void send_pubx(sbp2nmea_t *state) {
        ((sbp_pos_llh_cov->flags & POSITION_MODE_MASK) != POSITION_MODE_SBAS)) ||
       (fix_type == NMEA_GGA_QI_FLOAT) || (fix_type == NMEA_GGA_QI_RTK)) {
     if (state->actual_mode == SBP2NMEA_MODE_GNSS) {
-      NMEA_SENTENCE_PRINTF("%.1f,",
-                           sbp_age->age * 0.1); /* ID range is 0000 to 1023 */
+      NMEA_SENTENCE_FIXED(sbp_age->age * 0.1, 1);
     } else {
-      NMEA_SENTENCE_PRINTF(
-          "%.1f,",
-          soln_meta->age_corrections * 0.1); /* ID range is 0000 to 1023 */
+      NMEA_SENTENCE_FIXED(soln_meta->age_corrections * 0.1, 1);
     }
-  } else {
-    NMEA_SENTENCE_PRINTF(",");
   }
+  NMEA_SENTENCE_CHAR(',');
 
   // HDOP, VDOP, TDOP
   if (fix_type == NMEA_GGA_QI_EST || fix_type == NMEA_GGA_QI_INVALID) {
-    NMEA_SENTENCE_PRINTF(",,,");
+    NMEA_SENTENCE_STR(",,,");
   } else {
     if (state->actual_mode == SBP2NMEA_MODE_GNSS) {
-      NMEA_SENTENCE_PRINTF("%.1f,%.1f,%.1f,",
-                           round(10 * sbp_dops->hdop * 0.01) / 10,
-                           round(10 * sbp_dops->vdop * 0.01) / 10,
-                           round(10 * sbp_dops->tdop * 0.01) / 10);
+      NMEA_SENTENCE_FIXED(round(10 * sbp_dops->hdop * 0.01) / 10, 1);
+      NMEA_SENTENCE_CHAR(',');
+      NMEA_SENTENCE_FIXED(round(10 * sbp_dops->vdop * 0.01) / 10, 1);
+      NMEA_SENTENCE_CHAR(',');
+      NMEA_SENTENCE_FIXED(round(10 * sbp_dops->tdop * 0.01) / 10, 1);
+      NMEA_SENTENCE_CHAR(',');
     } else {
-      NMEA_SENTENCE_PRINTF("%.1f,%.1f,,",
-                           round(10 * soln_meta->hdop * 0.01) / 10,
-                           round(10 * soln_meta->vdop * 0.01) / 10);
+      NMEA_SENTENCE_FIXED(round(10 * soln_meta->hdop * 0.01) / 10, 1);
+      NMEA_SENTENCE_CHAR(',');
+      NMEA_SENTENCE_FIXED(round(10 * soln_meta->vdop * 0.01) / 10, 1);
+      NMEA_SENTENCE_STR(",,");
     }
   }
 
   // GPS, GLONASS sats used, everything is chucked in to the GPS field for the
   // moment
-  NMEA_SENTENCE_PRINTF("%d,0,", sbp_pos_llh_cov->n_sats);
+  NMEA_SENTENCE_UINT(sbp_pos_llh_cov->n_sats, 1);
+  NMEA_SENTENCE_STR(",0,");
 
   // DR used
-  NMEA_SENTENCE_PRINTF("%d", fix_type == NMEA_GGA_QI_EST);
+  NMEA_SENTENCE_UINT(fix_type == NMEA_GGA_QI_EST, 1);
 
   NMEA_SENTENCE_DONE(state);
 }
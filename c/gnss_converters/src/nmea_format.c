@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2026 Swift Navigation Inc.
+ * Contact: Swift Navigation <dev@swiftnav.com>
+ *
+ * This source is subject to the license found in the file 'LICENSE' which must
+ * be be distributed together with this source. All other rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <assert.h>
+#include <float.h>
+#include <gnss-converters/internal/nmea_format.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Enough room for any field, the widest is a fixed decimal number of up to
+ * NMEA_FORMAT_FIXED_LIMIT, i.e. sign, 16 digits and the decimal point */
+#define NMEA_FORMAT_FIELD_LEN 32
+
+/* Scaled values from here on are handed over to snprintf, well below 2^52 so
+ * that the fraction of a scaled value is computed exactly */
+#define NMEA_FORMAT_FIXED_LIMIT 1e15
+
+/* Values which go through snprintf are formatted here first, this fits any
+ * finite double with NMEA_FORMAT_MAX_DECIMALS */
+#define NMEA_FORMAT_FALLBACK_LEN (DBL_MAX_10_EXP + NMEA_FORMAT_MAX_DECIMALS + 8)
+
+/* Angles are rounded to 1e-8 degrees and printed with 7 decimal minutes */
+#define NMEA_FORMAT_DEG_UNITS 100000000
+#define NMEA_FORMAT_MIN_UNITS 10000000
+#define NMEA_FORMAT_MIN_DECIMALS 7
+#define NMEA_FORMAT_MIN_WIDTH 10
+
+static const double pow10_table[NMEA_FORMAT_MAX_DECIMALS + 1] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+
+/** Appends n bytes with the truncation semantics of snprintf. */
+static void nmea_format_append(nmea_writer_t *w, const char *s, size_t n) {
+  if (w->ptr >= w->end) {
+    return;
+  }
+
+  size_t available = (size_t)(w->end - w->ptr) - 1;
+  size_t copy = n < available ? n : available;
+  for (size_t i = 0; i < copy; i++) {
+    w->ptr[i] = s[i];
+    w->checksum ^= (uint8_t)s[i];
+  }
+  w->ptr[copy] = '\0';
+
+  w->ptr = n < (size_t)(w->end - w->ptr) ? w->ptr + n : w->end;
+}
+
+/** Writes the decimal digits of value right aligned in front of field_end,
+ *  zero padded to at least min_digits.
+ *
+ * \return pointer to the first digit
+ */
+static char *nmea_format_digits(char *field_end,
+                                uint64_t value,
+                                uint8_t min_digits) {
+  char *p = field_end;
+  do {
+    *--p = (char)('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+
+  while (field_end - p < min_digits) {
+    *--p = '0';
+  }
+  return p;
+}
+
+/** Emits an optional sign and the digits in field, zero padding in between
+ *  so that the field is at least width characters wide. */
+static void nmea_format_padded(nmea_writer_t *w,
+                               bool negative,
+                               char *digits,
+                               char *field_end,
+                               uint8_t width) {
+  size_t length = (size_t)(field_end - digits) + (negative ? 1 : 0);
+  while (length < width) {
+    *--digits = '0';
+    length++;
+  }
+  if (negative) {
+    *--digits = '-';
+  }
+  nmea_format_append(w, digits, (size_t)(field_end - digits));
+}
+
+void nmea_format_str(nmea_writer_t *w, const char *str) {
+  nmea_format_append(w, str, strlen(str));
+}
+
+void nmea_format_char(nmea_writer_t *w, char c) {
+  nmea_format_append(w, &c, 1);
+}
+
+void nmea_format_uint(nmea_writer_t *w, uint32_t value, uint8_t width) {
+  char field[NMEA_FORMAT_FIELD_LEN];
+  char *field_end = field + sizeof(field);
+  char *digits = nmea_format_digits(field_end, value, 1);
+  nmea_format_padded(w, false, digits, field_end, width);
+}
+
+void nmea_format_int(nmea_writer_t *w, int32_t value, uint8_t width) {
+  char field[NMEA_FORMAT_FIELD_LEN];
+  char *field_end = field + sizeof(field);
+  bool negative = value < 0;
+  uint32_t magnitude = negative ? 0u - (uint32_t)value : (uint32_t)value;
+  char *digits = nmea_format_digits(field_end, magnitude, 1);
+  nmea_format_padded(w, negative, digits, field_end, width);
+}
+
+void nmea_format_fixed(nmea_writer_t *w,
+                       double value,
+                       uint8_t width,
+                       uint8_t decimals) {
+  assert(decimals <= NMEA_FORMAT_MAX_DECIMALS);
+  assert(width < NMEA_FORMAT_FIELD_LEN);
+
+  double scaled = fabs(value) * pow10_table[decimals];
+  double whole = floor(scaled);
+  double frac = scaled - whole;
+
+  /* The scaling is off by at most half an ulp, so it can only move a value
+   * across the rounding boundary if it lies right next to a tie. Those, as
+   * well as NaN, infinities and large values go through snprintf. */
+  if (!(scaled < NMEA_FORMAT_FIXED_LIMIT) ||
+      fabs(frac - 0.5) <= scaled * DBL_EPSILON) {
+    char field[NMEA_FORMAT_FALLBACK_LEN];
+    int res = snprintf(field, sizeof(field), "%0*.*f", width, decimals, value);
+    if (res > 0) {
+      nmea_format_append(w, field, (size_t)res);
+    }
+    return;
+  }
+
+  uint64_t units = (uint64_t)whole + (frac > 0.5 ? 1 : 0);
+
+  char field[NMEA_FORMAT_FIELD_LEN];
+  char *field_end = field + sizeof(field);
+  char *digits = field_end;
+  if (decimals > 0) {
+    uint64_t divisor = (uint64_t)pow10_table[decimals];
+    digits = nmea_format_digits(field_end, units % divisor, decimals);
+    *--digits = '.';
+    units /= divisor;
+  }
+  digits = nmea_format_digits(digits, units, 1);
+  nmea_format_padded(w, signbit(value) != 0, digits, field_end, width);
+}
+
+void nmea_format_deg_min(nmea_writer_t *w, double degrees, uint8_t deg_width) {
+  double rounded = round(fabs(degrees) * NMEA_FORMAT_DEG_UNITS);
+  assert(rounded <= UINT16_MAX * (double)NMEA_FORMAT_DEG_UNITS);
+
+  uint64_t units = (uint64_t)rounded;
+  /* 1e-8 degrees are exactly 6e-7 minutes */
+  uint64_t minutes = (units % NMEA_FORMAT_DEG_UNITS) * 6;
+
+  char field[NMEA_FORMAT_FIELD_LEN];
+  char *field_end = field + sizeof(field);
+  char *digits = nmea_format_digits(
+      field_end, minutes % NMEA_FORMAT_MIN_UNITS, NMEA_FORMAT_MIN_DECIMALS);
+  *--digits = '.';
+  digits = nmea_format_digits(digits,
+                              minutes / NMEA_FORMAT_MIN_UNITS,
+                              NMEA_FORMAT_MIN_WIDTH - 1 -
+                                  NMEA_FORMAT_MIN_DECIMALS);
+  digits = nmea_format_digits(
+      digits, units / NMEA_FORMAT_DEG_UNITS, deg_width > 0 ? deg_width : 1);
+  nmea_format_append(w, digits, (size_t)(field_end - digits));
+}
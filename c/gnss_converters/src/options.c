@@ -18,11 +18,52 @@
 #include <swiftnav/signal.h>
 
 float sbp_signal_biases[CODE_COUNT] = {0.0f};
-float sbp_glo_code_bias[2] = {0.0f};
-float sbp_glo_phase_bias[2] = {0.0f};
+float sbp_glo_code_bias[SBP_GLO_FCN_BIAS_BANDS] = {0.0f};
+float sbp_glo_phase_bias[SBP_GLO_FCN_BIAS_BANDS] = {0.0f};
 bool constellation_mask[CONSTELLATION_COUNT] = {false};
 verbosity_level_t verbosity_level = {VERB_NORMAL};
 
+/** Find the FCN bias band of a GLO code
+ *
+ * \param code Signal code
+ * \return 0 for L1, 1 for L2 or -1 if no FCN bias applies to the code
+ */
+int glo_fcn_bias_band(const code_t code) {
+  switch ((int8_t)code) {
+    case CODE_GLO_L1OF:
+    case CODE_GLO_L1P:
+      return 0;
+    case CODE_GLO_L2OF:
+    case CODE_GLO_L2P:
+      return 1;
+    default:
+      return -1;
+  }
+}
+
+/** Compute the FCN dependent code and carrier phase biases of a band
+ *
+ * \param band 0 for L1, 1 for L2
+ * \param glo_fcn The FCN value for GLO satellites
+ * \param p_code Pointer to write the code offset to
+ * \param p_phase Pointer to write the carrier phase offset to
+ */
+void glo_fcn_band_bias(const u8 band,
+                       const u8 glo_fcn,
+                       double *p_code,
+                       double *p_phase) {
+  assert(band < SBP_GLO_FCN_BIAS_BANDS);
+  assert(p_code);
+  assert(p_phase);
+
+  (*p_code) = 0.0;
+  (*p_phase) = 0.0;
+  if (MSM_GLO_FCN_UNKNOWN != glo_fcn) {
+    (*p_code) = (glo_fcn - MSM_GLO_FCN_OFFSET) * sbp_glo_code_bias[band];
+    (*p_phase) = (glo_fcn - MSM_GLO_FCN_OFFSET) * sbp_glo_phase_bias[band];
+  }
+}
+
 /** Find the frequency of an MSM signal
  *
  * \param header Pointer to message header
@@ -44,24 +85,8 @@ void msm_glo_fcn_bias(const rtcm_msm_header *header,
 
   (*p_code) = 0.0;
   (*p_phase) = 0.0;
-  code_t code = msm_signal_to_code(header, signal_index);
-
-  switch ((int8_t)code) {
-    case CODE_GLO_L1OF:
-    case CODE_GLO_L1P:
-      if (MSM_GLO_FCN_UNKNOWN != glo_fcn) {
-        (*p_code) = (glo_fcn - MSM_GLO_FCN_OFFSET) * sbp_glo_code_bias[0];
-        (*p_phase) = (glo_fcn - MSM_GLO_FCN_OFFSET) * sbp_glo_phase_bias[0];
-      }
-      break;
-    case CODE_GLO_L2OF:
-    case CODE_GLO_L2P:
-      if (MSM_GLO_FCN_UNKNOWN != glo_fcn) {
-        (*p_code) = (glo_fcn - MSM_GLO_FCN_OFFSET) * sbp_glo_code_bias[1];
-        (*p_phase) = (glo_fcn - MSM_GLO_FCN_OFFSET) * sbp_glo_phase_bias[1];
-      }
-      break;
-    default:
-      break;
+  int band = glo_fcn_bias_band(msm_signal_to_code(header, signal_index));
+  if (band >= 0) {
+    glo_fcn_band_bias((u8)band, glo_fcn, p_code, p_phase);
   }
 }
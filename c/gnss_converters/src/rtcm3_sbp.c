@@ -88,7 +88,7 @@ static void handle_rtcm3_999_subframe(const rtcm_msg_999 *msg_999,
 static void validate_base_obs_sanity(struct rtcm3_sbp_state *state,
                                      const gps_time_t *obs_time,
                                      const gps_time_t *rover_time);
-static bool verify_crc(uint8_t *buf, uint16_t buf_len);
+static bool verify_crc(const uint8_t *buf, uint16_t buf_len);
 
 /* Returns status of sending multiple RTCM observation msg */
 static bool rtcm2sbp_get_multiple_obs_status(const uint8_t *payload,
@@ -104,11 +104,29 @@ static void update_cons_meas_map(constellation_t sbp_cons,
 
 /** This function is used to reset the map after the measurement data is sent
  * out, to prevent the use of outdated satellite code after long period.
- * It is looped through all the constellations and sid. Instead of resetting all
- * the elements to "default" values, this function just resets n_signals to 0,
- * saving computation cost. */
+ * Rather than touching every satellite entry, it bumps the map generation so
+ * that all entries written under an older generation are treated as empty. */
 static void reset_cons_meas_map(struct rtcm3_sbp_state *state);
 
+/** Returns the map entry of a satellite if it was populated since the last
+ * reset, NULL otherwise. */
+static const struct rtcm_meas_sat_signal *get_cons_meas_sat(
+    const struct rtcm3_sbp_state *state,
+    rtcm_constellation_t rtcm_cons,
+    uint8_t rtcm_sid);
+
+/** Invalidates every entry of the per satellite GLO FCN cache, called whenever
+ * the inputs the FCN is resolved from may have changed. */
+static void invalidate_glo_sat_cache(struct rtcm3_sbp_state *state);
+
+/** Returns the FCN and FCN biases of a GLO MSM satellite, resolving them only
+ * if the cached entry is stale. NULL if the satellite has no valid PRN. */
+static const struct rtcm_glo_sat_cache *get_glo_sat_cache(
+    const rtcm_msm_header *header,
+    u8 sat_index,
+    u8 fcn_from_sat_info,
+    struct rtcm3_sbp_state *state);
+
 /**
  * @brief This function decodes a SBP message wrapped in a Swift Proprietary
  * message.
@@ -182,6 +200,12 @@ void rtcm2sbp_init(struct rtcm3_sbp_state *state,
   for (u8 i = 0; i < sizeof(state->glo_sv_id_fcn_map); i++) {
     state->glo_sv_id_fcn_map[i] = MSM_GLO_FCN_UNKNOWN;
   }
+  memset(state->glo_sat_cache, 0, sizeof(state->glo_sat_cache));
+  state->glo_sat_generation = 0;
+  invalidate_glo_sat_cache(state);
+  state->glo_time_cache.valid = false;
+
+  memset(state->orbit_clock_cache, 0, sizeof(state->orbit_clock_cache));
 
   memset(state->obs_buffer, 0, sizeof(state->obs_buffer));
   memset(&state->obs_time, 0, sizeof(state->obs_time));
@@ -196,22 +220,13 @@ void rtcm2sbp_init(struct rtcm3_sbp_state *state,
 
   fifo_init(&(state->fifo), state->fifo_buf, RTCM3_FIFO_SIZE);
 
-  state->tow_ms_azel = 0;
-  state->tow_ms_meas = 0;
-  memset(&state->msg_azel_full, 0, sizeof(state->msg_azel_full));
-  memset(&state->msg_meas_full, 0, sizeof(state->msg_meas_full));
-
-  state->msg_azel_full_sent = false;
-  state->msg_meas_full_sent = false;
+  // msg_azel_full & msg_meas_full are set up on the first stgsv msg
+  state->stgsv_initialized = false;
 
-  // Set all bit to 0, then assigns <max_n_sat> with the maximum number of
-  // satellite for each constellation.
+  // All entries start off in generation 0, resetting moves the map on to
+  // generation 1 which leaves every entry empty.
   memset(&state->cons_meas_map, 0, sizeof(state->cons_meas_map));
-  for (rtcm_constellation_t cons = RTCM_CONSTELLATION_GPS;
-       cons < RTCM_CONSTELLATION_COUNT;
-       cons++) {
-    state->cons_meas_map->max_n_sat = constellation_to_num_sats(cons);
-  }
+  state->cons_meas_epoch = 0;
   reset_cons_meas_map(state);
 }
 
@@ -382,6 +397,7 @@ void rtcm2sbp_convert(const rtcm_msg_data_t *rtcm_msg,
       sbp_msg_glo_biases_t *sbp_glo_cpb = &msg.glo_biases;
       memset(sbp_glo_cpb, 0, sizeof(*sbp_glo_cpb));
       rtcm3_1230_to_sbp(msg_1230, sbp_glo_cpb);
+      invalidate_glo_sat_cache(state);
       state->cb_rtcm_to_sbp(rtcm_stn_to_sbp_sender_id(msg_1230->stn_id),
                             SbpMsgGloBiases,
                             &msg,
@@ -396,17 +412,12 @@ void rtcm2sbp_convert(const rtcm_msg_data_t *rtcm_msg,
 
     /* The following two chunks of messages handle converting separate SSR
      * orbit correction and SSR clock correction messages into a single SBP
-     * message containing both orbit and clock corrections. This code makes
-     * the following assumptions:
-     *  1. Each pair of orbit and clock messages contain data for the same
-     * group of satellites, this implies that we don't support the
-     * multimessage flag in the RTCM message. We do match the clock correction
-     * satid with the orbit correction satid, so the corrections don't have to
-     * be in the same order but we will silently drop any correction that we
-     * can't find a matching pair for.
-     *  2. The clock and orbit messages are sent at the same frequency. The
-     * epoch time of the two messages must match for them to be considered
-     * pairs.
+     * message containing both orbit and clock corrections. Corrections are
+     * paired up per satellite, so the orbit and clock messages don't have to
+     * list the satellites in the same order or be split across multiple
+     * messages in the same way. A pair is only formed when the epoch time
+     * and IOD SSR of both corrections match, any correction for which we
+     * can't find a matching pair is silently dropped once it's replaced.
      */
     case 1057:
     case 1063:
@@ -414,25 +425,7 @@ void rtcm2sbp_convert(const rtcm_msg_data_t *rtcm_msg,
     case 1246:
     case 1258: {
       const rtcm_msg_orbit *msg_orbit = &rtcm_msg->message.msg_orbit;
-
-      uint8_t cons = msg_orbit->header.constellation;
-      /* If we already have a matching clock message perform the conversion */
-      if (state->orbit_clock_cache[cons].contains_clock &&
-          (!state->orbit_clock_cache[cons].contains_orbit) &&
-          (state->orbit_clock_cache[cons].data.clock.header.epoch_time ==
-           msg_orbit->header.epoch_time) &&
-          (state->orbit_clock_cache[cons].data.clock.header.iod_ssr ==
-           msg_orbit->header.iod_ssr) &&
-          (state->orbit_clock_cache[cons].data.clock.header.constellation ==
-           msg_orbit->header.constellation)) {
-        rtcm3_ssr_separate_orbit_clock_to_sbp(
-            &state->orbit_clock_cache[cons].data.clock, msg_orbit, state);
-        state->orbit_clock_cache[cons].contains_clock = false;
-      } else { /* Store the decoded message in the cache */
-        state->orbit_clock_cache[cons].data.orbit = *msg_orbit;
-        state->orbit_clock_cache[cons].contains_clock = false;
-        state->orbit_clock_cache[cons].contains_orbit = true;
-      }
+      rtcm3_ssr_separate_orbit_to_sbp(msg_orbit, state);
       break;
     }
     case 1058:
@@ -441,25 +434,7 @@ void rtcm2sbp_convert(const rtcm_msg_data_t *rtcm_msg,
     case 1247:
     case 1259: {
       const rtcm_msg_clock *msg_clock = &rtcm_msg->message.msg_clock;
-
-      uint8_t cons = msg_clock->header.constellation;
-      /* If we already have a matching orbit message perform the conversion */
-      if ((!state->orbit_clock_cache[cons].contains_clock) &&
-          state->orbit_clock_cache[cons].contains_orbit &&
-          (state->orbit_clock_cache[cons].data.orbit.header.epoch_time ==
-           msg_clock->header.epoch_time) &&
-          (state->orbit_clock_cache[cons].data.orbit.header.iod_ssr ==
-           msg_clock->header.iod_ssr) &&
-          (state->orbit_clock_cache[cons].data.orbit.header.constellation ==
-           msg_clock->header.constellation)) {
-        rtcm3_ssr_separate_orbit_clock_to_sbp(
-            msg_clock, &state->orbit_clock_cache[cons].data.orbit, state);
-        state->orbit_clock_cache[cons].contains_orbit = false;
-      } else { /* Store the decoded message in the cache */
-        state->orbit_clock_cache[cons].data.clock = *msg_clock;
-        state->orbit_clock_cache[cons].contains_clock = true;
-        state->orbit_clock_cache[cons].contains_orbit = false;
-      }
+      rtcm3_ssr_separate_clock_to_sbp(msg_clock, state);
       break;
     }
     case 1059:
@@ -594,6 +569,34 @@ void rtcm2sbp_convert(const rtcm_msg_data_t *rtcm_msg,
   }
 }
 
+/* SSR bias messages are by far the largest decoded RTCM messages, so rather
+ * than decoding them into rtcm_msg_data_t they are converted straight off the
+ * payload. Returns false if the payload isn't an SSR bias message. */
+static bool rtcm2sbp_decode_ssr_bias_payload(const uint8_t *payload,
+                                             uint32_t payload_length,
+                                             struct rtcm3_sbp_state *state) {
+  uint16_t msg_num = (uint16_t)rtcm_getbitu(payload, 0, 12);
+  bool code_biases = is_ssr_code_biases_message(msg_num);
+  bool phase_biases = is_ssr_phase_biases_message(msg_num);
+  if (!code_biases && !phase_biases) {
+    return false;
+  }
+
+  if (verbosity_level > VERB_HIGH) {
+    log_info("MID: %5u", msg_num);
+  }
+  state->send_observation_flag = false;
+
+  swiftnav_in_bitstream_t bitstream;
+  swiftnav_in_bitstream_init(&bitstream, payload, payload_length * 8);
+  if (code_biases) {
+    rtcm3_ssr_code_bias_bitstream_to_sbp(&bitstream, state);
+  } else {
+    rtcm3_ssr_phase_bias_bitstream_to_sbp(&bitstream, state);
+  }
+  return true;
+}
+
 void rtcm2sbp_decode_payload(const uint8_t *payload,
                              uint32_t payload_length,
                              struct rtcm3_sbp_state *state) {
@@ -602,6 +605,10 @@ void rtcm2sbp_decode_payload(const uint8_t *payload,
   }
   state->has_cached_time = false;
 
+  if (rtcm2sbp_decode_ssr_bias_payload(payload, payload_length, state)) {
+    return;
+  }
+
   // Decode payload
   rtcm_msg_data_t rtcm_msg = {0};
   if (RC_OK != rtcm3_decode_payload(payload, payload_length, &rtcm_msg)) {
@@ -629,6 +636,16 @@ void rtcm2sbp_decode_frame(const uint8_t *frame,
   }
   state->has_cached_time = false;
 
+  uint16_t payload_length = 0;
+  if ((frame[0] == RTCM3_PREAMBLE) &&
+      (RC_OK ==
+       rtcm3_decode_payload_len(frame, frame_length, &payload_length)) &&
+      (payload_length >= RTCM3_MIN_MSG_LEN) &&
+      (payload_length + RTCM3_MSG_OVERHEAD <= frame_length) &&
+      rtcm2sbp_decode_ssr_bias_payload(frame + 3, payload_length, state)) {
+    return;
+  }
+
   // Decode RTCM frame
   rtcm_frame_t rtcm_frame = {0};
   if (RC_OK != rtcm3_decode_frame(frame, frame_length, &rtcm_frame)) {
@@ -1251,7 +1268,11 @@ void rtcm2sbp_set_glo_fcn(sbp_v4_gnss_signal_t sid,
     log_info("Ignoring invalid GLO PRN %u", sid.sat);
     return;
   }
-  state->glo_sv_id_fcn_map[sid.sat] = sbp_fcn_to_rtcm(sbp_fcn);
+  u8 rtcm_fcn = sbp_fcn_to_rtcm(sbp_fcn);
+  if (state->glo_sv_id_fcn_map[sid.sat] != rtcm_fcn) {
+    state->glo_sv_id_fcn_map[sid.sat] = rtcm_fcn;
+    invalidate_glo_sat_cache(state);
+  }
 }
 
 bool rtcm2sbp_is_using_user_provided_time(struct rtcm3_sbp_state *state) {
@@ -1364,6 +1385,18 @@ bool compute_glo_time(u32 tod_ms,
     return false;
   }
 
+  /* Every GLO message of an epoch resolves the same time of day against the
+   * same reference, reuse the previous result if nothing has changed */
+  struct rtcm_glo_time_cache *cache = &state->glo_time_cache;
+  if (cache->valid && cache->tod_ms == tod_ms &&
+      cache->leap_seconds == leap_seconds &&
+      cache->rover_time.wn == rover_time->wn &&
+      fabs(cache->rover_time.tow - rover_time->tow) <= FLOAT_EQUALITY_EPS) {
+    *obs_time = cache->obs_time;
+    return true;
+  }
+  cache->valid = false;
+
   /* Approximate DOW from the reference GPS time */
   u8 glo_dow = (u8)(rover_time->tow / DAY_SECS);
   s32 glo_tod_ms = tod_ms - UTC_SU_OFFSET * HOUR_SECS * SECS_MS;
@@ -1385,9 +1418,16 @@ bool compute_glo_time(u32 tod_ms,
   double timediff = gpsdifftime(obs_time, rover_time);
   if (fabs(timediff) > DAY_SECS / 2.0) {
     obs_time->tow += (timediff < 0 ? 1 : -1) * DAY_SECS;
-    return normalize_gps_time_safe(obs_time);
+    if (!normalize_gps_time_safe(obs_time)) {
+      return false;
+    }
   }
 
+  cache->valid = true;
+  cache->tod_ms = tod_ms;
+  cache->leap_seconds = leap_seconds;
+  cache->rover_time = *rover_time;
+  cache->obs_time = *obs_time;
   return true;
 }
 
@@ -1694,6 +1734,15 @@ void add_msm_obs_to_buffer(const rtcm_msm_message *new_rtcm_obs,
 
   u8 cell_index = 0;
   for (u8 sat = 0; sat < num_sats; sat++) {
+    /* FCN and FCN biases are shared by all the signals of a GLO satellite */
+    const struct rtcm_glo_sat_cache *glo_sat = NULL;
+    if (RTCM_CONSTELLATION_GLO == cons) {
+      glo_sat = get_glo_sat_cache(&new_rtcm_obs->header,
+                                  sat,
+                                  new_rtcm_obs->sats[sat].glo_fcn,
+                                  state);
+    }
+
     for (u8 sig = 0; sig < num_sigs; sig++) {
       if (new_rtcm_obs->header.cell_mask[sat * num_sigs + sig]) {
         sbp_v4_gnss_signal_t sid = {CODE_INVALID, 0};
@@ -1710,22 +1759,22 @@ void add_msm_obs_to_buffer(const rtcm_msm_message *new_rtcm_obs,
             return;
           }
 
-          /* get GLO FCN */
           uint8_t glo_fcn = MSM_GLO_FCN_UNKNOWN;
-          msm_get_glo_fcn(&new_rtcm_obs->header,
-                          sat,
-                          new_rtcm_obs->sats[sat].glo_fcn,
-                          state->glo_sv_id_fcn_map,
-                          &glo_fcn);
+          double code_bias_m = 0.0;
+          double phase_bias_c = 0.0;
+          if (NULL != glo_sat) {
+            glo_fcn = glo_sat->glo_fcn;
+            int band = glo_fcn_bias_band(sid.code);
+            if (band >= 0) {
+              code_bias_m = glo_sat->code_bias_m[band];
+              phase_bias_c = glo_sat->phase_bias_c[band];
+            }
+          }
 
           double freq;
           bool freq_valid =
               msm_signal_frequency(&new_rtcm_obs->header, sig, glo_fcn, &freq);
 
-          double code_bias_m, phase_bias_c;
-          msm_glo_fcn_bias(
-              &new_rtcm_obs->header, sig, glo_fcn, &code_bias_m, &phase_bias_c);
-
           sbp_packed_obs_content_t *sbp_freq =
               &state->obs_buffer[state->obs_to_send];
 
@@ -1891,9 +1940,102 @@ int rtcm2sbp_process(struct rtcm3_sbp_state *state,
   return read_sz;
 }
 
+/* Finds the next complete frame with a valid CRC, starting the search at
+ * data[index]. Returns the offset of its preamble and stores its length
+ * including header and CRC in frame_length. If there is no such frame
+ * frame_length is set to 0 and the offset at which the search stopped is
+ * returned, either length or the start of a truncated frame. */
+static size_t rtcm_find_frame(const uint8_t *data,
+                              size_t length,
+                              size_t index,
+                              size_t *frame_length) {
+  *frame_length = 0;
+  while (index + RTCM3_MSG_OVERHEAD < length) {
+    const uint8_t *rtcm_msg =
+        memchr(&data[index], RTCM3_PREAMBLE, length - index);
+    if (rtcm_msg == NULL) {
+      return length;
+    }
+    index = (size_t)(rtcm_msg - data);
+    if (index + RTCM3_MSG_OVERHEAD >= length) {
+      return index;
+    }
+
+    /* at least RTCM3_MSG_OVERHEAD bytes are available past the preamble */
+    uint16_t msg_len = 0;
+    if (RC_OK !=
+        rtcm3_decode_payload_len(rtcm_msg, RTCM3_MSG_OVERHEAD, &msg_len)) {
+      index++;
+      continue;
+    }
+    if ((msg_len == 0) || (msg_len > RTCM3_MAX_MSG_LEN)) {
+      index++;
+      continue;
+    }
+    if (index + RTCM3_MSG_OVERHEAD + msg_len > length) {
+      return index;
+    }
+
+    if (!verify_crc(rtcm_msg, msg_len + RTCM3_MSG_OVERHEAD)) {
+      index++;
+      continue;
+    }
+
+    *frame_length = msg_len + RTCM3_MSG_OVERHEAD;
+    return index;
+  }
+  return index;
+}
+
+/**
+ * Converts the RTCM frames held in a contiguous block of memory, e.g. a
+ * memory mapped log file. Frames are decoded straight out of `data`, no
+ * copies are made and no read function is involved.
+ *
+ * @param state An already populated state object
+ * @param data Start of the RTCM data
+ * @param length Number of bytes at `data`
+ * @return Number of bytes consumed, anything past that is the start of an
+ * incomplete frame.
+ */
+size_t rtcm2sbp_process_buffer(struct rtcm3_sbp_state *state,
+                               const uint8_t *data,
+                               size_t length) {
+  size_t index = 0;
+  for (;;) {
+    size_t frame_length;
+    index = rtcm_find_frame(data, length, index, &frame_length);
+    if (frame_length == 0) {
+      return index;
+    }
+
+    rtcm2sbp_decode_frame(&data[index], (uint32_t)frame_length, state);
+    index += frame_length;
+  }
+}
+
+/**
+ * Finds the first complete RTCM frame with a valid CRC which starts at or
+ * after `offset`. Used to split a log into pieces which can be converted
+ * independently with rtcm2sbp_process_buffer().
+ *
+ * @param data Start of the RTCM data
+ * @param length Number of bytes at `data`
+ * @param offset Offset at which to start the search
+ * @return Offset of the frame's preamble, or `length` if there is no complete
+ * frame past `offset`.
+ */
+size_t rtcm2sbp_frame_boundary(const uint8_t *data,
+                               size_t length,
+                               size_t offset) {
+  size_t frame_length;
+  size_t index = rtcm_find_frame(data, length, offset, &frame_length);
+  return frame_length > 0 ? index : length;
+}
+
 /* buf_len is the total allocated space - can be much bigger than
   the actual message */
-static bool verify_crc(uint8_t *buf, uint16_t buf_len) {
+static bool verify_crc(const uint8_t *buf, uint16_t buf_len) {
 #ifdef GNSS_CONVERTERS_DISABLE_CRC_VALIDATION
   return true;
 #endif
@@ -2133,10 +2275,21 @@ static void update_cons_meas_map(constellation_t sbp_cons,
 
   struct rtcm_meas_sat_signal *sat_data =
       &state->cons_meas_map[rtcm_cons].sat_data[rtcm_sid];
-  for (size_t j = 0; j < sat_data->n_signal; j++) {
-    if (sat_data->sig_data[j].code == sid->code) {
-      sat_data->sig_data[j].cn0 = cn0;
-      return;
+  if (sat_data->epoch != state->cons_meas_epoch) {
+    // entry is left over from before the last reset, start it afresh
+    sat_data->epoch = state->cons_meas_epoch;
+    sat_data->n_signal = 0;
+    memset(sat_data->code_mask, 0, sizeof(sat_data->code_mask));
+  }
+
+  size_t mask_word = sid->code / 32;
+  uint32_t mask_bit = 1u << (sid->code % 32);
+  if ((sat_data->code_mask[mask_word] & mask_bit) != 0) {
+    for (size_t j = 0; j < sat_data->n_signal; j++) {
+      if (sat_data->sig_data[j].code == sid->code) {
+        sat_data->sig_data[j].cn0 = cn0;
+        return;
+      }
     }
   }
 
@@ -2145,17 +2298,91 @@ static void update_cons_meas_map(constellation_t sbp_cons,
     sat_data->sig_data[sat_data->n_signal].code = (uint8_t)sid->code;
     sat_data->sig_data[sat_data->n_signal].cn0 = cn0;
     sat_data->n_signal++;
+    sat_data->code_mask[mask_word] |= mask_bit;
   }
 }
 
-static void reset_cons_meas_map(struct rtcm3_sbp_state *state) {
-  for (rtcm_constellation_t cons = RTCM_CONSTELLATION_GPS;
-       cons < RTCM_CONSTELLATION_COUNT;
-       cons++) {
-    for (size_t sid = 0; sid < state->cons_meas_map[cons].max_n_sat; sid++) {
-      state->cons_meas_map[cons].sat_data[sid].n_signal = 0;
+static void invalidate_glo_sat_cache(struct rtcm3_sbp_state *state) {
+  state->glo_sat_generation++;
+  if (state->glo_sat_generation == 0) {
+    // generation counter wrapped around, see reset_cons_meas_map()
+    memset(state->glo_sat_cache, 0, sizeof(state->glo_sat_cache));
+    state->glo_sat_generation = 1;
+  }
+}
+
+/* The bias ratios are public and may be written directly, so entries are
+ * keyed on their values rather than on the setters being called */
+static bool glo_bias_ratios_match(const struct rtcm_glo_sat_cache *entry) {
+  for (u8 band = 0; band < SBP_GLO_FCN_BIAS_BANDS; band++) {
+    if (entry->code_bias_ratio[band] != sbp_glo_code_bias[band] ||
+        entry->phase_bias_ratio[band] != sbp_glo_phase_bias[band]) {
+      return false;
     }
   }
+  return true;
+}
+
+static const struct rtcm_glo_sat_cache *get_glo_sat_cache(
+    const rtcm_msm_header *header,
+    u8 sat_index,
+    u8 fcn_from_sat_info,
+    struct rtcm3_sbp_state *state) {
+  u8 prn = msm_sat_to_prn(header, sat_index);
+  if (PRN_INVALID == prn) {
+    return NULL;
+  }
+  assert(prn < ARRAY_SIZE(state->glo_sat_cache));
+
+  struct rtcm_glo_sat_cache *entry = &state->glo_sat_cache[prn];
+  if (entry->generation == state->glo_sat_generation &&
+      entry->fcn_from_sat_info == fcn_from_sat_info &&
+      glo_bias_ratios_match(entry)) {
+    return entry;
+  }
+
+  entry->glo_fcn = MSM_GLO_FCN_UNKNOWN;
+  msm_get_glo_fcn(header,
+                  sat_index,
+                  fcn_from_sat_info,
+                  state->glo_sv_id_fcn_map,
+                  &entry->glo_fcn);
+  for (u8 band = 0; band < SBP_GLO_FCN_BIAS_BANDS; band++) {
+    glo_fcn_band_bias(band,
+                      entry->glo_fcn,
+                      &entry->code_bias_m[band],
+                      &entry->phase_bias_c[band]);
+  }
+  for (u8 band = 0; band < SBP_GLO_FCN_BIAS_BANDS; band++) {
+    entry->code_bias_ratio[band] = sbp_glo_code_bias[band];
+    entry->phase_bias_ratio[band] = sbp_glo_phase_bias[band];
+  }
+  entry->fcn_from_sat_info = fcn_from_sat_info;
+  entry->generation = state->glo_sat_generation;
+  return entry;
+}
+
+static void reset_cons_meas_map(struct rtcm3_sbp_state *state) {
+  state->cons_meas_epoch++;
+  if (state->cons_meas_epoch == 0) {
+    // generation counter wrapped around, entries written 2^32 resets ago would
+    // otherwise look current again
+    memset(&state->cons_meas_map, 0, sizeof(state->cons_meas_map));
+    state->cons_meas_epoch = 1;
+  }
+}
+
+static const struct rtcm_meas_sat_signal *get_cons_meas_sat(
+    const struct rtcm3_sbp_state *state,
+    rtcm_constellation_t rtcm_cons,
+    uint8_t rtcm_sid) {
+  const struct rtcm_meas_sat_signal *sat_data =
+      &state->cons_meas_map[rtcm_cons].sat_data[rtcm_sid];
+  if ((sat_data->epoch != state->cons_meas_epoch) ||
+      (sat_data->n_signal == 0)) {
+    return NULL;
+  }
+  return sat_data;
 }
 
 // Check if the field_value matches the field_mask and its values are valid.
@@ -2223,9 +2450,9 @@ static bool rtcm3_stgsv_signal_valid(const rtcm_msg_999_stgsv *rtcm_999_stgsv,
     return false;  // Check if the decoded sid is valid.
   }
 
-  struct rtcm_meas_sat_signal sat_sig =
-      state->cons_meas_map[*rtcm_cons].sat_data[*sid];
-  if ((sat_sig.n_signal == 0) || (sat_sig.n_signal != n_signal_valid)) {
+  const struct rtcm_meas_sat_signal *sat_sig =
+      get_cons_meas_sat(state, *rtcm_cons, *sid);
+  if ((sat_sig == NULL) || (sat_sig->n_signal != n_signal_valid)) {
     return false;  // Skip if no equiv signal in "cons_meas_map" or different
                    // info
   }
@@ -2240,7 +2467,7 @@ void rtcm3_stgsv_azel_to_sbp(const rtcm_msg_999_stgsv *rtcm_999_stgsv,
                              sbp_msg_sv_az_el_t *sbp_sv_az_el,
                              const struct rtcm3_sbp_state *state) {
   assert(sbp_sv_az_el);
-  uint8_t sbp_n_sat = 0;
+  uint8_t sbp_n_sat = sbp_sv_az_el->n_azel;
 
   // Scan all field_value (each includes az, el, cn0 [1st-3rd band]
   for (size_t id = 0; id < rtcm_999_stgsv->n_sat; id++) {
@@ -2252,8 +2479,8 @@ void rtcm3_stgsv_azel_to_sbp(const rtcm_msg_999_stgsv *rtcm_999_stgsv,
       continue;
     }
 
-    struct rtcm_meas_sat_signal sat_sig =
-        state->cons_meas_map[cons].sat_data[sid];
+    const struct rtcm_meas_sat_signal *sat_sig =
+        get_cons_meas_sat(state, cons, sid);
 
     // Assign all the signals (with equiv. PRN) to sbp msg.
     // Note: ensure #signals in cons_meas_map == #signals in stgsv.
@@ -2261,13 +2488,13 @@ void rtcm3_stgsv_azel_to_sbp(const rtcm_msg_999_stgsv *rtcm_999_stgsv,
     uint8_t az = (uint8_t)(rtcm_999_stgsv->field_value[id].az / 2);
     int8_t el = rtcm_999_stgsv->field_value[id].el;
 
-    for (size_t j = 0; j < sat_sig.n_signal; j++) {
+    for (size_t j = 0; j < sat_sig->n_signal; j++) {
       if (sbp_n_sat >= SBP_MSG_SV_AZ_EL_AZEL_MAX) {
         break;
       }
 
       sbp_sv_az_el->azel[sbp_n_sat].sid.code =
-          (uint8_t)sat_sig.sig_data[j].code;
+          (uint8_t)sat_sig->sig_data[j].code;
       sbp_sv_az_el->azel[sbp_n_sat].sid.sat = prn;
       sbp_sv_az_el->azel[sbp_n_sat].az = az;
       sbp_sv_az_el->azel[sbp_n_sat].el = el;
@@ -2287,7 +2514,7 @@ void rtcm3_stgsv_meas_to_sbp(const rtcm_msg_999_stgsv *rtcm_999_stgsv,
                              sbp_msg_measurement_state_t *sbp_meas_state,
                              const struct rtcm3_sbp_state *state) {
   assert(sbp_meas_state);
-  uint8_t sbp_n_sat = 0;
+  uint8_t sbp_n_sat = sbp_meas_state->n_states;
 
   // Scan all field_value (each includes az, el, cn0 [1st-3rd band]
   for (size_t id = 0; id < rtcm_999_stgsv->n_sat; id++) {
@@ -2299,17 +2526,17 @@ void rtcm3_stgsv_meas_to_sbp(const rtcm_msg_999_stgsv *rtcm_999_stgsv,
       continue;
     }
 
-    struct rtcm_meas_sat_signal sat_sig =
-        state->cons_meas_map[cons].sat_data[sid];
+    const struct rtcm_meas_sat_signal *sat_sig =
+        get_cons_meas_sat(state, cons, sid);
 
     // Assign all the signals (with equiv. PRN) to sbp msg.
     // Note: ensure #signals in cons_meas_map == #signals in stgsv.
-    for (size_t j = 0; j < sat_sig.n_signal; j++) {
+    for (size_t j = 0; j < sat_sig->n_signal; j++) {
       if (sbp_n_sat >= SBP_MSG_MEASUREMENT_STATE_STATES_MAX) {
         break;
       }
 
-      uint8_t sbp_cn0 = sat_sig.sig_data[j].cn0;
+      uint8_t sbp_cn0 = sat_sig->sig_data[j].cn0;
       // Check <1. cn0 within uint8_t> & <2. cn0 != 0 (invalid value) pg158>
       if (sbp_cn0 == 0) {
         continue;
@@ -2318,7 +2545,7 @@ void rtcm3_stgsv_meas_to_sbp(const rtcm_msg_999_stgsv *rtcm_999_stgsv,
       sbp_meas_state->states[sbp_n_sat].cn0 = sbp_cn0;
       sbp_meas_state->states[sbp_n_sat].mesid.sat = satellite_id2prn(cons, sid);
       sbp_meas_state->states[sbp_n_sat].mesid.code =
-          (uint8_t)sat_sig.sig_data[j].code;
+          (uint8_t)sat_sig->sig_data[j].code;
 
       sbp_n_sat++;
     }
@@ -2326,51 +2553,6 @@ void rtcm3_stgsv_meas_to_sbp(const rtcm_msg_999_stgsv *rtcm_999_stgsv,
   sbp_meas_state->n_states = sbp_n_sat;
 }
 
-/* Dealing with multiple_msg_indicator of STGSV msg
- * Merge all on a single msg */
-static bool rtcm3_expand_multi_msg(sbp_msg_t *msg_full,
-                                   const sbp_msg_t *msg,
-                                   sbp_msg_type_t msg_type) {
-  if (msg_type == SbpMsgSvAzEl) {
-    uint8_t n_sat_pre = msg_full->sv_az_el.n_azel;
-    uint8_t n_sat_stack =
-        MIN((SBP_MSG_SV_AZ_EL_AZEL_MAX - n_sat_pre), msg->sv_az_el.n_azel);
-
-    for (uint8_t i = 0; i < n_sat_stack; i++) {
-      msg_full->sv_az_el.azel[n_sat_pre + i].el = msg->sv_az_el.azel[i].el;
-      msg_full->sv_az_el.azel[n_sat_pre + i].az = msg->sv_az_el.azel[i].az;
-      msg_full->sv_az_el.azel[n_sat_pre + i].sid.sat =
-          msg->sv_az_el.azel[i].sid.sat;
-      msg_full->sv_az_el.azel[n_sat_pre + i].sid.code =
-          msg->sv_az_el.azel[i].sid.code;
-    }
-    msg_full->sv_az_el.n_azel = (uint8_t)(n_sat_pre + n_sat_stack);
-
-    return true;
-  }
-
-  if (msg_type == SbpMsgMeasurementState) {
-    uint8_t n_sat_pre = msg_full->measurement_state.n_states;
-    uint8_t n_sat_stack =
-        MIN((SBP_MSG_MEASUREMENT_STATE_STATES_MAX - n_sat_pre),
-            msg->measurement_state.n_states);
-
-    for (uint8_t i = 0; i < n_sat_stack; i++) {
-      msg_full->measurement_state.states[n_sat_pre + i].cn0 =
-          msg->measurement_state.states[i].cn0;
-      msg_full->measurement_state.states[n_sat_pre + i].mesid.sat =
-          msg->measurement_state.states[i].mesid.sat;
-      msg_full->measurement_state.states[n_sat_pre + i].mesid.code =
-          msg->measurement_state.states[i].mesid.code;
-    }
-    msg_full->measurement_state.n_states = (uint8_t)(n_sat_pre + n_sat_stack);
-
-    return true;
-  }
-
-  return false;
-}
-
 static void reset_check_cons_meas_map(struct rtcm3_sbp_state *state) {
   if (state->msg_azel_full_sent && state->msg_meas_full_sent) {
     reset_cons_meas_map(state);
@@ -2409,13 +2591,10 @@ static void rtcm3_stgsv_azel_to_sbp_update(const rtcm_msg_999 *msg_999,
     rtcm3_state_callback_update(state, SbpMsgSvAzEl);
   }
 
-  sbp_msg_t msg;
-  sbp_msg_sv_az_el_t sbp_az_el;
-  rtcm3_stgsv_azel_to_sbp(&msg_999->data.stgsv, &sbp_az_el, state);
-  msg.sv_az_el = sbp_az_el;
-
+  // Merge multiple msgs on a single msg by appending to the full msg
   if (state->msg_azel_full.sv_az_el.n_azel < SBP_MSG_SV_AZ_EL_AZEL_MAX) {
-    rtcm3_expand_multi_msg(&state->msg_azel_full, &msg, SbpMsgSvAzEl);
+    rtcm3_stgsv_azel_to_sbp(
+        &msg_999->data.stgsv, &state->msg_azel_full.sv_az_el, state);
     state->tow_ms_azel = msg_999->data.stgsv.tow_ms;
   }
 
@@ -2433,14 +2612,12 @@ static void rtcm3_stgsv_meas_to_sbp_update(const rtcm_msg_999 *msg_999,
     rtcm3_state_callback_update(state, SbpMsgMeasurementState);
   }
 
-  sbp_msg_t msg;
-  sbp_msg_measurement_state_t sbp_meas_state;
-  rtcm3_stgsv_meas_to_sbp(&msg_999->data.stgsv, &sbp_meas_state, state);
-  msg.measurement_state = sbp_meas_state;
-
+  // Merge multiple msgs on a single msg by appending to the full msg
   if (state->msg_meas_full.measurement_state.n_states <
       SBP_MSG_MEASUREMENT_STATE_STATES_MAX) {
-    rtcm3_expand_multi_msg(&state->msg_meas_full, &msg, SbpMsgMeasurementState);
+    rtcm3_stgsv_meas_to_sbp(&msg_999->data.stgsv,
+                            &state->msg_meas_full.measurement_state,
+                            state);
     state->tow_ms_meas = msg_999->data.stgsv.tow_ms;
   }
 
@@ -2450,8 +2627,23 @@ static void rtcm3_stgsv_meas_to_sbp_update(const rtcm_msg_999 *msg_999,
   }
 }
 
+static void rtcm3_stgsv_init(struct rtcm3_sbp_state *state) {
+  state->tow_ms_azel = 0;
+  state->tow_ms_meas = 0;
+  memset(&state->msg_azel_full, 0, sizeof(state->msg_azel_full));
+  memset(&state->msg_meas_full, 0, sizeof(state->msg_meas_full));
+
+  state->msg_azel_full_sent = false;
+  state->msg_meas_full_sent = false;
+  state->stgsv_initialized = true;
+}
+
 static void rtcm3_stgsv_to_sbp_update(const rtcm_msg_999 *msg_999,
                                       struct rtcm3_sbp_state *state) {
+  if (!state->stgsv_initialized) {
+    rtcm3_stgsv_init(state);
+  }
+
   uint8_t field_mask = msg_999->data.stgsv.field_mask;
   bool azel_available =
       ((field_mask & RTCM_STGSV_FIELDMASK_AZEL) == RTCM_STGSV_FIELDMASK_AZEL);
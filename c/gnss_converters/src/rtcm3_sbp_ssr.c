@@ -14,6 +14,7 @@
 #include <gnss-converters/internal/rtcm3_sbp_internal.h>
 #include <libsbp/v4/ssr.h>
 #include <math.h>
+#include <rtcm3/ssr_decode.h>
 #include <string.h>
 
 #define SSR_MESSAGE_LENGTH 256
@@ -83,45 +84,109 @@ static void rtcm_ssr_clock_to_sbp(const rtcm_msg_ssr_clock_corr *clock,
   sbp_orbit_clock->c2 = clock->c2;
 }
 
-void rtcm3_ssr_separate_orbit_clock_to_sbp(const rtcm_msg_clock *msg_clock,
-                                           const rtcm_msg_orbit *msg_orbit,
-                                           struct rtcm3_sbp_state *state) {
-  assert(msg_clock);
+/* Looks up the orbit/clock cache entry of a satellite, returns NULL if the
+ * satellite can't be held in the cache */
+static ssr_orbit_clock_cache *get_orbit_clock_cache(
+    const rtcm_msg_ssr_header *header,
+    uint8_t sat_id,
+    struct rtcm3_sbp_state *state) {
+  if ((header->constellation >= CONSTELLATION_COUNT) ||
+      (sat_id >= MAX_SSR_SATELLITES)) {
+    return NULL;
+  }
+  return &state->orbit_clock_cache[header->constellation][sat_id];
+}
+
+static bool orbit_clock_cache_matches(const ssr_orbit_clock_cache *cache,
+                                      const rtcm_msg_ssr_header *header) {
+  return (cache->epoch_time == header->epoch_time) &&
+         (cache->iod_ssr == header->iod_ssr);
+}
+
+static void orbit_clock_cache_store_header(ssr_orbit_clock_cache *cache,
+                                           const rtcm_msg_ssr_header *header) {
+  cache->epoch_time = header->epoch_time;
+  cache->iod_ssr = header->iod_ssr;
+  cache->update_interval = header->update_interval;
+}
+
+void rtcm3_ssr_separate_orbit_to_sbp(const rtcm_msg_orbit *msg_orbit,
+                                     struct rtcm3_sbp_state *state) {
   assert(msg_orbit);
-  assert(msg_clock->header.constellation == msg_orbit->header.constellation);
-  assert(msg_clock->header.epoch_time == msg_orbit->header.epoch_time);
-  assert(msg_clock->header.iod_ssr == msg_orbit->header.iod_ssr);
 
   sbp_msg_t msg;
   sbp_msg_ssr_orbit_clock_t *sbp_orbit_clock = &msg.ssr_orbit_clock;
 
-  for (int sat_count = 0; (sat_count < msg_clock->header.num_sats) &&
-                          (sat_count < msg_orbit->header.num_sats);
-       ++sat_count) {
+  for (int sat_count = 0; sat_count < msg_orbit->header.num_sats;
+       sat_count++) {
+    const rtcm_msg_ssr_orbit_corr *orbit = &msg_orbit->orbit[sat_count];
+    ssr_orbit_clock_cache *cache =
+        get_orbit_clock_cache(&msg_orbit->header, orbit->sat_id, state);
+    if (cache == NULL) {
+      continue;
+    }
+
+    /* If we already have a matching clock correction perform the conversion,
+     * otherwise store the orbit correction until the clock one shows up */
+    if (!cache->contains_clock ||
+        !orbit_clock_cache_matches(cache, &msg_orbit->header)) {
+      orbit_clock_cache_store_header(cache, &msg_orbit->header);
+      cache->data.orbit = *orbit;
+      cache->contains_clock = false;
+      cache->contains_orbit = true;
+      continue;
+    }
+    cache->contains_clock = false;
+
     memset(sbp_orbit_clock, 0, sizeof(*sbp_orbit_clock));
+    if (!rtcm_ssr_header_to_sbp_orbit_clock(
+            &msg_orbit->header, orbit, sbp_orbit_clock, state)) {
+      return;
+    }
+    rtcm_ssr_orbit_to_sbp(orbit, sbp_orbit_clock);
+    rtcm_ssr_clock_to_sbp(&cache->data.clock, sbp_orbit_clock);
 
-    // We aren't guaranteed that the satellite info in the orbit and clock
-    // messages is in the same order so we must search for pair of corrections
-    // for a given satellite
-    int clock_index = sat_count;
-    int orbit_index = 0;
-    while (msg_orbit->orbit[orbit_index].sat_id !=
-               msg_clock->clock[clock_index].sat_id &&
-           orbit_index < msg_orbit->header.num_sats) {
-      orbit_index++;
+    state->cb_rtcm_to_sbp(0, SbpMsgSsrOrbitClock, &msg, state->context);
+  }
+}
+
+void rtcm3_ssr_separate_clock_to_sbp(const rtcm_msg_clock *msg_clock,
+                                     struct rtcm3_sbp_state *state) {
+  assert(msg_clock);
+
+  sbp_msg_t msg;
+  sbp_msg_ssr_orbit_clock_t *sbp_orbit_clock = &msg.ssr_orbit_clock;
+
+  for (int sat_count = 0; sat_count < msg_clock->header.num_sats;
+       sat_count++) {
+    const rtcm_msg_ssr_clock_corr *clock = &msg_clock->clock[sat_count];
+    ssr_orbit_clock_cache *cache =
+        get_orbit_clock_cache(&msg_clock->header, clock->sat_id, state);
+    if (cache == NULL) {
+      continue;
     }
-    if (orbit_index >= msg_orbit->header.num_sats) {
+
+    /* If we already have a matching orbit correction perform the conversion,
+     * otherwise store the clock correction until the orbit one shows up */
+    if (!cache->contains_orbit ||
+        !orbit_clock_cache_matches(cache, &msg_clock->header)) {
+      orbit_clock_cache_store_header(cache, &msg_clock->header);
+      cache->data.clock = *clock;
+      cache->contains_clock = true;
+      cache->contains_orbit = false;
       continue;
     }
+    cache->contains_orbit = false;
 
-    if (!rtcm_ssr_header_to_sbp_orbit_clock(&msg_orbit->header,
-                                            &msg_orbit->orbit[orbit_index],
-                                            sbp_orbit_clock,
-                                            state)) {
+    memset(sbp_orbit_clock, 0, sizeof(*sbp_orbit_clock));
+    if (!rtcm_ssr_header_to_sbp_orbit_clock(
+            &msg_clock->header, &cache->data.orbit, sbp_orbit_clock, state)) {
       return;
     }
-    rtcm_ssr_orbit_to_sbp(&msg_orbit->orbit[orbit_index], sbp_orbit_clock);
-    rtcm_ssr_clock_to_sbp(&msg_clock->clock[clock_index], sbp_orbit_clock);
+    /* The update interval is taken from the orbit message */
+    sbp_orbit_clock->update_interval = cache->update_interval;
+    rtcm_ssr_orbit_to_sbp(&cache->data.orbit, sbp_orbit_clock);
+    rtcm_ssr_clock_to_sbp(clock, sbp_orbit_clock);
 
     state->cb_rtcm_to_sbp(0, SbpMsgSsrOrbitClock, &msg, state->context);
   }
@@ -149,6 +214,96 @@ void rtcm3_ssr_orbit_clock_to_sbp(const rtcm_msg_orbit_clock *msg_orbit_clock,
   }
 }
 
+/* Time stamp of the SBP bias messages converted from an SSR bias message,
+ * returns false if it can't be worked out */
+static bool ssr_bias_time(const rtcm_msg_ssr_header *header,
+                          sbp_gps_time_sec_t *time,
+                          struct rtcm3_sbp_state *state) {
+  gps_time_t rover_time;
+  if (!rtcm_get_gps_time(&rover_time, state)) {
+    return false;
+  }
+
+  *time = compute_ssr_message_time(
+      header->constellation, header->epoch_time * SECS_MS, &rover_time, state);
+  return gps_time_sec_valid(time);
+}
+
+/* Starts the SBP code biases message of a satellite, the signals are then
+ * added with ssr_code_bias_signal_to_sbp() */
+static void ssr_code_bias_sat_to_sbp(const rtcm_msg_ssr_header *header,
+                                     const sbp_gps_time_sec_t *time,
+                                     u8 sat_id,
+                                     sbp_msg_ssr_code_biases_t *sbp_code_bias) {
+  memset(sbp_code_bias, 0, sizeof(*sbp_code_bias));
+  sbp_code_bias->time = *time;
+  sbp_code_bias->sid.code = constellation_to_l1_code(header->constellation);
+  sbp_code_bias->sid.sat = sat_id;
+  sbp_code_bias->update_interval = header->update_interval;
+  sbp_code_bias->iod_ssr = header->iod_ssr;
+}
+
+static void ssr_code_bias_signal_to_sbp(
+    const rtcm_msg_ssr_code_bias_sig *signal,
+    sbp_msg_ssr_code_biases_t *sbp_code_bias) {
+  sbp_code_bias->biases[sbp_code_bias->n_biases].code = signal->signal_id;
+  sbp_code_bias->biases[sbp_code_bias->n_biases].value = signal->code_bias;
+  sbp_code_bias->n_biases++;
+}
+
+/* Starts the SBP phase biases message of a satellite, the signals are then
+ * added with ssr_phase_bias_signal_to_sbp() and the last message is sent with
+ * ssr_phase_bias_sat_done() */
+static void ssr_phase_bias_sat_to_sbp(
+    const rtcm_msg_ssr_header *header,
+    const sbp_gps_time_sec_t *time,
+    u8 sat_id,
+    u16 yaw_angle,
+    s8 yaw_rate,
+    sbp_msg_ssr_phase_biases_t *sbp_phase_bias) {
+  memset(sbp_phase_bias, 0, sizeof(*sbp_phase_bias));
+  sbp_phase_bias->time = *time;
+  sbp_phase_bias->sid.code = constellation_to_l1_code(header->constellation);
+  sbp_phase_bias->sid.sat = sat_id;
+  sbp_phase_bias->update_interval = header->update_interval;
+  sbp_phase_bias->iod_ssr = header->iod_ssr;
+  sbp_phase_bias->dispersive_bias = header->dispersive_bias_consistency;
+  sbp_phase_bias->mw_consistency = header->melbourne_wubbena_consistency;
+  sbp_phase_bias->yaw = yaw_angle;
+  sbp_phase_bias->yaw_rate = yaw_rate;
+}
+
+/* A satellite can have more signals than fit into one SBP message, a full
+ * message is sent straight away and the satellite continues in the next */
+static void ssr_phase_bias_signal_to_sbp(
+    const rtcm_msg_ssr_phase_bias_sig *signal,
+    sbp_msg_t *msg,
+    struct rtcm3_sbp_state *state) {
+  sbp_msg_ssr_phase_biases_t *sbp_phase_bias = &msg->ssr_phase_biases;
+  sbp_phase_biases_content_t *bias =
+      &sbp_phase_bias->biases[sbp_phase_bias->n_biases];
+  bias->code = signal->signal_id;
+  bias->integer_indicator = signal->integer_indicator;
+  bias->widelane_integer_indicator = signal->widelane_indicator;
+  bias->discontinuity_counter = signal->discontinuity_indicator;
+  bias->bias = signal->phase_bias;
+
+  if (++sbp_phase_bias->n_biases >= SBP_MSG_SSR_PHASE_BIASES_BIASES_MAX) {
+    state->cb_rtcm_to_sbp(0, SbpMsgSsrPhaseBiases, msg, state->context);
+    sbp_phase_bias->n_biases = 0;
+  }
+}
+
+/* Sends what is left of a satellite's phase biases, a satellite without any
+ * signals still gets an (empty) message */
+static void ssr_phase_bias_sat_done(u8 num_phase_biases,
+                                    sbp_msg_t *msg,
+                                    struct rtcm3_sbp_state *state) {
+  if (num_phase_biases == 0 || msg->ssr_phase_biases.n_biases > 0) {
+    state->cb_rtcm_to_sbp(0, SbpMsgSsrPhaseBiases, msg, state->context);
+  }
+}
+
 void rtcm3_ssr_code_bias_to_sbp(const rtcm_msg_code_bias *msg_code_biases,
                                 struct rtcm3_sbp_state *state) {
   /**
@@ -162,45 +317,21 @@ void rtcm3_ssr_code_bias_to_sbp(const rtcm_msg_code_bias *msg_code_biases,
       [(SBP_MSG_SSR_CODE_BIASES_BIASES_MAX >= MAX_SSR_SATELLITES) ? 1 : -1];
   (void)__static_assert;
 
-  gps_time_t rover_time;
-  if (!rtcm_get_gps_time(&rover_time, state)) {
+  sbp_gps_time_sec_t time;
+  if (!ssr_bias_time(&msg_code_biases->header, &time, state)) {
     return;
   }
 
   sbp_msg_t msg;
-  sbp_msg_ssr_code_biases_t *sbp_code_bias = &msg.ssr_code_biases;
   for (int sat_count = 0; sat_count < msg_code_biases->header.num_sats;
        sat_count++) {
-    memset(sbp_code_bias, 0, sizeof(*sbp_code_bias));
-    sbp_code_bias->time =
-        compute_ssr_message_time(msg_code_biases->header.constellation,
-                                 msg_code_biases->header.epoch_time * SECS_MS,
-                                 &rover_time,
-                                 state);
-
-    if (!gps_time_sec_valid(&sbp_code_bias->time)) {
-      /* Invalid time */
-      return;
+    const rtcm_msg_ssr_code_bias_sat *sat = &msg_code_biases->sats[sat_count];
+    ssr_code_bias_sat_to_sbp(
+        &msg_code_biases->header, &time, sat->sat_id, &msg.ssr_code_biases);
+    for (int sig_count = 0; sig_count < sat->num_code_biases; sig_count++) {
+      ssr_code_bias_signal_to_sbp(&sat->signals[sig_count],
+                                  &msg.ssr_code_biases);
     }
-
-    sbp_code_bias->sid.code =
-        constellation_to_l1_code(msg_code_biases->header.constellation);
-
-    sbp_code_bias->sid.sat = msg_code_biases->sats[sat_count].sat_id;
-
-    sbp_code_bias->update_interval = msg_code_biases->header.update_interval;
-
-    sbp_code_bias->iod_ssr = msg_code_biases->header.iod_ssr;
-
-    int sig_count = 0;
-    for (; sig_count < msg_code_biases->sats[sat_count].num_code_biases;
-         sig_count++) {
-      sbp_code_bias->biases[sig_count].code =
-          msg_code_biases->sats[sat_count].signals[sig_count].signal_id;
-      sbp_code_bias->biases[sig_count].value =
-          msg_code_biases->sats[sat_count].signals[sig_count].code_bias;
-    }
-    sbp_code_bias->n_biases = sig_count;
     state->cb_rtcm_to_sbp(0, SbpMsgSsrCodeBiases, &msg, state->context);
   }
 }
@@ -213,71 +344,143 @@ void rtcm3_ssr_phase_bias_to_sbp(const rtcm_msg_phase_bias *msg_phase_biases,
         msg_phase_biases->header.epoch_time * SECS_MS);
   }
 
-  gps_time_t rover_time;
-  if (!rtcm_get_gps_time(&rover_time, state)) {
+  sbp_gps_time_sec_t time;
+  if (!ssr_bias_time(&msg_phase_biases->header, &time, state)) {
     return;
   }
 
   sbp_msg_t msg;
-  sbp_msg_ssr_phase_biases_t *sbp_phase_bias = &msg.ssr_phase_biases;
-
   for (int sat_count = 0; sat_count < msg_phase_biases->header.num_sats;
        sat_count++) {
-    memset(sbp_phase_bias, 0, sizeof(*sbp_phase_bias));
-    sbp_phase_bias->time =
-        compute_ssr_message_time(msg_phase_biases->header.constellation,
-                                 msg_phase_biases->header.epoch_time * SECS_MS,
-                                 &rover_time,
-                                 state);
-
-    if (!gps_time_sec_valid(&sbp_phase_bias->time)) {
-      /* Invalid time */
-      return;
+    const rtcm_msg_ssr_phase_bias_sat *sat =
+        &msg_phase_biases->sats[sat_count];
+    ssr_phase_bias_sat_to_sbp(&msg_phase_biases->header,
+                              &time,
+                              sat->sat_id,
+                              sat->yaw_angle,
+                              sat->yaw_rate,
+                              &msg.ssr_phase_biases);
+    for (int sig_count = 0; sig_count < sat->num_phase_biases; sig_count++) {
+      ssr_phase_bias_signal_to_sbp(&sat->signals[sig_count], &msg, state);
     }
+    ssr_phase_bias_sat_done(sat->num_phase_biases, &msg, state);
+  }
+}
 
-    sbp_phase_bias->sid.code =
-        constellation_to_l1_code(msg_phase_biases->header.constellation);
-    sbp_phase_bias->sid.sat = msg_phase_biases->sats[sat_count].sat_id;
-    sbp_phase_bias->update_interval = msg_phase_biases->header.update_interval;
-    sbp_phase_bias->iod_ssr = msg_phase_biases->header.iod_ssr;
-    sbp_phase_bias->dispersive_bias =
-        msg_phase_biases->header.dispersive_bias_consistency;
-    sbp_phase_bias->mw_consistency =
-        msg_phase_biases->header.melbourne_wubbena_consistency;
-    sbp_phase_bias->yaw = msg_phase_biases->sats[sat_count].yaw_angle;
-    sbp_phase_bias->yaw_rate = msg_phase_biases->sats[sat_count].yaw_rate;
-
-    size_t sig_count = 0;
-    size_t bias_index = 0;
-    for (; sig_count < msg_phase_biases->sats[sat_count].num_phase_biases;
-         sig_count++) {
-      sbp_phase_bias->biases[bias_index].code =
-          msg_phase_biases->sats[sat_count].signals[sig_count].signal_id;
-      sbp_phase_bias->biases[bias_index].integer_indicator =
-          msg_phase_biases->sats[sat_count]
-              .signals[sig_count]
-              .integer_indicator;
-      sbp_phase_bias->biases[bias_index].widelane_integer_indicator =
-          msg_phase_biases->sats[sat_count]
-              .signals[sig_count]
-              .widelane_indicator;
-      sbp_phase_bias->biases[bias_index].discontinuity_counter =
-          msg_phase_biases->sats[sat_count]
-              .signals[sig_count]
-              .discontinuity_indicator;
-      sbp_phase_bias->biases[bias_index].bias =
-          msg_phase_biases->sats[sat_count].signals[sig_count].phase_bias;
-
-      if (++bias_index >= SBP_MSG_SSR_PHASE_BIASES_BIASES_MAX) {
-        sbp_phase_bias->n_biases = bias_index;
-        state->cb_rtcm_to_sbp(0, SbpMsgSsrPhaseBiases, &msg, state->context);
-        bias_index = 0;
+/* Walks the satellites and signals of a code bias message without converting
+ * them, returns false if the message is truncated */
+static bool ssr_code_bias_bitstream_complete(
+    swiftnav_in_bitstream_t buff, const rtcm_msg_ssr_header *header) {
+  for (int sat_count = 0; sat_count < header->num_sats; sat_count++) {
+    uint8_t sat_id;
+    uint8_t num_code_biases;
+    if (RC_OK != rtcm3_decode_code_bias_sat_bitstream(
+                     &buff, header, &sat_id, &num_code_biases)) {
+      return false;
+    }
+    for (uint8_t sig_count = 0; sig_count < num_code_biases; sig_count++) {
+      rtcm_msg_ssr_code_bias_sig signal;
+      if (RC_OK != rtcm3_decode_code_bias_signal_bitstream(&buff, &signal)) {
+        return false;
       }
     }
+  }
+  return true;
+}
 
-    if (sig_count == 0 || bias_index > 0) {
-      sbp_phase_bias->n_biases = bias_index;
-      state->cb_rtcm_to_sbp(0, SbpMsgSsrPhaseBiases, &msg, state->context);
+/* As ssr_code_bias_bitstream_complete() for phase bias messages */
+static bool ssr_phase_bias_bitstream_complete(
+    swiftnav_in_bitstream_t buff, const rtcm_msg_ssr_header *header) {
+  for (int sat_count = 0; sat_count < header->num_sats; sat_count++) {
+    uint8_t sat_id;
+    uint8_t num_phase_biases;
+    uint16_t yaw_angle;
+    int8_t yaw_rate;
+    if (RC_OK != rtcm3_decode_phase_bias_sat_bitstream(&buff,
+                                                       header,
+                                                       &sat_id,
+                                                       &num_phase_biases,
+                                                       &yaw_angle,
+                                                       &yaw_rate)) {
+      return false;
+    }
+    for (uint8_t sig_count = 0; sig_count < num_phase_biases; sig_count++) {
+      rtcm_msg_ssr_phase_bias_sig signal;
+      if (RC_OK != rtcm3_decode_phase_bias_signal_bitstream(&buff, &signal)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/* A truncated message is dropped as a whole, like rtcm2sbp_convert() does
+ * when the message can't be decoded, so it is checked to be complete before
+ * anything is sent */
+void rtcm3_ssr_code_bias_bitstream_to_sbp(swiftnav_in_bitstream_t *buff,
+                                          struct rtcm3_sbp_state *state) {
+  rtcm_msg_ssr_header header;
+  if (RC_OK != rtcm3_decode_code_bias_header_bitstream(buff, &header) ||
+      !ssr_code_bias_bitstream_complete(*buff, &header)) {
+    return;
+  }
+
+  sbp_gps_time_sec_t time;
+  if (!ssr_bias_time(&header, &time, state)) {
+    return;
+  }
+
+  /* the message is known to be complete, so decoding can't fail from here */
+  sbp_msg_t msg;
+  for (int sat_count = 0; sat_count < header.num_sats; sat_count++) {
+    uint8_t sat_id;
+    uint8_t num_code_biases;
+    rtcm3_decode_code_bias_sat_bitstream(
+        buff, &header, &sat_id, &num_code_biases);
+    ssr_code_bias_sat_to_sbp(&header, &time, sat_id, &msg.ssr_code_biases);
+    for (uint8_t sig_count = 0; sig_count < num_code_biases; sig_count++) {
+      rtcm_msg_ssr_code_bias_sig signal;
+      rtcm3_decode_code_bias_signal_bitstream(buff, &signal);
+      ssr_code_bias_signal_to_sbp(&signal, &msg.ssr_code_biases);
+    }
+    state->cb_rtcm_to_sbp(0, SbpMsgSsrCodeBiases, &msg, state->context);
+  }
+}
+
+void rtcm3_ssr_phase_bias_bitstream_to_sbp(swiftnav_in_bitstream_t *buff,
+                                           struct rtcm3_sbp_state *state) {
+  rtcm_msg_ssr_header header;
+  if (RC_OK != rtcm3_decode_phase_bias_header_bitstream(buff, &header) ||
+      !ssr_phase_bias_bitstream_complete(*buff, &header)) {
+    return;
+  }
+
+  if (state->observation_time_estimator != NULL) {
+    time_truth_observation_estimator_push(state->observation_time_estimator,
+                                          header.epoch_time * SECS_MS);
+  }
+
+  sbp_gps_time_sec_t time;
+  if (!ssr_bias_time(&header, &time, state)) {
+    return;
+  }
+
+  /* the message is known to be complete, so decoding can't fail from here */
+  sbp_msg_t msg;
+  for (int sat_count = 0; sat_count < header.num_sats; sat_count++) {
+    uint8_t sat_id;
+    uint8_t num_phase_biases;
+    uint16_t yaw_angle;
+    int8_t yaw_rate;
+    rtcm3_decode_phase_bias_sat_bitstream(
+        buff, &header, &sat_id, &num_phase_biases, &yaw_angle, &yaw_rate);
+    ssr_phase_bias_sat_to_sbp(
+        &header, &time, sat_id, yaw_angle, yaw_rate, &msg.ssr_phase_biases);
+    for (uint8_t sig_count = 0; sig_count < num_phase_biases; sig_count++) {
+      rtcm_msg_ssr_phase_bias_sig signal;
+      rtcm3_decode_phase_bias_signal_bitstream(buff, &signal);
+      ssr_phase_bias_signal_to_sbp(&signal, &msg, state);
     }
+    ssr_phase_bias_sat_done(num_phase_biases, &msg, state);
   }
 }
@@ -237,22 +237,38 @@ static void check_nmea_send(sbp2nmea_t *state) {
   const u32 tow_from_gnss = get_tow(state, SBP2NMEA_SBP_UTC_TIME_GNSS, false);
   const float freq = state->soln_freq;
 
+  /* Whether a sentence due on this epoch is still waiting for its input */
+  bool pending = false;
+
   /* Send each NMEA message if all its component SBP messages have been received
    * and current time matches the send rate */
   for (sbp2nmea_nmea_id_t id = 0; id < SBP2NMEA_NMEA_CNT; ++id) {
     u32 tow = nmea_meta[id].available_in_fused ? tow_from_mode : tow_from_gnss;
 
-    if (!nmea_ready(state, id)) {
+    if (!check_nmea_rate(state->nmea_state[id].rate, tow, freq)) {
       continue;
     }
 
-    if (!check_nmea_rate(state->nmea_state[id].rate, tow, freq)) {
+    if (!nmea_ready(state, id)) {
+      pending |= state->nmea_state[id].last_tow != tow &&
+                 (state->requested_mode != SBP2NMEA_MODE_FUSED ||
+                  nmea_meta[id].available_in_fused);
       continue;
     }
 
+    if (state->epoch_tow != tow) {
+      /* the previous epoch is complete */
+      sbp2nmea_flush(state);
+      state->epoch_tow = tow;
+    }
+
     nmea_meta[id].send(state);
     state->nmea_state[id].last_tow = tow;
   }
+
+  if (!pending) {
+    sbp2nmea_flush(state);
+  }
 }
 
 static bool sbp2nmea_discard_sbp(const sbp2nmea_sbp_id_t sbp_id,
@@ -380,6 +396,47 @@ void sbp2nmea_to_str(const sbp2nmea_t *state, char *sentence) {
   state->cb_sbp_to_nmea(sentence, state->ctx);
 }
 
+void sbp2nmea_to_buf(sbp2nmea_t *state, char *sentence, size_t len) {
+  if (NULL == state->cb_sbp_to_nmea_buf) {
+    sbp2nmea_to_str(state, sentence);
+    return;
+  }
+
+  if (!state->epoch_block) {
+    state->cb_sbp_to_nmea_buf(sentence, len, state->ctx);
+    return;
+  }
+
+  if (len > sizeof(state->epoch_buf) - state->epoch_len) {
+    /* deliver the epoch in more than one block rather than dropping any */
+    sbp2nmea_flush(state);
+  }
+  if (len > sizeof(state->epoch_buf)) {
+    state->cb_sbp_to_nmea_buf(sentence, len, state->ctx);
+    return;
+  }
+  MEMCPY_S(&state->epoch_buf[state->epoch_len],
+           sizeof(state->epoch_buf) - state->epoch_len,
+           sentence,
+           len);
+  state->epoch_len += len;
+}
+
+void sbp2nmea_epoch_block_set(sbp2nmea_t *state, bool epoch_block) {
+  if (!epoch_block) {
+    sbp2nmea_flush(state);
+  }
+  state->epoch_block = epoch_block;
+}
+
+void sbp2nmea_flush(sbp2nmea_t *state) {
+  if (0 == state->epoch_len) {
+    return;
+  }
+  state->cb_sbp_to_nmea_buf(state->epoch_buf, state->epoch_len, state->ctx);
+  state->epoch_len = 0;
+}
+
 const sbp_msg_t *sbp2nmea_msg_get(const sbp2nmea_t *state,
                                   sbp2nmea_sbp_id_t id,
                                   bool consider_mode) {
@@ -425,3 +482,13 @@ void sbp2nmea_init(sbp2nmea_t *state,
   state->last_non_stationary_cog = 0;
   state->cog_update_threshold_mps = NMEA_COG_STATIC_LIMIT_MPS;
 }
+
+void sbp2nmea_init_buf(sbp2nmea_t *state,
+                       sbp2nmea_mode_t mode,
+                       void (*cb_sbp_to_nmea_buf)(const char *buf,
+                                                  size_t len,
+                                                  void *ctx),
+                       void *ctx) {
+  sbp2nmea_init(state, mode, NULL, ctx);
+  state->cb_sbp_to_nmea_buf = cb_sbp_to_nmea_buf;
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2026 Swift Navigation Inc.
+ * Contact: Swift Navigation <dev@swiftnav.com>
+ *
+ * This source is subject to the license found in the file 'LICENSE' which must
+ * be be distributed together with this source. All other rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <assert.h>
+#include <gnss-converters/spsc_ring.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <string.h>
+
+typedef _Atomic size_t atomic_ring_index_t;
+
+static_assert(sizeof(atomic_ring_index_t) == sizeof(size_t),
+              "Atomic ring index must be the same size as size_t");
+static_assert(alignof(size_t) % alignof(atomic_ring_index_t) == 0,
+              "Atomic ring index must have compatible alignment with size_t");
+
+#define RING_ATOMIC(field) ((atomic_ring_index_t *)&(field))
+
+bool spsc_ring_init(spsc_ring_t *ring, uint8_t *buffer, size_t size) {
+  assert(ring != NULL);
+  assert(buffer != NULL);
+
+  if (size == 0 || (size & (size - 1)) != 0) {
+    return false;
+  }
+
+  ring->buffer = buffer;
+  ring->mask = size - 1;
+  atomic_init(RING_ATOMIC(ring->head), 0);
+  atomic_init(RING_ATOMIC(ring->tail), 0);
+  atomic_init(RING_ATOMIC(ring->dropped), 0);
+  atomic_init(RING_ATOMIC(ring->high_water), 0);
+  atomic_init(RING_ATOMIC(ring->closed), 0);
+  return true;
+}
+
+size_t spsc_ring_write(spsc_ring_t *ring, const uint8_t *data, size_t len) {
+  size_t head =
+      atomic_load_explicit(RING_ATOMIC(ring->head), memory_order_relaxed);
+  size_t tail =
+      atomic_load_explicit(RING_ATOMIC(ring->tail), memory_order_acquire);
+  size_t size = ring->mask + 1;
+
+  if (len > size - (head - tail)) {
+    atomic_fetch_add_explicit(
+        RING_ATOMIC(ring->dropped), len, memory_order_relaxed);
+    return 0;
+  }
+
+  size_t offset = head & ring->mask;
+  size_t first = size - offset < len ? size - offset : len;
+  memcpy(&ring->buffer[offset], data, first);
+  memcpy(ring->buffer, &data[first], len - first);
+
+  atomic_store_explicit(
+      RING_ATOMIC(ring->head), head + len, memory_order_release);
+
+  size_t occupancy = head + len - tail;
+  if (occupancy > atomic_load_explicit(RING_ATOMIC(ring->high_water),
+                                       memory_order_relaxed)) {
+    atomic_store_explicit(
+        RING_ATOMIC(ring->high_water), occupancy, memory_order_relaxed);
+  }
+  return len;
+}
+
+void spsc_ring_close(spsc_ring_t *ring) {
+  atomic_store_explicit(RING_ATOMIC(ring->closed), 1, memory_order_release);
+}
+
+size_t spsc_ring_read(spsc_ring_t *ring, uint8_t *data, size_t len) {
+  size_t tail =
+      atomic_load_explicit(RING_ATOMIC(ring->tail), memory_order_relaxed);
+  size_t head =
+      atomic_load_explicit(RING_ATOMIC(ring->head), memory_order_acquire);
+  size_t available = head - tail;
+
+  if (len > available) {
+    len = available;
+  }
+  if (len == 0) {
+    return 0;
+  }
+
+  size_t size = ring->mask + 1;
+  size_t offset = tail & ring->mask;
+  size_t first = size - offset < len ? size - offset : len;
+  memcpy(data, &ring->buffer[offset], first);
+  memcpy(&data[first], ring->buffer, len - first);
+
+  atomic_store_explicit(
+      RING_ATOMIC(ring->tail), tail + len, memory_order_release);
+  return len;
+}
+
+bool spsc_ring_drained(const spsc_ring_t *ring) {
+  spsc_ring_t *r = (spsc_ring_t *)ring;
+  /* closed has to be observed before head so that no final write is missed */
+  if (atomic_load_explicit(RING_ATOMIC(r->closed), memory_order_acquire) ==
+      0) {
+    return false;
+  }
+  return spsc_ring_occupancy(ring) == 0;
+}
+
+size_t spsc_ring_occupancy(const spsc_ring_t *ring) {
+  spsc_ring_t *r = (spsc_ring_t *)ring;
+  size_t tail = atomic_load_explicit(RING_ATOMIC(r->tail), memory_order_acquire);
+  size_t head = atomic_load_explicit(RING_ATOMIC(r->head), memory_order_acquire);
+  return head - tail;
+}
+
+size_t spsc_ring_dropped(const spsc_ring_t *ring) {
+  spsc_ring_t *r = (spsc_ring_t *)ring;
+  return atomic_load_explicit(RING_ATOMIC(r->dropped), memory_order_relaxed);
+}
+
+size_t spsc_ring_high_water(const spsc_ring_t *ring) {
+  spsc_ring_t *r = (spsc_ring_t *)ring;
+  return atomic_load_explicit(RING_ATOMIC(r->high_water),
+                              memory_order_relaxed);
+}
@@ -50,6 +50,14 @@ static void pack_ephemeris_bds(const ephemeris_t *e,
   msg->iodc = k->iodc;
 }
 
+/* Word 2 without the SOW and words 3-10 of subframes 1-3 */
+static void bds_eph_fingerprint(const struct sat_data *sat, u32 fp[3][9]) {
+  for (int i = 0; i < 3; i++) {
+    fp[i][0] = sat->sf[i].words[1] & 0x3FFFFU;
+    memcpy(&fp[i][1], &sat->sf[i].words[2], 8 * sizeof(u32));
+  }
+}
+
 /**
  * Decodes BDS D1 subframes.
  * Reference: BDS-SIS-ICD-2.1 (2016-11)
@@ -102,6 +110,15 @@ void bds_decode_subframe(struct ubx_sbp_state *data,
     return; /* received subframes are not in sequence */
   }
 
+  u32 fp[3][9];
+  bds_eph_fingerprint(sat, fp);
+  if (sat->last_eph_valid &&
+      memcmp(fp, sat->last_eph, sizeof(sat->last_eph)) == 0) {
+    data->eph_data.eph_skipped++;
+    invalidate_subframes(sat, /*mask=*/7);
+    return;
+  }
+
   /* Now let's actually decode the ephemeris... */
 
   u32 fraid_words[3][10];
@@ -139,5 +156,8 @@ void bds_decode_subframe(struct ubx_sbp_state *data,
   assert(data->cb_ubx_to_sbp);
   data->cb_ubx_to_sbp(
       data->sender_id, SbpMsgEphemerisBds, &sbp_msg, data->context);
+  data->eph_data.eph_emitted++;
+  memcpy(sat->last_eph, fp, sizeof(sat->last_eph));
+  sat->last_eph_valid = true;
   invalidate_subframes(sat, /*mask=*/7);
 }
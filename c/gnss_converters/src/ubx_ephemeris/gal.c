@@ -73,6 +73,25 @@ static void pack_ephemeris_gal(const ephemeris_t *e,
 /** pages 1,2,3,4,5 are required */
 #define ALL_PAGES_MASK 0x1FU
 
+/* Data bits of word types 1-5 without the WN and TOW of word type 5. Data bit
+ * n of the even page half sits at bit n + 2 of words 0-3, the odd half only
+ * contributes its 16 data bits (its reserved field and CRC are left out). */
+static void gal_eph_fingerprint(const struct gal_sat_data *sat,
+                                u32 fp[5][5]) {
+  for (int i = 0; i < 5; i++) {
+    const u32 *w = &sat->pg[i].words[0];
+    fp[i][0] = w[0];
+    fp[i][1] = w[1];
+    fp[i][2] = w[2];
+    /* tail and padding follow data bit 111 */
+    fp[i][3] = w[3] & 0xFFFFC000U;
+    fp[i][4] = (w[4] >> 14U) & 0xFFFFU;
+  }
+  /* word type 5 data bits 73-104 (WN, TOW) */
+  fp[4][2] &= ~0x1FFFFFU;
+  fp[4][3] &= ~0xFFE00000U;
+}
+
 /**
  * Decodes GAL pages 1-5.
  * Reference: GAL OS SIS ICD, Issue 1.3, December 2016
@@ -136,6 +155,15 @@ void gal_decode_page(struct ubx_sbp_state *data,
     return; /* not all word types 1,2,3,4,5 are available yet */
   }
 
+  u32 fp[5][5];
+  gal_eph_fingerprint(sat, fp);
+  if (sat->last_eph_valid &&
+      memcmp(fp, sat->last_eph, sizeof(sat->last_eph)) == 0) {
+    data->eph_data.eph_skipped++;
+    invalidate_pages(sat, /*mask=*/ALL_PAGES_MASK);
+    return;
+  }
+
   /* Now let's actually decode the ephemeris... */
 
   u8 page[5][GAL_INAV_CONTENT_BYTE];
@@ -190,5 +218,8 @@ void gal_decode_page(struct ubx_sbp_state *data,
   assert(data->cb_ubx_to_sbp);
   data->cb_ubx_to_sbp(
       data->sender_id, SbpMsgEphemerisGal, &sbp_msg, data->context);
+  data->eph_data.eph_emitted++;
+  memcpy(sat->last_eph, fp, sizeof(sat->last_eph));
+  sat->last_eph_valid = true;
   invalidate_pages(sat, /*mask=*/ALL_PAGES_MASK);
 }
@@ -63,6 +63,20 @@ static u8 reverse_byte(u8 b) {
   return b;
 }
 
+/* String bits 85-9 of strings 1-5, the string starts at the MSB of word 0 so
+ * string bit b sits at bit 31 - (85 - b) % 32 of word (85 - b) / 32. The
+ * hamming code and the receiver specific trailer are left out, as is tk
+ * (bits 76-65 of string 1). */
+static void glo_eph_fingerprint(const struct glo_sat_data *sat,
+                                u32 fp[5][3]) {
+  for (int i = 0; i < 5; i++) {
+    fp[i][0] = sat->string[i].words[0];
+    fp[i][1] = sat->string[i].words[1];
+    fp[i][2] = sat->string[i].words[2] & 0xFFF80000U;
+  }
+  fp[0][0] &= ~(0xFFFU << 11U);
+}
+
 /**
  * Decodes GLO pages 1-5.
  * Reference: GLO OS SIS ICD, Issue 1.3, December 2016
@@ -115,6 +129,17 @@ void glo_decode_string(
     return;
   }
 
+  u32 fp[5][3];
+  glo_eph_fingerprint(sat, fp);
+  s32 leap_seconds = (s32)data->utc_params.dt_ls;
+  if (sat->last_eph_valid && sat->last_eph_fcn == fcn &&
+      sat->last_eph_leap_seconds == leap_seconds &&
+      memcmp(fp, sat->last_eph, sizeof(sat->last_eph)) == 0) {
+    data->eph_data.eph_skipped++;
+    invalidate_strings(sat, /*mask=*/ALL_STRINGS_MASK);
+    return;
+  }
+
   /* all pages collected, rearrange the strings byte and bit order to what the
    * decoder expects */
 
@@ -166,5 +191,10 @@ void glo_decode_string(
   assert(data->cb_ubx_to_sbp);
   data->cb_ubx_to_sbp(
       data->sender_id, SbpMsgEphemerisGlo, &sbp_msg, data->context);
+  data->eph_data.eph_emitted++;
+  memcpy(sat->last_eph, fp, sizeof(sat->last_eph));
+  sat->last_eph_fcn = fcn;
+  sat->last_eph_leap_seconds = leap_seconds;
+  sat->last_eph_valid = true;
   invalidate_strings(sat, /*mask=*/ALL_STRINGS_MASK);
 }
@@ -50,6 +50,14 @@ static void pack_ephemeris_gps(const ephemeris_t *e,
   msg->iodc = k->iodc;
 }
 
+/* Words 3-10 of subframes 1-3, TLM and HOW change with every transmission */
+static void gps_eph_fingerprint(const struct sat_data *sat, u32 fp[3][9]) {
+  memset(fp, 0, 3 * sizeof(fp[0]));
+  for (int i = 0; i < 3; i++) {
+    memcpy(&fp[i][0], &sat->sf[i].words[2], 8 * sizeof(u32));
+  }
+}
+
 /**
  * Decodes GPS L1CA subframes.
  * Reference: ICD IS-GPS-200H
@@ -117,6 +125,15 @@ void gps_decode_subframe(struct ubx_sbp_state *data,
     return;
   }
 
+  u32 fp[3][9];
+  gps_eph_fingerprint(sat, fp);
+  if (sat->last_eph_valid &&
+      memcmp(fp, sat->last_eph, sizeof(sat->last_eph)) == 0) {
+    data->eph_data.eph_skipped++;
+    invalidate_subframes(sat, /*mask=*/0x7);
+    return;
+  }
+
   /* Now let's actually decode the ephemeris... */
   u32 frame_words[3][8];
   for (int i = 0; i < 3; i++) {
@@ -149,5 +166,8 @@ void gps_decode_subframe(struct ubx_sbp_state *data,
   assert(data->cb_ubx_to_sbp);
   data->cb_ubx_to_sbp(
       data->sender_id, SbpMsgEphemerisGps, &sbp_msg, data->context);
+  data->eph_data.eph_emitted++;
+  memcpy(sat->last_eph, fp, sizeof(sat->last_eph));
+  sat->last_eph_valid = true;
   invalidate_subframes(sat, /*mask=*/0x7);
 }
@@ -89,215 +89,210 @@
 #define SBP_OBS_DOPPLER_MASK (1 << 3)
 #define SBP_OBS_TRACK_STATE_MASK (0x07)
 
+#ifndef UBX_DISABLE_ESF_RAW
 /* Scale factor to go from ESF-RAW sensor time tags to seconds.
  * This value is not specified in the UBX protocol spec and has been derived
  * from the Bosch BMI 160 datasheet, so it might only be valid for the M8L,
  * which we know uses this IMU.
  */
 static const double ubx_sensortime_scale = 39.0625e-6;
+#endif
 
 /* A single SBP message can only fit a maximum number of observations in it
  * floor((0xFF - sizeof(observation_header_t)) / sizeof(packed_obs_content_t))
  */
 #define SBP_MAX_NUM_OBS 14
 
-/* Syncs data between HNR_PVT and NAV_PVT */
-struct ubx_pvt_state {
-  u8 num_sats;
-  u8 flags;
-  u8 fix_type;
-};
-
-static struct ubx_pvt_state pvt_state;
-
-static int reload_ubx_buffer(struct ubx_sbp_state *state) {
-  state->index = 0;
-  int bytes_read = state->read_stream_func(
-      state->read_buffer, UBX_BUFFER_SIZE, state->context);
-  state->bytes_in_buffer = bytes_read > 0 ? bytes_read : 0;
-  return bytes_read;
-}
-
 static void reset_esf_state(struct ubx_esf_state *state) {
   state->running_imu_msss = -1;
   state->running_odo_msss = -1;
 }
 
-/** Attempts to read `length` bytes into `buf`, implemented as a memcpy from
- * state->read_buffer. If there are not enough bytes in the read_buffer, we
- * attempt to reload the read_buffer. If we still do not have sufficient bytes,
- * we assume EOF reached and return -1.
+/** Makes sure that at least `length` unread bytes are available in
+ * state->read_buffer starting at state->index. When a refill is needed the
+ * unread bytes are first moved to the front of the buffer, this is the only
+ * copy the framer makes and it only happens when a frame straddles a refill.
+ * Returns a positive value on success, otherwise the zero or negative value
+ * returned by read_stream_func.
  */
-static int read_ubx_bytes(u8 *buf, size_t length, struct ubx_sbp_state *state) {
-  int bytes_read = 0;
-  while (state->index + length > state->bytes_in_buffer) {
-    if (state->bytes_in_buffer == 0) {
-      /* Try again in case we perfectly aligned read */
-      int reload_bytes = reload_ubx_buffer(state);
-      if (reload_bytes <= 0) {
-        return reload_bytes;
-      }
-      continue;
+static int fill_ubx_buffer(size_t length, struct ubx_sbp_state *state) {
+  assert(length <= UBX_BUFFER_SIZE);
+  while (state->bytes_in_buffer - state->index < length) {
+    size_t unread = state->bytes_in_buffer - state->index;
+    if (state->index > 0) {
+      memmove(state->read_buffer, &state->read_buffer[state->index], unread);
+      state->index = 0;
+      state->bytes_in_buffer = unread;
     }
 
-    size_t remaining_bytes = state->bytes_in_buffer - state->index;
-    memcpy(
-        buf + bytes_read, &state->read_buffer[state->index], remaining_bytes);
-    length -= remaining_bytes;
-    bytes_read += remaining_bytes;
-    int reload_bytes = reload_ubx_buffer(state);
-    if (reload_bytes <= 0) {
-      return reload_bytes;
+    int bytes_read = state->read_stream_func(&state->read_buffer[unread],
+                                             UBX_BUFFER_SIZE - unread,
+                                             state->context);
+    if (bytes_read <= 0) {
+      return bytes_read;
     }
+    state->bytes_in_buffer += (size_t)bytes_read;
   }
-
-  memcpy(buf + bytes_read, &state->read_buffer[state->index], length);
-  state->index += length;
-  bytes_read += length;
-
-  return bytes_read;
+  return 1;
 }
 
 /** UBX Frame:
  * SYNC_CHAR_1 | SYNC_CHAR_2 | CLASS | MSG_ID | 2-byte Length | Payload |
  * CHCKSUM_BYTE_1 | CHCKSUM_BYTE_2
+ *
+ * Scans state->read_buffer in place for the next valid frame and points
+ * `frame` at it, starting from the class byte and excluding the checksum.
+ * The view stays valid until the next call. Returns the length of the view,
+ * or a negative value once the stream is exhausted.
  */
-static int read_ubx_frame(u8 *frame, struct ubx_sbp_state *state) {
+static int read_ubx_frame(swiftnav_bytestream_t *frame,
+                          struct ubx_sbp_state *state) {
+  const size_t header_length = UBX_CLASS_BYTE_COUNT + UBX_MSG_ID_BYTE_COUNT +
+                               UBX_LENGTH_BYTE_COUNT;
   int ret;
-  do {
-    ret = read_ubx_bytes(frame, 1, state);
+  for (;;) {
+    ret = fill_ubx_buffer(1, state);
     if (ret <= 0) {
       return ret == 0 ? -1 : ret;
     }
 
-    if (frame[0] != UBX_SYNC_CHAR_1) {
+    const u8 *unread = &state->read_buffer[state->index];
+    const u8 *sync =
+        memchr(unread, UBX_SYNC_CHAR_1, state->bytes_in_buffer - state->index);
+    if (sync == NULL) {
+      state->index = state->bytes_in_buffer;
       continue;
     }
+    state->index += (size_t)(sync - unread);
 
-    while (frame[0] == UBX_SYNC_CHAR_1) {
-      ret = read_ubx_bytes(frame, 1, state);
-      if (ret <= 0) {
-        return ret == 0 ? -1 : ret;
-      }
+    ret = fill_ubx_buffer(UBX_SYNC_BYTE_COUNT, state);
+    if (ret <= 0) {
+      return ret == 0 ? -1 : ret;
     }
-
-    if (frame[0] != UBX_SYNC_CHAR_2) {
+    if (state->read_buffer[state->index + 1] != UBX_SYNC_CHAR_2) {
+      state->index++;
       continue;
     }
+    state->index += UBX_SYNC_BYTE_COUNT;
 
-    ret = read_ubx_bytes(frame, 4, state);
+    /* From here on a rejected frame resumes the scan at its class byte, in
+     * case the sync characters were part of a corrupted frame */
+    ret = fill_ubx_buffer(header_length, state);
     if (ret <= 0) {
       return ret == 0 ? -1 : ret;
     }
 
     /* First two bytes are class and msg ID */
-    u16 payload_length = frame[2] + (frame[3] << 8);
+    const u8 *header = &state->read_buffer[state->index];
+    u16 payload_length = header[2] + (header[3] << 8);
     /* Assume massive payload is due to corrupted message. 2 bytes for header, 2
-     * bytes for length, 2 bytes for checksum not counted in payload_length
+     * bytes for length, 2 bytes for checksum not counted in payload_length.
+     * This also guarantees that the frame fits in the read buffer.
      */
     if (payload_length > UBX_FRAME_SIZE - 6) {
       log_warn(
           "UBX payload_length for class 0x%X and ID 0x%X too large: %d; "
           "possible corrupted frame",
-          frame[0],
-          frame[1],
+          header[0],
+          header[1],
           payload_length);
       continue;
     }
 
-    /* +2 for checksum bytes */
-    ret = read_ubx_bytes(frame + 4, payload_length + 2, state);
+    size_t frame_length = header_length + payload_length;
+    ret = fill_ubx_buffer(frame_length + UBX_CHECKSUM_BYTE_COUNT, state);
     if (ret <= 0) {
       return ret == 0 ? -1 : ret;
     }
+    const u8 *buf = &state->read_buffer[state->index];
 
 #ifndef GNSS_CONVERTERS_DISABLE_CRC_VALIDATION
     u8 checksum[2];
-    ubx_checksum(frame, 4 + payload_length, (u8 *)&checksum);
-    if (memcmp(&checksum, frame + 4 + payload_length, 2) != 0) {
+    ubx_checksum(buf, frame_length, checksum);
+    if (memcmp(checksum, buf + frame_length, 2) != 0) {
       continue;
     }
 #endif
-    return payload_length + 4;
 
-  } while (state->bytes_in_buffer != 0);
-
-  return -1;
+    state->index += frame_length + UBX_CHECKSUM_BYTE_COUNT;
+    swiftnav_bytestream_init(frame, buf, (u32)frame_length);
+    return (int)frame_length;
+  }
 }
 
-static code_t convert_ubx_gnssid_sigid(u8 gnss_id, u8 sig_id) {
-  /* GPS L1C/A */
-  if ((gnss_id == 0) && (sig_id == 0)) {
-    return CODE_GPS_L1CA;
-  }
-  /* GPS L2 CL */
-  if ((gnss_id == UBX_GNSS_ID_GPS) && (sig_id == 3)) {
-    return CODE_GPS_L2CL;
-  }
-  /* GPS L2 CM */
-  if ((gnss_id == UBX_GNSS_ID_GPS) && (sig_id == 4)) {
-    return CODE_GPS_L2CM;
-  }
-  /* SBAS L1 CA */
-  if ((gnss_id == UBX_GNSS_ID_SBAS) && (sig_id == 0)) {
-    return CODE_SBAS_L1CA;
-  }
-  /* Galileo E1 C */
-  if ((gnss_id == UBX_GNSS_ID_GAL) && (sig_id == 0)) {
-    return CODE_GAL_E1C;
-  }
-  /* Galileo E1 B */
-  if ((gnss_id == UBX_GNSS_ID_GAL) && (sig_id == 1)) {
-    return CODE_GAL_E1B;
-  }
-  /* Galileo E5 bI */
-  if ((gnss_id == UBX_GNSS_ID_GAL) && (sig_id == 5)) {
-    return CODE_GAL_E7I;
-  }
-  /* Galileo E5 bQ */
-  if ((gnss_id == UBX_GNSS_ID_GAL) && (sig_id == 6)) {
-    return CODE_GAL_E7Q;
-  }
-  /* BeiDou B1I D1 */
-  if ((gnss_id == UBX_GNSS_ID_BDS) && (sig_id == 0)) {
-    return CODE_BDS2_B1;
-  }
-  /* BeiDou B1I D2 */
-  if ((gnss_id == UBX_GNSS_ID_BDS) && (sig_id == 1)) {
-    return CODE_BDS2_B1;
-  }
-  /* BeiDou B2I D1 */
-  if ((gnss_id == UBX_GNSS_ID_BDS) && (sig_id == 2)) {
-    return CODE_BDS2_B2;
-  }
-  /* BeiDou B2I D2 */
-  if ((gnss_id == UBX_GNSS_ID_BDS) && (sig_id == 3)) {
-    return CODE_BDS2_B2;
-  }
-  /* QZSS L1C/A */
-  if ((gnss_id == UBX_GNSS_ID_QZSS) && (sig_id == 0)) {
-    return CODE_QZS_L1CA;
-  }
-  /* QZSS L2 CM */
-  if ((gnss_id == UBX_GNSS_ID_QZSS) && (sig_id == 4)) {
-    return CODE_QZS_L2CM;
-  }
-  /* QZSS L2 CL */
-  if ((gnss_id == UBX_GNSS_ID_QZSS) && (sig_id == 5)) {
-    return CODE_QZS_L2CL;
-  }
-  /* GLONASS L1 OF */
-  if ((gnss_id == UBX_GNSS_ID_GLO) && (sig_id == 0)) {
-    return CODE_GLO_L1OF;
-  }
-  /* GLONASS L2 OF */
-  if ((gnss_id == UBX_GNSS_ID_GLO) && (sig_id == 2)) {
-    return CODE_GLO_L2OF;
-  }
+/* Number of UBX gnssId / sigId values covered by ubx_gnssid_sigid_codes */
+#define UBX_GNSS_ID_COUNT 7
+#define UBX_SIG_ID_COUNT 8
+
+/* SBP code for each UBX gnssId (row) and sigId (column) pair */
+static const code_t ubx_gnssid_sigid_codes[UBX_GNSS_ID_COUNT]
+                                          [UBX_SIG_ID_COUNT] = {
+    [UBX_GNSS_ID_GPS] = {CODE_GPS_L1CA, /* L1C/A */
+                         CODE_INVALID,
+                         CODE_INVALID,
+                         CODE_GPS_L2CL, /* L2 CL */
+                         CODE_GPS_L2CM, /* L2 CM */
+                         CODE_INVALID,
+                         CODE_INVALID,
+                         CODE_INVALID},
+    [UBX_GNSS_ID_SBAS] = {CODE_SBAS_L1CA, /* L1C/A */
+                          CODE_INVALID,
+                          CODE_INVALID,
+                          CODE_INVALID,
+                          CODE_INVALID,
+                          CODE_INVALID,
+                          CODE_INVALID,
+                          CODE_INVALID},
+    [UBX_GNSS_ID_GAL] = {CODE_GAL_E1C, /* E1 C */
+                         CODE_GAL_E1B, /* E1 B */
+                         CODE_INVALID,
+                         CODE_INVALID,
+                         CODE_INVALID,
+                         CODE_GAL_E7I, /* E5 bI */
+                         CODE_GAL_E7Q, /* E5 bQ */
+                         CODE_INVALID},
+    [UBX_GNSS_ID_BDS] = {CODE_BDS2_B1, /* B1I D1 */
+                         CODE_BDS2_B1, /* B1I D2 */
+                         CODE_BDS2_B2, /* B2I D1 */
+                         CODE_BDS2_B2, /* B2I D2 */
+                         CODE_INVALID,
+                         CODE_INVALID,
+                         CODE_INVALID,
+                         CODE_INVALID},
+    [UBX_GNSS_ID_IMES] = {CODE_INVALID,
+                          CODE_INVALID,
+                          CODE_INVALID,
+                          CODE_INVALID,
+                          CODE_INVALID,
+                          CODE_INVALID,
+                          CODE_INVALID,
+                          CODE_INVALID},
+    [UBX_GNSS_ID_QZSS] = {CODE_QZS_L1CA, /* L1C/A */
+                          CODE_INVALID,
+                          CODE_INVALID,
+                          CODE_INVALID,
+                          CODE_QZS_L2CM, /* L2 CM */
+                          CODE_QZS_L2CL, /* L2 CL */
+                          CODE_INVALID,
+                          CODE_INVALID},
+    [UBX_GNSS_ID_GLO] = {CODE_GLO_L1OF, /* L1 OF */
+                         CODE_INVALID,
+                         CODE_GLO_L2OF, /* L2 OF */
+                         CODE_INVALID,
+                         CODE_INVALID,
+                         CODE_INVALID,
+                         CODE_INVALID,
+                         CODE_INVALID},
+};
 
-  return CODE_INVALID;
+code_t ubx_convert_gnssid_sigid(u8 gnss_id, u8 sig_id) {
+  if (gnss_id >= UBX_GNSS_ID_COUNT || sig_id >= UBX_SIG_ID_COUNT) {
+    return CODE_INVALID;
+  }
+  return ubx_gnssid_sigid_codes[gnss_id][sig_id];
 }
 
+#ifndef UBX_DISABLE_RXM_RAWX
 static bool pack_carrier_phase(double L_in, sbp_carrier_phase_t *L_out) {
   double Li = floor(L_in);
   if (Li < INT32_MIN || Li > INT32_MAX) {
@@ -336,6 +331,7 @@ static bool pack_doppler(double D_in, sbp_doppler_t *D_out) {
 
   return true;
 }
+#endif
 
 s32 convert24b(u32 value) {
   const int MODULO = 1 << 24;
@@ -356,10 +352,9 @@ void check_overflow(s32 *value) {
   }
 }
 
-static int fill_msg_obs(const ubx_rxm_rawx *rxm_rawx,
-                        sbp_v4_gps_time_t *obs_time,
-                        uint8_t *n_obs,
-                        sbp_packed_obs_content_t *obs) {
+#ifndef UBX_DISABLE_RXM_RAWX
+static void fill_obs_time(const ubx_rxm_rawx_header *rxm_rawx,
+                          sbp_v4_gps_time_t *obs_time) {
   /* convert from sec to ms */
   double ms = UBX_SBP_TOW_MS_SCALING * rxm_rawx->rcv_tow;
   double ns = UBX_SBP_TOW_NS_SCALING * modf(ms, &ms);
@@ -375,39 +370,36 @@ static int fill_msg_obs(const ubx_rxm_rawx *rxm_rawx,
   } else {
     obs_time->wn = rxm_rawx->rcv_wn;
   }
-  /* Not proper SBP n_obs. Needed to pass total number of measurements
-   * to handle_rxm_rawx
-   */
-  *n_obs = rxm_rawx->num_meas;
-
-  for (int i = 0; i < *n_obs; i++) {
-    /* convert units: meter -> 2 cm */
-    obs[i].P = (u32)(UBX_SBP_PSEUDORANGE_SCALING * rxm_rawx->pseudorange_m[i]);
-    pack_carrier_phase(rxm_rawx->carrier_phase_cycles[i], &obs[i].L);
-    pack_doppler(rxm_rawx->doppler_hz[i], &obs[i].D);
-    /* check for overflow */
-    if (rxm_rawx->cno_dbhz[i] > 0x3F) {
-      obs[i].cn0 = 0xFF;
-    } else {
-      obs[i].cn0 = 4 * rxm_rawx->cno_dbhz[i];
-    }
-    /* TODO(STAR-919) converts from u32 ms, to double s; encode_lock_time
-     * internally converts back to u32 ms.
-     */
-    obs[i].lock = encode_lock_time((double)rxm_rawx->lock_time[i] / SECS_MS);
-    obs[i].flags = 0;
-    /* currently assumes all doppler are valid */
-    obs[i].flags |= SBP_OBS_DOPPLER_MASK;
-    obs[i].flags |= rxm_rawx->track_state[i] & SBP_OBS_TRACK_STATE_MASK;
-    obs[i].sid.sat = rxm_rawx->sat_id[i];
-    obs[i].sid.code =
-        convert_ubx_gnssid_sigid(rxm_rawx->gnss_id[i], rxm_rawx->sig_id[i]);
-  }
+}
 
-  return 0;
+static void fill_packed_obs(const ubx_rxm_rawx_meas *meas,
+                            sbp_packed_obs_content_t *obs) {
+  /* convert units: meter -> 2 cm */
+  obs->P = (u32)(UBX_SBP_PSEUDORANGE_SCALING * meas->pseudorange_m);
+  pack_carrier_phase(meas->carrier_phase_cycles, &obs->L);
+  pack_doppler(meas->doppler_hz, &obs->D);
+  /* check for overflow */
+  if (meas->cno_dbhz > 0x3F) {
+    obs->cn0 = 0xFF;
+  } else {
+    obs->cn0 = 4 * meas->cno_dbhz;
+  }
+  /* TODO(STAR-919) converts from u32 ms, to double s; encode_lock_time
+   * internally converts back to u32 ms.
+   */
+  obs->lock = encode_lock_time((double)meas->lock_time / SECS_MS);
+  obs->flags = 0;
+  /* currently assumes all doppler are valid */
+  obs->flags |= SBP_OBS_DOPPLER_MASK;
+  obs->flags |= meas->track_state & SBP_OBS_TRACK_STATE_MASK;
+  obs->sid.sat = meas->sat_id;
+  obs->sid.code = ubx_convert_gnssid_sigid(meas->gnss_id, meas->sig_id);
 }
+#endif
 
+#ifndef UBX_DISABLE_NAV_ATT
 static int fill_msg_orient_euler(swiftnav_bytestream_t *buf,
+                                 const struct ubx_pvt_state *pvt_state,
                                  sbp_msg_orient_euler_t *msg) {
   ubx_nav_att nav_att;
   if (ubx_decode_nav_att_bytestream(buf, &nav_att) != RC_OK) {
@@ -424,15 +416,18 @@ static int fill_msg_orient_euler(swiftnav_bytestream_t *buf,
   msg->yaw_accuracy = (float)(nav_att.acc_heading * UBX_NAV_ATT_ACC_SCALING);
 
   msg->flags = 0;
-  if ((pvt_state.fix_type == UBX_NAV_PVT_FIX_TYPE_DEAD_RECKONING) ||
-      (pvt_state.fix_type == UBX_NAV_PVT_FIX_TYPE_COMBINED)) {
+  if ((pvt_state->fix_type == UBX_NAV_PVT_FIX_TYPE_DEAD_RECKONING) ||
+      (pvt_state->fix_type == UBX_NAV_PVT_FIX_TYPE_COMBINED)) {
     msg->flags |= SBP_ORIENT_EULER_INS_MASK;
   }
 
   return 0;
 }
+#endif
 
+#ifndef UBX_DISABLE_NAV_PVT
 static int fill_msg_pos_llh(swiftnav_bytestream_t *buf,
+                            struct ubx_pvt_state *pvt_state,
                             sbp_msg_pos_llh_t *msg) {
   ubx_nav_pvt nav_pvt;
   if (ubx_decode_nav_pvt_bytestream(buf, &nav_pvt) != RC_OK) {
@@ -453,7 +448,7 @@ static int fill_msg_pos_llh(swiftnav_bytestream_t *buf,
                               ? max_accuracy
                               : nav_pvt.vertical_accuracy);
   msg->n_sats = nav_pvt.num_sats;
-  pvt_state.num_sats = nav_pvt.num_sats;
+  pvt_state->num_sats = nav_pvt.num_sats;
 
   msg->flags = 0;
   if ((nav_pvt.fix_type == UBX_NAV_PVT_FIX_TYPE_NONE) ||
@@ -491,13 +486,16 @@ static int fill_msg_pos_llh(swiftnav_bytestream_t *buf,
     msg->flags |= SBP_LLH_INS_MASK;
   }
 
-  pvt_state.flags = msg->flags;
-  pvt_state.fix_type = nav_pvt.fix_type;
+  pvt_state->flags = msg->flags;
+  pvt_state->fix_type = nav_pvt.fix_type;
 
   return 0;
 }
+#endif
 
+#ifndef UBX_DISABLE_NAV_VELECEF
 static int fill_msg_vel_ecef(swiftnav_bytestream_t *buf,
+                             const struct ubx_pvt_state *pvt_state,
                              sbp_msg_vel_ecef_t *msg) {
   ubx_nav_velecef nav_velecef;
   if (ubx_decode_nav_velecef_bytestream(buf, &nav_velecef) != RC_OK) {
@@ -509,10 +507,10 @@ static int fill_msg_vel_ecef(swiftnav_bytestream_t *buf,
   msg->y = nav_velecef.ecefVY * UBX_NAV_VELECEF_SCALING;
   msg->z = nav_velecef.ecefVZ * UBX_NAV_VELECEF_SCALING;
   msg->accuracy = nav_velecef.speed_acc;
-  msg->n_sats = pvt_state.num_sats;
+  msg->n_sats = pvt_state->num_sats;
   msg->flags = 0;
   /* Assume either invalid or dead reckoning. Temp. hack */
-  if (pvt_state.fix_type > 0) {
+  if (pvt_state->fix_type > 0) {
     msg->flags |= SBP_LLH_DEAD_RECKONING_MASK;
   } else {
     msg->flags = 0;
@@ -522,8 +520,11 @@ static int fill_msg_vel_ecef(swiftnav_bytestream_t *buf,
 
   return 0;
 }
+#endif
 
+#ifndef UBX_DISABLE_HNR_PVT
 static void fill_msg_pos_llh_hnr(const ubx_hnr_pvt *hnr_pvt,
+                                 const struct ubx_pvt_state *pvt_state,
                                  sbp_msg_pos_llh_t *msg) {
   msg->tow = hnr_pvt->i_tow;
   msg->lat = UBX_SBP_LAT_LON_SCALING * hnr_pvt->lat;
@@ -539,10 +540,12 @@ static void fill_msg_pos_llh_hnr(const ubx_hnr_pvt *hnr_pvt,
                               ? max_accuracy
                               : hnr_pvt->vertical_accuracy);
 
-  msg->n_sats = pvt_state.num_sats;
-  msg->flags = pvt_state.flags;
+  msg->n_sats = pvt_state->num_sats;
+  msg->flags = pvt_state->flags;
 }
+#endif
 
+#ifndef UBX_DISABLE_MON_HW
 static int fill_msg_fwd(swiftnav_bytestream_t *buf, sbp_msg_fwd_t *msg) {
   size_t copy_len = swiftnav_bytestream_remaining(buf);
   size_t max_copy_len = sizeof(msg->fwd_payload);
@@ -561,7 +564,9 @@ static int fill_msg_fwd(swiftnav_bytestream_t *buf, sbp_msg_fwd_t *msg) {
   msg->n_fwd_payload = copy_len;
   return copy_len;
 }
+#endif
 
+#ifndef UBX_DISABLE_ESF_MEAS
 static bool is_odo(u8 data_type) {
   return (ESF_REAR_LEFT_WHEEL_TICKS == data_type) ||
          (ESF_REAR_RIGHT_WHEEL_TICKS == data_type) ||
@@ -702,6 +707,7 @@ static void handle_esf_meas(struct ubx_sbp_state *state,
     }
   }
 }
+#endif
 
 int16_t ubx_convert_temperature_to_bmi160(double temperature_degrees) {
   if (temperature_degrees >= 87.0 - 1.0 / 512.0) {
@@ -717,6 +723,7 @@ int16_t ubx_convert_temperature_to_bmi160(double temperature_degrees) {
   return (int16_t)imu_temp_bmi160_scaled;
 }
 
+#ifndef UBX_DISABLE_ESF_RAW
 struct sbp_imuraw_timespec {
   u32 tow;
   u8 tow_f;
@@ -792,52 +799,73 @@ static void maybe_parse_imu_data(s32 parsed_value,
   }
 }
 
-static bool set_sbp_imu_time(u32 sensortime_this_message,
-                             u32 sensortime_first_message,
-                             s64 msss,
-                             sbp_msg_imu_raw_t *msg,
-                             struct ubx_esf_state *esf_state) {
+/* IMU samples of a single ESF-RAW frame in frame order, one array per field.
+ * The time of applicability of each sample is filled in for the whole block
+ * at once by set_esf_raw_imu_times(). Each sample also records the gyro
+ * temperature that was current when it was read, end_temp holds the one
+ * current after the last sample of the frame. */
+struct esf_raw_imu_block {
+  size_t n_samples;
+  u8 data_type[ESF_DATA_MAX_COUNT];
+  s32 value[ESF_DATA_MAX_COUNT];
+  u32 time_tag[ESF_DATA_MAX_COUNT];
+  bool completes_msg[ESF_DATA_MAX_COUNT];
+  double temp[ESF_DATA_MAX_COUNT];
+  bool temp_set[ESF_DATA_MAX_COUNT];
+  double end_temp;
+  bool end_temp_set;
+  u32 tow[ESF_DATA_MAX_COUNT];
+  u8 tow_f[ESF_DATA_MAX_COUNT];
+};
+
+static void set_esf_raw_imu_times(struct esf_raw_imu_block *block,
+                                  u32 sensortime_first_message,
+                                  s64 msss,
+                                  struct ubx_esf_state *esf_state) {
   // The SBP protocol expects CPU local timestamps to wrap around after one
   // week. We thus wrap the time into gps_time_t struct and
   // normalize it.
   const double first_msg_tss = 0.001 * msss;
   gps_time_t cpu_local_time_first_message = {.tow = first_msg_tss, .wn = 0};
   if (!normalize_gps_time_safe(&cpu_local_time_first_message)) {
-    return false;
-  }
-
-  // The msss field contains only the time for the first IMU data packet of this
-  // burst - we derive subsequent timestamps by diffs on the sensor time. The
-  // sensor time has a wraparound at 24 bits that we need to handle.
-  s32 sensor_time_diff = sensortime_this_message - sensortime_first_message;
-  while (sensor_time_diff < 0) {
-    sensor_time_diff += (1 << 24); /* unwrap 24 bit overflow */
+    block->n_samples = 0;
+    return;
   }
 
-  double sensor_tss_s = ubx_sensortime_scale * sensor_time_diff + first_msg_tss;
   // This constant has been found empirically by comparing the M8L IMU angular
   // rate with a properly time stamped reference.
   const double ubx_imu_gnss_time_offset = 0.05;
-  gps_time_t imu_time_msss;
-  imu_time_msss.tow = sensor_tss_s - ubx_imu_gnss_time_offset;
-  imu_time_msss.wn = 0;
-  if (!normalize_gps_time_safe(&imu_time_msss)) {
-    return false;
-  }
-  if (!gps_time_match_weeks_safe(&imu_time_msss,
-                                 &cpu_local_time_first_message)) {
-    return false;
-  }
-  esf_state->last_imu_time_msss = imu_time_msss;
+  const u32 reference_tss_flags = (1 << 30);
 
-  struct sbp_imuraw_timespec timespec =
-      convert_tow_to_imuraw_time(imu_time_msss.tow);
-  msg->tow = timespec.tow;
-  msg->tow_f = timespec.tow_f;
+  for (size_t i = 0; i < block->n_samples; i++) {
+    // The msss field contains only the time for the first IMU data packet of
+    // this burst - we derive subsequent timestamps by diffs on the sensor
+    // time. The sensor time has a wraparound at 24 bits that we need to
+    // handle.
+    s32 sensor_time_diff = block->time_tag[i] - sensortime_first_message;
+    while (sensor_time_diff < 0) {
+      sensor_time_diff += (1 << 24); /* unwrap 24 bit overflow */
+    }
 
-  const u32 reference_tss_flags = (1 << 30);
-  msg->tow |= reference_tss_flags;
-  return true;
+    double sensor_tss_s =
+        ubx_sensortime_scale * sensor_time_diff + first_msg_tss;
+    gps_time_t imu_time_msss;
+    imu_time_msss.tow = sensor_tss_s - ubx_imu_gnss_time_offset;
+    imu_time_msss.wn = 0;
+    if (!normalize_gps_time_safe(&imu_time_msss) ||
+        !gps_time_match_weeks_safe(&imu_time_msss,
+                                   &cpu_local_time_first_message)) {
+      /* nothing from this sample onwards is converted */
+      block->n_samples = i;
+      return;
+    }
+    esf_state->last_imu_time_msss = imu_time_msss;
+
+    struct sbp_imuraw_timespec timespec =
+        convert_tow_to_imuraw_time(imu_time_msss.tow);
+    block->tow[i] = timespec.tow | reference_tss_flags;
+    block->tow_f[i] = timespec.tow_f;
+  }
 }
 
 static bool check_imu_message_complete(const s16 *received_number_msgs,
@@ -856,9 +884,9 @@ static bool check_imu_message_complete(const s16 *received_number_msgs,
               current_msg_number + 1);
 }
 
-static void send_imu_aux(struct ubx_sbp_state *state) {
-  sbp_msg_t sbp_msg;
-  sbp_msg_imu_aux_t *msg = &sbp_msg.imu_aux;
+static void fill_imu_aux(double temperature,
+                         bool temperature_set,
+                         sbp_msg_imu_aux_t *msg) {
   memset(msg, 0, sizeof(*msg));
   const u8 imu_type_bmi160 = 0;
   msg->imu_type = imu_type_bmi160;
@@ -868,16 +896,12 @@ static void send_imu_aux(struct ubx_sbp_state *state) {
   /* Convert the IMU temperature to BMI160 format, see
    * https://ae-bst.resource.bosch.com/media/_tech/media/datasheets/BST-BMI160-DS000.pdf,
    * section 2.11.8 */
-  if (!state->esf_state.temperature_set) {
+  if (!temperature_set) {
     const int16_t kTemperatureInvalid = (int16_t)0x8000;
     msg->temp = kTemperatureInvalid;
   } else {
-    msg->temp =
-        ubx_convert_temperature_to_bmi160(state->esf_state.last_imu_temp);
+    msg->temp = ubx_convert_temperature_to_bmi160(temperature);
   }
-
-  state->cb_ubx_to_sbp(
-      state->sender_id, SbpMsgImuAux, &sbp_msg, state->context);
 }
 
 static bool is_imu_data(u8 data_type) {
@@ -927,35 +951,30 @@ static bool are_imu_timestamps_consistent(const ubx_esf_raw *esf_raw) {
   return true;
 }
 
-static void handle_esf_raw(struct ubx_sbp_state *state,
-                           swiftnav_bytestream_t *inbuf) {
-  ubx_esf_raw esf_raw;
-  sbp_msg_t sbp_msg;
-  sbp_msg_imu_raw_t *msg = &sbp_msg.imu_raw;
-  memset(msg, 0, sizeof(*msg));
-  if (ubx_decode_esf_raw_bytestream(inbuf, &esf_raw) != RC_OK) {
-    return;
-  }
-
-  // If timestamps in this message are inconsistent, it's better not to convert
-  // this message at all
-  if (!are_imu_timestamps_consistent(&esf_raw)) {
-    return;
-  }
-
-  u8 num_raw = get_esf_raw_num_msgs(&esf_raw);
+/* Gathers the IMU samples of the frame into `block`, stopping at the first
+ * sample which breaks the per axis ordering. Temperature samples are tracked
+ * along the way but only stored in the state once the block has been
+ * timestamped, see commit_esf_raw_temp(). Returns false if the frame must be
+ * dropped as a whole. */
+static bool collect_esf_raw_imu_block(struct ubx_sbp_state *state,
+                                      const ubx_esf_raw *esf_raw,
+                                      struct esf_raw_imu_block *block) {
+  u8 num_raw = get_esf_raw_num_msgs(esf_raw);
 
   const size_t MAX_MESSAGES = ESF_Z_AXIS_ACCEL_SPECIFIC_FORCE + 1;
   s16 received_number_msgs[MAX_MESSAGES];
   memset(received_number_msgs, 0, sizeof(s16) * MAX_MESSAGES);
   s16 current_msg_number = 0;
+  block->n_samples = 0;
+  block->end_temp = state->esf_state.last_imu_temp;
+  block->end_temp_set = state->esf_state.temperature_set;
   for (int i = 0; i < num_raw; i++) {
-    u8 data_type = get_esf_raw_data_type(esf_raw.data[i]);
-    s32 parsed_value = get_esf_raw_parsed_data(esf_raw.data[i]);
+    u8 data_type = get_esf_raw_data_type(esf_raw->data[i]);
+    s32 parsed_value = get_esf_raw_parsed_data(esf_raw->data[i]);
     if (data_type == ESF_GYRO_TEMP) {
       const double ubx_scale_temp = 0.01;
-      state->esf_state.last_imu_temp = ubx_scale_temp * parsed_value;
-      state->esf_state.temperature_set = true;
+      block->end_temp = ubx_scale_temp * parsed_value;
+      block->end_temp_set = true;
     }
 
     if (!is_imu_data(data_type)) {
@@ -967,54 +986,143 @@ static void handle_esf_raw(struct ubx_sbp_state *state,
     // the state object and would cause wrap around and errors down
     // the processing chain
     if ((state->esf_state.running_imu_msss != -1) &&
-        (esf_raw.msss - state->esf_state.last_imu_msss) > 1000) {
+        (esf_raw->msss - state->esf_state.last_imu_msss) > 1000) {
+      state->esf_state.last_imu_temp = block->end_temp;
+      state->esf_state.temperature_set = block->end_temp_set;
       reset_esf_state(&state->esf_state);
       // The first packet after a reset appears to contain bad data so just drop
       // it, the next packet to arrive should be valid
-      return;
+      return false;
     }
 
     if (state->esf_state.running_imu_msss == -1) {
-      state->esf_state.running_imu_msss = esf_raw.msss;
+      state->esf_state.running_imu_msss = esf_raw->msss;
     } else {
       state->esf_state.running_imu_msss +=
-          esf_raw.msss - state->esf_state.last_imu_msss;
+          esf_raw->msss - state->esf_state.last_imu_msss;
     }
-    state->esf_state.last_imu_msss = esf_raw.msss;
+    state->esf_state.last_imu_msss = esf_raw->msss;
 
-    if (!set_sbp_imu_time(esf_raw.sensor_time_tag[i],
-                          esf_raw.sensor_time_tag[0],
-                          state->esf_state.running_imu_msss,
-                          msg,
-                          &state->esf_state)) {
-      return;
-    }
-    maybe_parse_imu_data(parsed_value, data_type, msg);
+    size_t n = block->n_samples++;
+    block->data_type[n] = data_type;
+    block->value[n] = parsed_value;
+    block->time_tag[n] = esf_raw->sensor_time_tag[i];
+    block->completes_msg[n] = false;
+    block->temp[n] = block->end_temp;
+    block->temp_set[n] = block->end_temp_set;
 
     received_number_msgs[data_type]++;
     // Before getting the next sample for an axis, we expect to receive all
-    // other axes for the same timestamp.
-    if (!(data_type == ESF_GYRO_TEMP ||
-          received_number_msgs[data_type] == current_msg_number + 1)) {
+    // other axes for the same timestamp. The offending sample is still
+    // timestamped, it just never completes a message.
+    if (received_number_msgs[data_type] != current_msg_number + 1) {
       log_warn("Lost IMU data, possibly corrupted ESF-RAW frame");
-      return;
+      return true;
     }
 
-    // Check if the current IMU message is complete (all axes received) and
-    // output an SBP message if it is.
+    // Check if the current IMU message is complete (all axes received).
     if (check_imu_message_complete(received_number_msgs, current_msg_number)) {
-      if (state->esf_state.imu_raw_msgs_sent % 20 == 0) {
-        send_imu_aux(state);
-        state->esf_state.imu_raw_msgs_sent = 0;
-      }
-      state->cb_ubx_to_sbp(
-          state->sender_id, SbpMsgImuRaw, &sbp_msg, state->context);
+      block->completes_msg[n] = true;
       current_msg_number++;
-      state->esf_state.imu_raw_msgs_sent++;
     }
   }
+  return true;
 }
 
+/* Stores the gyro temperature which was current when the conversion of the
+ * block stopped: at the first sample which couldn't be timestamped, if any,
+ * otherwise at the end of the frame. */
+static void commit_esf_raw_temp(struct ubx_esf_state *esf_state,
+                                const struct esf_raw_imu_block *block,
+                                size_t n_collected) {
+  if (block->n_samples < n_collected) {
+    esf_state->last_imu_temp = block->temp[block->n_samples];
+    esf_state->temperature_set = block->temp_set[block->n_samples];
+  } else {
+    esf_state->last_imu_temp = block->end_temp;
+    esf_state->temperature_set = block->end_temp_set;
+  }
+}
+
+size_t ubx_convert_esf_raw(struct ubx_sbp_state *state,
+                           swiftnav_bytestream_t *frame,
+                           struct ubx_sbp_imu_msg *msgs,
+                           size_t max_msgs) {
+  ubx_esf_raw esf_raw;
+  if (ubx_decode_esf_raw_bytestream(frame, &esf_raw) != RC_OK) {
+    return 0;
+  }
+
+  // If timestamps in this message are inconsistent, it's better not to convert
+  // this message at all
+  if (!are_imu_timestamps_consistent(&esf_raw)) {
+    return 0;
+  }
+
+  struct esf_raw_imu_block block;
+  if (!collect_esf_raw_imu_block(state, &esf_raw, &block)) {
+    return 0;
+  }
+
+  size_t n_collected = block.n_samples;
+  if (n_collected > 0) {
+    set_esf_raw_imu_times(&block,
+                          esf_raw.sensor_time_tag[0],
+                          state->esf_state.running_imu_msss,
+                          &state->esf_state);
+  }
+  commit_esf_raw_temp(&state->esf_state, &block, n_collected);
+
+  sbp_msg_imu_raw_t msg;
+  memset(&msg, 0, sizeof(msg));
+  size_t n_msgs = 0;
+  for (size_t i = 0; i < block.n_samples; i++) {
+    maybe_parse_imu_data(block.value[i], block.data_type[i], &msg);
+    if (!block.completes_msg[i]) {
+      continue;
+    }
+
+    msg.tow = block.tow[i];
+    msg.tow_f = block.tow_f[i];
+
+    bool send_aux = state->esf_state.imu_raw_msgs_sent % 20 == 0;
+    if (n_msgs + (send_aux ? 2 : 1) > max_msgs) {
+      break;
+    }
+    if (send_aux) {
+      msgs[n_msgs].msg_type = SbpMsgImuAux;
+      fill_imu_aux(
+          block.temp[i], block.temp_set[i], &msgs[n_msgs].msg.imu_aux);
+      n_msgs++;
+      state->esf_state.imu_raw_msgs_sent = 0;
+    }
+    msgs[n_msgs].msg_type = SbpMsgImuRaw;
+    msgs[n_msgs].msg.imu_raw = msg;
+    n_msgs++;
+    state->esf_state.imu_raw_msgs_sent++;
+  }
+  return n_msgs;
+}
+
+static void handle_esf_raw(struct ubx_sbp_state *state,
+                           swiftnav_bytestream_t *inbuf) {
+  struct ubx_sbp_imu_msg msgs[UBX_ESF_RAW_MAX_SBP_MSGS];
+  size_t n_msgs = ubx_convert_esf_raw(state, inbuf, msgs, ARRAY_SIZE(msgs));
+
+  sbp_msg_t sbp_msg;
+  for (size_t i = 0; i < n_msgs; i++) {
+    if (msgs[i].msg_type == SbpMsgImuAux) {
+      sbp_msg.imu_aux = msgs[i].msg.imu_aux;
+    } else {
+      sbp_msg.imu_raw = msgs[i].msg.imu_raw;
+    }
+    state->cb_ubx_to_sbp(
+        state->sender_id, msgs[i].msg_type, &sbp_msg, state->context);
+  }
+}
+#endif
+
+#ifndef UBX_DISABLE_HNR_PVT
 static void handle_hnr_pvt(struct ubx_sbp_state *state,
                            swiftnav_bytestream_t *inbuf) {
   ubx_hnr_pvt hnr_pvt;
@@ -1026,7 +1134,7 @@ static void handle_hnr_pvt(struct ubx_sbp_state *state,
     return;
   }
 
-  fill_msg_pos_llh_hnr(&hnr_pvt, sbp_pos_llh);
+  fill_msg_pos_llh_hnr(&hnr_pvt, &state->pvt_state, sbp_pos_llh);
   state->last_tow_ms = sbp_pos_llh->tow;
 
   sbp_orient_euler->tow = hnr_pvt.i_tow;
@@ -1040,12 +1148,14 @@ static void handle_hnr_pvt(struct ubx_sbp_state *state,
         state->sender_id, SbpMsgOrientEuler, &orient_msg, state->context);
   }
 }
+#endif
 
+#ifndef UBX_DISABLE_NAV_ATT
 static void handle_nav_att(struct ubx_sbp_state *state,
                            swiftnav_bytestream_t *inbuf) {
   sbp_msg_t msg;
   sbp_msg_orient_euler_t *sbp_orient_euler = &msg.orient_euler;
-  if (fill_msg_orient_euler(inbuf, sbp_orient_euler) == 0) {
+  if (fill_msg_orient_euler(inbuf, &state->pvt_state, sbp_orient_euler) == 0) {
     memcpy(&state->last_orient_euler,
            sbp_orient_euler,
            sizeof(sbp_msg_orient_euler_t));
@@ -1055,12 +1165,14 @@ static void handle_nav_att(struct ubx_sbp_state *state,
     }
   }
 }
+#endif
 
+#ifndef UBX_DISABLE_NAV_PVT
 static void handle_nav_pvt(struct ubx_sbp_state *state,
                            swiftnav_bytestream_t *inbuf) {
   sbp_msg_t msg;
   sbp_msg_pos_llh_t *sbp_pos_llh = &msg.pos_llh;
-  if (fill_msg_pos_llh(inbuf, sbp_pos_llh) == 0) {
+  if (fill_msg_pos_llh(inbuf, &state->pvt_state, sbp_pos_llh) == 0) {
     state->last_tow_ms = sbp_pos_llh->tow;
     if (!state->use_hnr) {
       state->cb_ubx_to_sbp(
@@ -1068,16 +1180,20 @@ static void handle_nav_pvt(struct ubx_sbp_state *state,
     }
   }
 }
+#endif
 
+#ifndef UBX_DISABLE_NAV_VELECEF
 static void handle_nav_velecef(struct ubx_sbp_state *state,
                                swiftnav_bytestream_t *inbuf) {
   sbp_msg_t msg;
   sbp_msg_vel_ecef_t *sbp_vel_ecef = &msg.vel_ecef;
-  if (fill_msg_vel_ecef(inbuf, sbp_vel_ecef) == 0) {
+  if (fill_msg_vel_ecef(inbuf, &state->pvt_state, sbp_vel_ecef) == 0) {
     state->cb_ubx_to_sbp(state->sender_id, SbpMsgVelEcef, &msg, state->context);
   }
 }
+#endif
 
+#ifndef UBX_DISABLE_NAV_SAT
 static void handle_nav_sat(struct ubx_sbp_state *state,
                            swiftnav_bytestream_t *inbuf) {
   ubx_nav_sat nav_sat; /* 1218 bytes (ish) ! */
@@ -1106,7 +1222,7 @@ static void handle_nav_sat(struct ubx_sbp_state *state,
     ubx_nav_sat_data *data = &nav_sat.data[i];
 
     u8 sat_id = data->sv_id;
-    u8 code = convert_ubx_gnssid_sigid(data->gnss_id,
+    u8 code = ubx_convert_gnssid_sigid(data->gnss_id,
                                        0); /* always zero for UBX-NAV-SAT */
 
     msg_az_el->azel[msg_az_el->n_azel].sid.sat = sat_id;
@@ -1152,7 +1268,9 @@ static void handle_nav_sat(struct ubx_sbp_state *state,
                          state->context);
   }
 }
+#endif
 
+#ifndef UBX_DISABLE_NAV_STATUS
 static void handle_nav_status(struct ubx_sbp_state *state,
                               swiftnav_bytestream_t *inbuf) {
   ubx_nav_status nav_status;
@@ -1216,9 +1334,11 @@ static void handle_nav_status(struct ubx_sbp_state *state,
     }
   }
 }
+#endif
 
+#ifndef UBX_DISABLE_RXM_RAWX
 static void update_utc_params(struct ubx_sbp_state *state,
-                              const ubx_rxm_rawx *rxm_rawx) {
+                              const ubx_rxm_rawx_header *rxm_rawx) {
   if ((rxm_rawx->rec_status & 1U) == 1) {
     state->leap_second_known = true;
     /* create a dummy utc_params struct for glo2gps time conversion */
@@ -1242,10 +1362,12 @@ static void update_utc_params(struct ubx_sbp_state *state,
   }
 }
 
+/* Converts the measurement records one by one straight from the frame into
+ * the slots of the outgoing SBP message, sending it whenever it fills up */
 static void handle_rxm_rawx(struct ubx_sbp_state *state,
                             swiftnav_bytestream_t *inbuf) {
-  ubx_rxm_rawx rxm_rawx;
-  if (ubx_decode_rxm_rawx_bytestream(inbuf, &rxm_rawx) != RC_OK) {
+  ubx_rxm_rawx_header rxm_rawx;
+  if (ubx_decode_rxm_rawx_header_bytestream(inbuf, &rxm_rawx) != RC_OK) {
     return;
   }
 
@@ -1257,49 +1379,56 @@ static void handle_rxm_rawx(struct ubx_sbp_state *state,
   update_utc_params(state, &rxm_rawx);
 
   sbp_v4_gps_time_t obs_time;
-  uint8_t n_obs;
-  sbp_packed_obs_content_t sbp_obs[UBX_MAX_NUM_OBS];
-  if (fill_msg_obs(&rxm_rawx, &obs_time, &n_obs, sbp_obs) == 0) {
-    u8 total_messages;
-    if (n_obs > 0) {
-      total_messages = 1 + ((n_obs - 1) / SBP_MAX_NUM_OBS);
-    } else {
-      total_messages = 1;
-    }
+  fill_obs_time(&rxm_rawx, &obs_time);
 
-    sbp_msg_t msg;
-    sbp_msg_obs_t *sbp_obs_to_send = &msg.obs;
-    sbp_obs_to_send->header.t = obs_time;
+  u8 n_obs = rxm_rawx.num_meas;
+  u8 total_messages;
+  if (n_obs > 0) {
+    total_messages = 1 + ((n_obs - 1) / SBP_MAX_NUM_OBS);
+  } else {
+    total_messages = 1;
+  }
 
-    if (state->observation_time_estimator != NULL) {
-      time_truth_observation_estimator_push(state->observation_time_estimator,
-                                            obs_time.tow);
-    }
+  sbp_msg_t msg;
+  sbp_msg_obs_t *sbp_obs_to_send = &msg.obs;
+  sbp_obs_to_send->header.t = obs_time;
 
-    u8 obs_index;
-    for (u8 msg_num = 0; msg_num < total_messages; msg_num++) {
-      sbp_obs_to_send->header.n_obs = (total_messages << 4) + msg_num;
-      for (obs_index = 0; obs_index < SBP_MAX_NUM_OBS &&
-                          (obs_index + msg_num * SBP_MAX_NUM_OBS) < n_obs;
-           obs_index++) {
-        sbp_obs_to_send->obs[obs_index] =
-            sbp_obs[obs_index + msg_num * SBP_MAX_NUM_OBS];
-      }
+  if (state->observation_time_estimator != NULL) {
+    time_truth_observation_estimator_push(state->observation_time_estimator,
+                                          obs_time.tow);
+  }
 
-      sbp_obs_to_send->n_obs = obs_index;
+  u8 msg_num = 0;
+  sbp_obs_to_send->n_obs = 0;
+  for (u16 i = 0; i < n_obs; i++) {
+    /* The header decode made sure that every record is present */
+    ubx_rxm_rawx_meas meas;
+    if (ubx_decode_rxm_rawx_meas_bytestream(inbuf, &meas) != RC_OK) {
+      return;
+    }
+    fill_packed_obs(&meas, &sbp_obs_to_send->obs[sbp_obs_to_send->n_obs]);
+    sbp_obs_to_send->n_obs++;
 
+    if (sbp_obs_to_send->n_obs == SBP_MAX_NUM_OBS || i + 1 == n_obs) {
+      sbp_obs_to_send->header.n_obs = (total_messages << 4) + msg_num;
       state->cb_ubx_to_sbp(state->sender_id, SbpMsgObs, &msg, state->context);
+      sbp_obs_to_send->n_obs = 0;
+      msg_num++;
     }
   }
+
+  if (n_obs == 0) {
+    sbp_obs_to_send->header.n_obs = (total_messages << 4);
+    state->cb_ubx_to_sbp(state->sender_id, SbpMsgObs, &msg, state->context);
+  }
 }
+#endif
 
+#ifndef UBX_DISABLE_RXM_SFRBX
 static void handle_rxm_sfrbx(struct ubx_sbp_state *state,
-                             swiftnav_bytestream_t *buf,
-                             int sz) {
-  (void)sz;
+                             swiftnav_bytestream_t *buf) {
   assert(state);
   assert(buf);
-  assert(sz > 0);
   ubx_rxm_sfrbx sfrbx;
   if (ubx_decode_rxm_sfrbx_bytestream(buf, &sfrbx) != RC_OK) {
     return;
@@ -1340,7 +1469,9 @@ static void handle_rxm_sfrbx(struct ubx_sbp_state *state,
                          state->cb_ubx_to_sbp);
   }
 }
+#endif
 
+#ifndef UBX_DISABLE_MON_HW
 static void handle_mon_hw(struct ubx_sbp_state *state,
                           swiftnav_bytestream_t *inbuf) {
   sbp_msg_t sbp_msg;
@@ -1350,6 +1481,52 @@ static void handle_mon_hw(struct ubx_sbp_state *state,
     state->cb_ubx_to_sbp(state->sender_id, SbpMsgFwd, &sbp_msg, state->context);
   }
 }
+#endif
+
+/* UBX messages converted to SBP. Decoded messages reuse the entries of
+ * UBX_MESSAGE_LIST, so they are compiled out along with the rest of libubx's
+ * support for them. Each entry is handled by handle_<name>(). */
+#ifndef UBX_DISABLE_MON_HW
+#define UBX_SBP_ENTRY_MON_HW(X) X(MON, HW, mon_hw)
+#else
+#define UBX_SBP_ENTRY_MON_HW(X)
+#endif
+
+#define UBX_SBP_HANDLER_LIST(X)    \
+  UBX_MESSAGE_ENTRY_ESF_RAW(X)     \
+  UBX_MESSAGE_ENTRY_ESF_MEAS(X)    \
+  UBX_MESSAGE_ENTRY_HNR_PVT(X)     \
+  UBX_MESSAGE_ENTRY_NAV_ATT(X)     \
+  UBX_MESSAGE_ENTRY_NAV_PVT(X)     \
+  UBX_MESSAGE_ENTRY_NAV_VELECEF(X) \
+  UBX_MESSAGE_ENTRY_NAV_SAT(X)     \
+  UBX_MESSAGE_ENTRY_NAV_STATUS(X)  \
+  UBX_MESSAGE_ENTRY_RXM_RAWX(X)    \
+  UBX_MESSAGE_ENTRY_RXM_SFRBX(X)   \
+  UBX_SBP_ENTRY_MON_HW(X)
+
+/* The handlers live in a small open addressed table, the slot function is
+ * collision free for every (class, id) pair of UBX_SBP_HANDLER_LIST. Should
+ * a new entry collide, the duplicate designated initializer is reported by
+ * -Woverride-init and the multiplier needs to be changed. */
+#define UBX_HANDLER_TABLE_SIZE 32
+#define UBX_HANDLER_SLOT(class_id, msg_id) \
+  ((((class_id)*6u) + (msg_id)) & (UBX_HANDLER_TABLE_SIZE - 1u))
+
+struct ubx_handler {
+  u16 key;
+  void (*handle)(struct ubx_sbp_state *state, swiftnav_bytestream_t *frame);
+};
+
+#define UBX_HANDLER_ENTRY(CLASS, MSG, name)                             \
+  [UBX_HANDLER_SLOT(UBX_CLASS_##CLASS, UBX_MSG_##CLASS##_##MSG)] = {    \
+      UBX_MESSAGE_KEY(UBX_CLASS_##CLASS, UBX_MSG_##CLASS##_##MSG),      \
+      handle_##name},
+
+static const struct ubx_handler ubx_handlers[UBX_HANDLER_TABLE_SIZE] = {
+    UBX_SBP_HANDLER_LIST(UBX_HANDLER_ENTRY)};
+
+#undef UBX_HANDLER_ENTRY
 
 void ubx_handle_frame(swiftnav_bytestream_t *frame,
                       struct ubx_sbp_state *state) {
@@ -1359,67 +1536,11 @@ void ubx_handle_frame(swiftnav_bytestream_t *frame,
   u8 class_id = frame->data[0];
   u8 msg_id = frame->data[1];
 
-  switch (class_id) {
-    case UBX_CLASS_ESF:
-      switch (msg_id) {
-        case UBX_MSG_ESF_RAW:
-          handle_esf_raw(state, frame);
-          break;
-        case UBX_MSG_ESF_MEAS:
-          handle_esf_meas(state, frame);
-          break;
-        default:
-          break;
-      }
-      break;
-
-    case UBX_CLASS_HNR:
-      if (msg_id == UBX_MSG_HNR_PVT) {
-        handle_hnr_pvt(state, frame);
-      }
-      break;
-
-    case UBX_CLASS_NAV:
-      switch (msg_id) {
-        case UBX_MSG_NAV_ATT:
-          handle_nav_att(state, frame);
-          break;
-        case UBX_MSG_NAV_PVT:
-          handle_nav_pvt(state, frame);
-          break;
-        case UBX_MSG_NAV_VELECEF:
-          handle_nav_velecef(state, frame);
-          break;
-        case UBX_MSG_NAV_SAT:
-          handle_nav_sat(state, frame);
-          break;
-        case UBX_MSG_NAV_STATUS:
-          handle_nav_status(state, frame);
-          break;
-        default:
-          break;
-      }
-      break;
-
-    case UBX_CLASS_RXM:
-      if (msg_id == UBX_MSG_RXM_RAWX) {
-        handle_rxm_rawx(state, frame);
-      } else if (msg_id == UBX_MSG_RXM_SFRBX) {
-        handle_rxm_sfrbx(state, frame, UBX_FRAME_SIZE);
-      }
-      break;
-
-    case UBX_CLASS_MON:
-      switch (msg_id) {
-        case UBX_MSG_MON_HW:
-          handle_mon_hw(state, frame);
-          break;
-        default:
-          break;
-      }
-      break;
-    default:
-      break;
+  const struct ubx_handler *handler =
+      &ubx_handlers[UBX_HANDLER_SLOT(class_id, msg_id)];
+  if (handler->handle != NULL &&
+      handler->key == UBX_MESSAGE_KEY(class_id, msg_id)) {
+    handler->handle(state, frame);
   }
 }
 
@@ -1483,21 +1604,129 @@ void ubx_set_hnr_flag(struct ubx_sbp_state *state, bool use_hnr) {
 int ubx_sbp_process(struct ubx_sbp_state *state,
                     int (*read_stream_func)(u8 *buff, size_t len, void *ctx)) {
   state->read_stream_func = read_stream_func;
-  u8 inbuf[UBX_FRAME_SIZE];
 
-  ssize_t ret = read_ubx_frame(inbuf, state);
+  /* The frame is a view into state->read_buffer, nothing may refill the
+   * buffer until it has been handled */
+  swiftnav_bytestream_t bytestream;
+  int ret = read_ubx_frame(&bytestream, state);
   if (ret <= 0) {
     return ret;
   }
 
-  swiftnav_bytestream_t bytestream;
-  swiftnav_bytestream_init(&bytestream, inbuf, ret);
-
   ubx_handle_frame(&bytestream, state);
 
   return ret;
 }
 
+/* Finds the next complete frame with a valid checksum, starting the search at
+ * data[index]. Returns the offset of its sync bytes and stores the length of
+ * its class, id, length and payload fields in frame_length. If there is no
+ * such frame frame_length is set to 0 and the offset at which the search
+ * stopped is returned, either length or the start of a truncated frame. */
+static size_t ubx_find_frame(const u8 *data,
+                             size_t length,
+                             size_t index,
+                             size_t *frame_length) {
+  const size_t header_length = UBX_CLASS_BYTE_COUNT + UBX_MSG_ID_BYTE_COUNT +
+                               UBX_LENGTH_BYTE_COUNT;
+  *frame_length = 0;
+  while (index < length) {
+    const u8 *sync = memchr(&data[index], UBX_SYNC_CHAR_1, length - index);
+    if (sync == NULL) {
+      return length;
+    }
+    index = (size_t)(sync - data);
+    if (length - index < UBX_SYNC_BYTE_COUNT + header_length) {
+      return index;
+    }
+    if (data[index + 1] != UBX_SYNC_CHAR_2) {
+      index++;
+      continue;
+    }
+
+    /* A rejected frame resumes the scan at its class byte */
+    const u8 *header = &data[index + UBX_SYNC_BYTE_COUNT];
+    u16 payload_length = header[2] + (header[3] << 8);
+    if (payload_length > UBX_FRAME_SIZE - 6) {
+      log_warn(
+          "UBX payload_length for class 0x%X and ID 0x%X too large: %d; "
+          "possible corrupted frame",
+          header[0],
+          header[1],
+          payload_length);
+      index += UBX_SYNC_BYTE_COUNT;
+      continue;
+    }
+
+    size_t candidate_length = header_length + payload_length;
+    if (length - index - UBX_SYNC_BYTE_COUNT <
+        candidate_length + UBX_CHECKSUM_BYTE_COUNT) {
+      return index;
+    }
+
+#ifndef GNSS_CONVERTERS_DISABLE_CRC_VALIDATION
+    u8 checksum[2];
+    ubx_checksum(header, candidate_length, checksum);
+    if (memcmp(checksum, header + candidate_length, 2) != 0) {
+      index += UBX_SYNC_BYTE_COUNT;
+      continue;
+    }
+#endif
+
+    *frame_length = candidate_length;
+    return index;
+  }
+  return length;
+}
+
+/**
+ * Converts the UBX frames held in a contiguous block of memory, e.g. a memory
+ * mapped log file. Frames are validated and handled in place, the converter's
+ * read buffer and read_stream_func are not used. Framing follows
+ * ubx_sbp_process(), so both produce the same output for the same input.
+ *
+ * @param state An already populated state object
+ * @param data Start of the UBX data
+ * @param length Number of bytes at `data`
+ * @return Number of bytes consumed, anything past that is the start of an
+ * incomplete frame.
+ */
+size_t ubx_sbp_process_buffer(struct ubx_sbp_state *state,
+                              const u8 *data,
+                              size_t length) {
+  size_t index = 0;
+  for (;;) {
+    size_t frame_length;
+    index = ubx_find_frame(data, length, index, &frame_length);
+    if (frame_length == 0) {
+      return index;
+    }
+
+    swiftnav_bytestream_t frame;
+    swiftnav_bytestream_init(
+        &frame, &data[index + UBX_SYNC_BYTE_COUNT], (u32)frame_length);
+    ubx_handle_frame(&frame, state);
+    index += UBX_SYNC_BYTE_COUNT + frame_length + UBX_CHECKSUM_BYTE_COUNT;
+  }
+}
+
+/**
+ * Finds the first complete UBX frame with a valid checksum which starts at or
+ * after `offset`. Used to split a log into pieces which can be converted
+ * independently with ubx_sbp_process_buffer().
+ *
+ * @param data Start of the UBX data
+ * @param length Number of bytes at `data`
+ * @param offset Offset at which to start the search
+ * @return Offset of the frame's first sync byte, or `length` if there is no
+ * complete frame past `offset`.
+ */
+size_t ubx_sbp_frame_boundary(const u8 *data, size_t length, size_t offset) {
+  size_t frame_length;
+  size_t index = ubx_find_frame(data, length, offset, &frame_length);
+  return frame_length > 0 ? index : length;
+}
+
 void ubx_sbp_set_time_truth_estimators(
     struct ubx_sbp_state *state,
     ObservationTimeEstimator *observation_time_estimator,
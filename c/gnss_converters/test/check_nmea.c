@@ -358,31 +358,25 @@ void sbp_init(sbp_state_t *sbp_state, void *ctx) {
                         &observation_callback_node);
 }
 
-void test_NMEA(const char *filename,
-               void (*cb_sbp_to_nmea)(char msg[], void *ctx)) {
-  memset(&msg_count, 0, sizeof(msg_count));
-  memset(&start_count, 0, sizeof(start_count));
-
-  sbp2nmea_t state;
-  memset(&state, 0, sizeof(state));
-
-  sbp2nmea_init(&state, SBP2NMEA_MODE_GNSS, cb_sbp_to_nmea, NULL);
-  sbp2nmea_base_id_set(&state, 33);
-  sbp2nmea_soln_freq_set(&state, 10);
-  sbp2nmea_rate_set(&state, 1, SBP2NMEA_NMEA_GGA);
-  sbp2nmea_rate_set(&state, 10, SBP2NMEA_NMEA_RMC);
-  sbp2nmea_rate_set(&state, 10, SBP2NMEA_NMEA_VTG);
-  /*sbp2nmea_rate_set(&state, 1, SBP2NMEA_NMEA_HDT);*/
-  sbp2nmea_rate_set(&state, 10, SBP2NMEA_NMEA_GLL);
-  sbp2nmea_rate_set(&state, 10, SBP2NMEA_NMEA_ZDA);
-  sbp2nmea_rate_set(&state, 1, SBP2NMEA_NMEA_GSA);
-  sbp2nmea_rate_set(&state, 1, SBP2NMEA_NMEA_GST);
-  sbp2nmea_rate_set(&state, 10, SBP2NMEA_NMEA_GSV);
-  sbp2nmea_cog_threshold_set(&state, cog_thd);
-  sbp2nmea_cog_stationary_threshold_set(&state, cog_stationary_thd);
-
+static void nmea_configure(sbp2nmea_t *state) {
+  sbp2nmea_base_id_set(state, 33);
+  sbp2nmea_soln_freq_set(state, 10);
+  sbp2nmea_rate_set(state, 1, SBP2NMEA_NMEA_GGA);
+  sbp2nmea_rate_set(state, 10, SBP2NMEA_NMEA_RMC);
+  sbp2nmea_rate_set(state, 10, SBP2NMEA_NMEA_VTG);
+  /*sbp2nmea_rate_set(state, 1, SBP2NMEA_NMEA_HDT);*/
+  sbp2nmea_rate_set(state, 10, SBP2NMEA_NMEA_GLL);
+  sbp2nmea_rate_set(state, 10, SBP2NMEA_NMEA_ZDA);
+  sbp2nmea_rate_set(state, 1, SBP2NMEA_NMEA_GSA);
+  sbp2nmea_rate_set(state, 1, SBP2NMEA_NMEA_GST);
+  sbp2nmea_rate_set(state, 10, SBP2NMEA_NMEA_GSV);
+  sbp2nmea_cog_threshold_set(state, cog_thd);
+  sbp2nmea_cog_stationary_threshold_set(state, cog_stationary_thd);
+}
+
+static void nmea_process_file(const char *filename, sbp2nmea_t *state) {
   sbp_state_t sbp_state_;
-  sbp_init(&sbp_state_, &state);
+  sbp_init(&sbp_state_, state);
 
   FILE *fp = fopen(filename, "rb");
   if (fp == NULL) {
@@ -394,7 +388,19 @@ void test_NMEA(const char *filename,
     sbp_process(&sbp_state_, &read_file);
   }
   fclose(fp);
-  return;
+}
+
+void test_NMEA(const char *filename,
+               void (*cb_sbp_to_nmea)(char msg[], void *ctx)) {
+  memset(&msg_count, 0, sizeof(msg_count));
+  memset(&start_count, 0, sizeof(start_count));
+
+  sbp2nmea_t state;
+  memset(&state, 0, sizeof(state));
+
+  sbp2nmea_init(&state, SBP2NMEA_MODE_GNSS, cb_sbp_to_nmea, NULL);
+  nmea_configure(&state);
+  nmea_process_file(filename, &state);
 }
 
 void nmea_setup_basic(void) { return; }
@@ -467,6 +473,71 @@ START_TEST(test_nmea_gpgsv) {
 }
 END_TEST
 
+/* Streams are compared by length and FNV-1a hash */
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+typedef struct {
+  uint64_t hash;
+  size_t len;
+  size_t chunks;
+} nmea_stream_t;
+
+static nmea_stream_t sentence_stream;
+static nmea_stream_t block_stream;
+
+static void nmea_stream_append(nmea_stream_t *stream,
+                               const char *buf,
+                               size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    stream->hash = (stream->hash ^ (uint8_t)buf[i]) * FNV_PRIME;
+  }
+  stream->len += len;
+  stream->chunks++;
+}
+
+static void nmea_callback_sentence(char msg[], void *ctx) {
+  nmea_stream_append((nmea_stream_t *)ctx, msg, strlen(msg));
+}
+
+static void nmea_callback_block(const char *buf, size_t len, void *ctx) {
+  /* a block only ever holds complete sentences */
+  ck_assert_uint_ge(len, 2);
+  ck_assert_int_eq(buf[0], '$');
+  ck_assert_int_eq(buf[len - 2], '\r');
+  ck_assert_int_eq(buf[len - 1], '\n');
+  nmea_stream_append((nmea_stream_t *)ctx, buf, len);
+}
+
+START_TEST(test_nmea_epoch_block) {
+  static sbp2nmea_t state;
+
+  memset(&sentence_stream, 0, sizeof(sentence_stream));
+  sentence_stream.hash = FNV_OFFSET_BASIS;
+  memset(&state, 0, sizeof(state));
+  sbp2nmea_init(
+      &state, SBP2NMEA_MODE_GNSS, nmea_callback_sentence, &sentence_stream);
+  nmea_configure(&state);
+  nmea_process_file(RELATIVE_PATH_PREFIX "/data/nmea.sbp", &state);
+
+  memset(&block_stream, 0, sizeof(block_stream));
+  block_stream.hash = FNV_OFFSET_BASIS;
+  memset(&state, 0, sizeof(state));
+  sbp2nmea_init_buf(
+      &state, SBP2NMEA_MODE_GNSS, nmea_callback_block, &block_stream);
+  sbp2nmea_epoch_block_set(&state, true);
+  nmea_configure(&state);
+  nmea_process_file(RELATIVE_PATH_PREFIX "/data/nmea.sbp", &state);
+  sbp2nmea_flush(&state);
+
+  /* same byte stream, handed over in fewer and larger pieces */
+  ck_assert_uint_gt(sentence_stream.chunks, 0);
+  ck_assert_uint_eq(block_stream.len, sentence_stream.len);
+  ck_assert(block_stream.hash == sentence_stream.hash);
+  ck_assert_uint_lt(block_stream.chunks, sentence_stream.chunks);
+}
+END_TEST
+
 static bool check_utc_time_string(const sbp_msg_utc_time_t *msg_time,
                                   const char utc_time[],
                                   const char utc_timedate_trunc[],
@@ -599,6 +670,7 @@ Suite *nmea_suite(void) {
   tcase_add_test(tc_nmea, test_nmea_gsa);
   tcase_add_test(tc_nmea, test_nmea_gpgst);
   tcase_add_test(tc_nmea, test_nmea_gpgsv);
+  tcase_add_test(tc_nmea, test_nmea_epoch_block);
   tcase_add_test(tc_nmea, test_nmea_time_string);
   tcase_add_test(tc_nmea, test_check_nmea_rate);
   suite_add_tcase(s, tc_nmea);
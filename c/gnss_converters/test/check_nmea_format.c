@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2026 Swift Navigation Inc.
+ * Contact: Swift Navigation <dev@swiftnav.com>
+ *
+ * This source is subject to the license found in the file 'LICENSE' which must
+ * be be distributed together with this source. All other rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <check.h>
+#include <gnss-converters/internal/nmea_format.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "check_gnss_converters.h"
+
+#define FIELD_LEN 512
+
+static char buf[FIELD_LEN];
+static char expected[FIELD_LEN];
+
+static nmea_writer_t writer(void) {
+  memset(buf, 0x55, sizeof(buf));
+  nmea_writer_t w = {buf, buf + sizeof(buf), 0};
+  return w;
+}
+
+static void check_fixed(double value, uint8_t width, uint8_t decimals) {
+  nmea_writer_t w = writer();
+  nmea_format_fixed(&w, value, width, decimals);
+  int len =
+      snprintf(expected, sizeof(expected), "%0*.*f", width, decimals, value);
+  ck_assert_str_eq(buf, expected);
+  ck_assert_int_eq(w.ptr - buf, len);
+
+  uint8_t checksum = 0;
+  for (int i = 0; i < len; i++) {
+    checksum ^= (uint8_t)expected[i];
+  }
+  ck_assert_uint_eq(w.checksum, checksum);
+}
+
+START_TEST(test_nmea_format_int) {
+  const int32_t values[] = {0, 1, 7, 9, 10, 99, 100, 1023, -1, -9, -10, -99,
+                            INT32_MAX, INT32_MIN};
+  for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+    for (uint8_t width = 0; width < 5; width++) {
+      nmea_writer_t w = writer();
+      nmea_format_int(&w, values[i], width);
+      snprintf(expected, sizeof(expected), "%0*d", width, values[i]);
+      ck_assert_str_eq(buf, expected);
+
+      if (values[i] >= 0) {
+        w = writer();
+        nmea_format_uint(&w, (uint32_t)values[i], width);
+        ck_assert_str_eq(buf, expected);
+      }
+    }
+  }
+
+  nmea_writer_t w = writer();
+  nmea_format_uint(&w, UINT32_MAX, 2);
+  ck_assert_str_eq(buf, "4294967295");
+}
+END_TEST
+
+START_TEST(test_nmea_format_fixed) {
+  const double values[] = {0.0,     -0.0,     0.05,     0.15,   0.25,
+                           0.125,   2.675,    1.005,    -1.005, 359.95,
+                           9.995,   0.000001, 123.4567, -0.001, 1e14,
+                           1e300,   -1e300,   INFINITY, NAN,    -NAN};
+  for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+    for (uint8_t decimals = 0; decimals <= NMEA_FORMAT_MAX_DECIMALS;
+         decimals++) {
+      check_fixed(values[i], 0, decimals);
+      check_fixed(values[i], 10, decimals);
+    }
+  }
+
+  /* sweep over ties and near ties of the decimals used in the sentences */
+  for (int32_t i = -100000; i <= 100000; i++) {
+    check_fixed(i * 0.005, 0, 2);
+    check_fixed(i * 0.05, 0, 1);
+    check_fixed(nextafter(i * 0.0000005, 0), 0, 6);
+    check_fixed(i / 7.0, 0, 2);
+  }
+}
+END_TEST
+
+START_TEST(test_nmea_format_deg_min) {
+  const double values[] = {0.0,
+                           -0.0,
+                           15.9999999996,
+                           15.9999999994,
+                           -15.9999999996,
+                           37.7749295,
+                           -122.4194155,
+                           179.99999999,
+                           89.123456789};
+  for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+    double angle = fabs(round(values[i] * 1e8) / 1e8);
+    unsigned deg = (unsigned)angle;
+    snprintf(expected,
+             sizeof(expected),
+             "%03u%010.7f",
+             deg,
+             (angle - (double)deg) * 60.0);
+
+    nmea_writer_t w = writer();
+    nmea_format_deg_min(&w, values[i], 3);
+    ck_assert_str_eq(buf, expected);
+  }
+
+  nmea_writer_t w = writer();
+  nmea_format_deg_min(&w, 15.9999999996, 2);
+  ck_assert_str_eq(buf, "1600.0000000");
+}
+END_TEST
+
+START_TEST(test_nmea_format_truncation) {
+  char small[8];
+  nmea_writer_t w = {small, small + sizeof(small), 0};
+
+  nmea_format_str(&w, "$GP");
+  nmea_format_fixed(&w, 123.456, 0, 2);
+  ck_assert_str_eq(small, "$GP123.");
+  ck_assert_ptr_eq(w.ptr, small + sizeof(small));
+  /* only the bytes which made it into the buffer are folded in */
+  ck_assert_uint_eq(w.checksum, '$' ^ 'G' ^ 'P' ^ '1' ^ '2' ^ '3' ^ '.');
+
+  /* a full buffer stays untouched */
+  nmea_format_char(&w, ',');
+  nmea_format_uint(&w, 42, 0);
+  ck_assert_str_eq(small, "$GP123.");
+  ck_assert_ptr_eq(w.ptr, small + sizeof(small));
+}
+END_TEST
+
+Suite *nmea_format_suite(void) {
+  Suite *s = suite_create("NMEA format");
+
+  TCase *tc_format = tcase_create("NMEA format");
+  tcase_add_test(tc_format, test_nmea_format_int);
+  tcase_add_test(tc_format, test_nmea_format_fixed);
+  tcase_add_test(tc_format, test_nmea_format_deg_min);
+  tcase_add_test(tc_format, test_nmea_format_truncation);
+  suite_add_tcase(s, tc_format);
+
+  return s;
+}
@@ -16,6 +16,7 @@
 #include <math.h>
 #include <rtcm3/librtcm_utils.h>
 #include <rtcm3/messages.h>
+#include <string.h>
 
 #define FLOAT_EPS 1e-6
 
@@ -59,11 +60,41 @@ START_TEST(test_msm_glo_fcn_bias) {
 }
 END_TEST
 
+START_TEST(test_glo_fcn_band_bias) {
+  float code_bias[SBP_GLO_FCN_BIAS_BANDS];
+  float phase_bias[SBP_GLO_FCN_BIAS_BANDS];
+  memcpy(code_bias, sbp_glo_code_bias, sizeof(code_bias));
+  memcpy(phase_bias, sbp_glo_phase_bias, sizeof(phase_bias));
+
+  sbp_glo_code_bias[1] = 4.0f;
+  sbp_glo_phase_bias[0] = 0.5f;
+
+  ck_assert_int_eq(glo_fcn_bias_band(CODE_GLO_L1OF), 0);
+  ck_assert_int_eq(glo_fcn_bias_band(CODE_GLO_L2P), 1);
+  ck_assert_int_eq(glo_fcn_bias_band(CODE_GPS_L1CA), -1);
+
+  double code = 1.0;
+  double phase = 1.0;
+  glo_fcn_band_bias(1, MSM_GLO_FCN_OFFSET + 2, &code, &phase);
+  ck_assert(fabs(code - 8.0) < FLOAT_EPS);
+  glo_fcn_band_bias(0, MSM_GLO_FCN_OFFSET - 2, &code, &phase);
+  ck_assert(fabs(phase + 1.0) < FLOAT_EPS);
+  glo_fcn_band_bias(0, MSM_GLO_FCN_UNKNOWN, &code, &phase);
+  ck_assert(fabs(code) < FLOAT_EPS);
+  ck_assert(fabs(phase) < FLOAT_EPS);
+
+  /* the ratios are global, leave them as they were for the other tests */
+  memcpy(sbp_glo_code_bias, code_bias, sizeof(code_bias));
+  memcpy(sbp_glo_phase_bias, phase_bias, sizeof(phase_bias));
+}
+END_TEST
+
 Suite *options_suite(void) {
   Suite *s = suite_create("options");
 
   TCase *tc_options = tcase_create("options");
   tcase_add_test(tc_options, test_msm_glo_fcn_bias);
+  tcase_add_test(tc_options, test_glo_fcn_band_bias);
   suite_add_tcase(s, tc_options);
 
   return s;
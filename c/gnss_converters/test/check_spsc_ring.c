@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2026 Swift Navigation Inc.
+ * Contact: Swift Navigation <dev@swiftnav.com>
+ *
+ * This source is subject to the license found in the file 'LICENSE' which must
+ * be be distributed together with this source. All other rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <check.h>
+#include <gnss-converters/spsc_ring.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+
+#include "check_gnss_converters.h"
+
+#define RING_SIZE 64
+#define STREAM_LENGTH 100000
+
+static spsc_ring_t ring;
+static uint8_t storage[RING_SIZE];
+
+START_TEST(test_spsc_ring_init) {
+  ck_assert(!spsc_ring_init(&ring, storage, 0));
+  ck_assert(!spsc_ring_init(&ring, storage, 48));
+  ck_assert(spsc_ring_init(&ring, storage, RING_SIZE));
+  ck_assert_uint_eq(spsc_ring_occupancy(&ring), 0);
+  ck_assert_uint_eq(spsc_ring_dropped(&ring), 0);
+  ck_assert(!spsc_ring_drained(&ring));
+}
+END_TEST
+
+START_TEST(test_spsc_ring_wrap_and_drop) {
+  uint8_t in[RING_SIZE];
+  uint8_t out[RING_SIZE];
+  for (size_t i = 0; i < sizeof(in); i++) {
+    in[i] = (uint8_t)i;
+  }
+
+  ck_assert(spsc_ring_init(&ring, storage, RING_SIZE));
+
+  /* move the indices close to the end of the storage */
+  ck_assert_uint_eq(spsc_ring_write(&ring, in, 40), 40);
+  ck_assert_uint_eq(spsc_ring_read(&ring, out, 40), 40);
+
+  /* this chunk wraps around */
+  ck_assert_uint_eq(spsc_ring_write(&ring, in, 50), 50);
+  ck_assert_uint_eq(spsc_ring_occupancy(&ring), 50);
+
+  /* doesn't fit, is dropped in full */
+  ck_assert_uint_eq(spsc_ring_write(&ring, in, 20), 0);
+  ck_assert_uint_eq(spsc_ring_dropped(&ring), 20);
+  ck_assert_uint_eq(spsc_ring_occupancy(&ring), 50);
+
+  ck_assert_uint_eq(spsc_ring_read(&ring, out, sizeof(out)), 50);
+  for (size_t i = 0; i < 50; i++) {
+    ck_assert_uint_eq(out[i], in[i]);
+  }
+  ck_assert_uint_eq(spsc_ring_high_water(&ring), 50);
+
+  ck_assert(!spsc_ring_drained(&ring));
+  spsc_ring_close(&ring);
+  ck_assert(spsc_ring_drained(&ring));
+  ck_assert_uint_eq(spsc_ring_read(&ring, out, sizeof(out)), 0);
+}
+END_TEST
+
+static void *producer(void *arg) {
+  (void)arg;
+  uint8_t chunk[7];
+  size_t sent = 0;
+  while (sent < STREAM_LENGTH) {
+    size_t n = STREAM_LENGTH - sent < sizeof(chunk) ? STREAM_LENGTH - sent
+                                                    : sizeof(chunk);
+    for (size_t i = 0; i < n; i++) {
+      chunk[i] = (uint8_t)(sent + i);
+    }
+    /* lossless producer, retry until there is space */
+    while (spsc_ring_write(&ring, chunk, n) == 0) {
+      sched_yield();
+    }
+    sent += n;
+  }
+  spsc_ring_close(&ring);
+  return NULL;
+}
+
+START_TEST(test_spsc_ring_threaded) {
+  ck_assert(spsc_ring_init(&ring, storage, RING_SIZE));
+
+  pthread_t thread;
+  ck_assert_int_eq(pthread_create(&thread, NULL, producer, NULL), 0);
+
+  uint8_t out[13];
+  size_t received = 0;
+  while (!spsc_ring_drained(&ring)) {
+    size_t n = spsc_ring_read(&ring, out, sizeof(out));
+    for (size_t i = 0; i < n; i++) {
+      ck_assert_uint_eq(out[i], (uint8_t)(received + i));
+    }
+    received += n;
+    if (n == 0) {
+      sched_yield();
+    }
+  }
+  pthread_join(thread, NULL);
+
+  ck_assert_uint_eq(received, STREAM_LENGTH);
+  ck_assert_uint_le(spsc_ring_high_water(&ring), RING_SIZE);
+}
+END_TEST
+
+Suite *spsc_ring_suite(void) {
+  Suite *s = suite_create("SPSC ring");
+
+  TCase *tc_ring = tcase_create("SPSC ring");
+  tcase_add_test(tc_ring, test_spsc_ring_init);
+  tcase_add_test(tc_ring, test_spsc_ring_wrap_and_drop);
+  tcase_add_test(tc_ring, test_spsc_ring_threaded);
+  suite_add_tcase(s, tc_ring);
+
+  return s;
+}
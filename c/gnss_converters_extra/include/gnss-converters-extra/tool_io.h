@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2026 Swift Navigation Inc.
+ * Contact: Swift Navigation <dev@swiftnav.com>
+ *
+ * This source is subject to the license found in the file 'LICENSE' which must
+ * be be distributed together with this source. All other rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#ifndef GNSS_CONVERTERS_EXTRA_TOOL_IO_H
+#define GNSS_CONVERTERS_EXTRA_TOOL_IO_H
+
+#include <libsbp/sbp.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Size of the buffer a tool_output_t collects SBP frames in */
+#define TOOL_OUTPUT_BUFFER_SIZE (1u << 20)
+
+/* Most shards tool_convert_sharded() splits its input into */
+#define TOOL_MAX_JOBS 64
+
+/* Default amount of input a shard converts ahead of its own range so that
+ * ephemeris and time state has settled by the time its output is kept */
+#define TOOL_DEFAULT_WARMUP_SIZE (16u << 20)
+
+/**
+ * Output stage shared by the command line converters. SBP frames are
+ * collected in a buffer and handed to the tool's write function in large
+ * blocks, as few and as large as the buffer allows.
+ *
+ * All functions below report failure by returning false (or -1 for
+ * tool_output_writefn, which follows sbp_write_fn_t) after printing the
+ * reason to stderr.
+ */
+typedef struct {
+  uint8_t data[TOOL_OUTPUT_BUFFER_SIZE];
+  size_t length;
+  sbp_write_fn_t writefn;
+  void *context;
+} tool_output_t;
+
+/**
+ * Prepare `output` to forward to `writefn`, which is called with `context`.
+ */
+void tool_output_init(tool_output_t *output,
+                      sbp_write_fn_t writefn,
+                      void *context);
+
+/**
+ * Write `n` bytes straight through to the write function, bypassing the
+ * buffer. Repeats short writes until everything has been accepted.
+ */
+bool tool_output_write(tool_output_t *output, const uint8_t *buff, size_t n);
+
+/**
+ * Write out and empty the buffer.
+ */
+bool tool_output_flush(tool_output_t *output);
+
+/**
+ * sbp_write_fn_t which appends to the buffer of the tool_output_t passed as
+ * `context`, flushing it when full. Set the SBP state's io context to the
+ * tool_output_t to use it with sbp_message_send().
+ */
+s32 tool_output_writefn(u8 *buff, u32 n, void *context);
+
+/**
+ * Memory map the file at `path` read only and pass its contents to
+ * `convert`. An empty file is not passed on. Returns false if the file can't
+ * be mapped or `convert` returns false.
+ */
+bool tool_convert_mapped_file(const char *path,
+                              bool (*convert)(const uint8_t *data,
+                                              size_t length,
+                                              void *context),
+                              void *context);
+
+/**
+ * Converter hooks used by tool_convert_sharded().
+ */
+typedef struct {
+  /* Offset of the first complete frame at or after `offset`, or `length` if
+   * there is none */
+  size_t (*frame_boundary)(const uint8_t *data, size_t length, size_t offset);
+  /* Creates a converter configured like the serial one which sends its SBP
+   * frames through `writefn`, with `write_context` as the io context. Returns
+   * NULL on failure. */
+  void *(*create)(void *context, sbp_write_fn_t writefn, void *write_context);
+  /* Converts the frames in `data`, see ubx_sbp_process_buffer() */
+  void (*process)(void *converter, const uint8_t *data, size_t length);
+  void (*destroy)(void *converter);
+} tool_shard_ops_t;
+
+/**
+ * Splits `data` into `jobs` shards at frame boundaries and converts them in
+ * parallel, each with its own converter from `ops->create` (called with
+ * `context`). A shard first converts up to `warmup` bytes before its own range
+ * with the output discarded, so output matches a serial conversion as long as
+ * that is enough history for the converter state to settle.
+ *
+ * Output is written to `output` in file order. The first shard writes
+ * directly, the others spill to temporary files which are copied out as soon
+ * as all earlier shards have finished, so memory use doesn't depend on the
+ * size of the input.
+ */
+bool tool_convert_sharded(tool_output_t *output,
+                          const uint8_t *data,
+                          size_t length,
+                          unsigned jobs,
+                          size_t warmup,
+                          const tool_shard_ops_t *ops,
+                          void *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNSS_CONVERTERS_EXTRA_TOOL_IO_H */
@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2026 Swift Navigation Inc.
+ * Contact: Swift Navigation <dev@swiftnav.com>
+ *
+ * This source is subject to the license found in the file 'LICENSE' which must
+ * be be distributed together with this source. All other rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <gnss-converters-extra/tool_io.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+void tool_output_init(tool_output_t *output,
+                      sbp_write_fn_t writefn,
+                      void *context) {
+  assert(output);
+  output->length = 0;
+  output->writefn = writefn;
+  output->context = context;
+}
+
+bool tool_output_write(tool_output_t *output, const uint8_t *buff, size_t n) {
+  while (n > 0) {
+    u32 chunk = n > UINT32_MAX ? UINT32_MAX : (u32)n;
+    s32 written = output->writefn((u8 *)buff, chunk, output->context);
+    if (written <= 0) {
+      fprintf(stderr, "Write failure\n");
+      return false;
+    }
+    buff += written;
+    n -= (size_t)written;
+  }
+  return true;
+}
+
+bool tool_output_flush(tool_output_t *output) {
+  bool ok = tool_output_write(output, output->data, output->length);
+  output->length = 0;
+  return ok;
+}
+
+s32 tool_output_writefn(u8 *buff, u32 n, void *context) {
+  tool_output_t *output = context;
+  if (output->length + n > sizeof(output->data) && !tool_output_flush(output)) {
+    return -1;
+  }
+  if (n > sizeof(output->data)) {
+    return tool_output_write(output, buff, n) ? (s32)n : -1;
+  }
+  memcpy(&output->data[output->length], buff, n);
+  output->length += n;
+  return (s32)n;
+}
+
+bool tool_convert_mapped_file(const char *path,
+                              bool (*convert)(const uint8_t *data,
+                                              size_t length,
+                                              void *context),
+                              void *context) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    fprintf(stderr, "Unable to open %s: %s\n", path, strerror(errno));
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    fprintf(stderr, "Unable to stat %s: %s\n", path, strerror(errno));
+    close(fd);
+    return false;
+  }
+
+  bool ok = true;
+  size_t length = (size_t)st.st_size;
+  if (length > 0) {
+    void *data = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      fprintf(stderr, "Unable to map %s: %s\n", path, strerror(errno));
+      close(fd);
+      return false;
+    }
+    madvise(data, length, MADV_SEQUENTIAL);
+    ok = convert(data, length, context);
+    munmap(data, length);
+  }
+  close(fd);
+  return ok;
+}
+
+/* Size of the chunks in which spilled shard output is copied to the output */
+#define SPILL_CHUNK_SIZE 65536
+
+/* One piece of the input converted on its own thread. The shard runs its
+ * converter over [warmup_begin, end) but only keeps the output produced by
+ * frames in [begin, end), which is exactly the range no other shard keeps
+ * output for. */
+struct shard {
+  const tool_shard_ops_t *ops;
+  void *converter;
+  tool_output_t *output;
+  const uint8_t *data;
+  size_t warmup_begin;
+  size_t begin;
+  size_t end;
+  bool recording;
+  bool failed;
+  FILE *spill;
+};
+
+static s32 shard_writefn(u8 *buff, u32 n, void *context) {
+  struct shard *shard = context;
+  if (!shard->recording) {
+    return (s32)n;
+  }
+  if (shard->spill == NULL) {
+    s32 written = tool_output_writefn(buff, n, shard->output);
+    shard->failed = shard->failed || written < 0;
+    return written;
+  }
+  if (fwrite(buff, 1, n, shard->spill) != n) {
+    shard->failed = true;
+    return -1;
+  }
+  return (s32)n;
+}
+
+static void *shard_thread(void *arg) {
+  struct shard *shard = arg;
+  shard->ops->process(shard->converter,
+                      &shard->data[shard->warmup_begin],
+                      shard->begin - shard->warmup_begin);
+  shard->recording = true;
+  shard->ops->process(
+      shard->converter, &shard->data[shard->begin], shard->end - shard->begin);
+  return NULL;
+}
+
+/* Appends the output a shard spilled to its temporary file */
+static bool copy_spill(tool_output_t *output, FILE *spill) {
+  static u8 chunk[SPILL_CHUNK_SIZE];
+  if (fflush(spill) != 0 || fseek(spill, 0, SEEK_SET) != 0) {
+    return false;
+  }
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), spill)) > 0) {
+    if (tool_output_writefn(chunk, (u32)n, output) != (s32)n) {
+      return false;
+    }
+  }
+  return ferror(spill) == 0;
+}
+
+bool tool_convert_sharded(tool_output_t *output,
+                          const uint8_t *data,
+                          size_t length,
+                          unsigned jobs,
+                          size_t warmup,
+                          const tool_shard_ops_t *ops,
+                          void *context) {
+  assert(jobs > 0 && jobs <= TOOL_MAX_JOBS);
+  struct shard *shards = calloc(jobs, sizeof(*shards));
+  pthread_t *threads = calloc(jobs, sizeof(*threads));
+  if (shards == NULL || threads == NULL) {
+    fprintf(stderr, "Unable to allocate %u shards\n", jobs);
+    free(shards);
+    free(threads);
+    return false;
+  }
+
+  bool ok = true;
+  unsigned created = 0;
+  size_t begin = 0;
+  while (created < jobs) {
+    struct shard *shard = &shards[created];
+    if (created > 0 && (shard->spill = tmpfile()) == NULL) {
+      fprintf(stderr, "Unable to create spill file: %s\n", strerror(errno));
+      ok = false;
+      break;
+    }
+    shard->converter = ops->create(context, shard_writefn, shard);
+    if (shard->converter == NULL) {
+      fprintf(stderr, "Unable to create converter for shard %u\n", created);
+      ok = false;
+      break;
+    }
+    created++;
+
+    size_t end = length;
+    if (created < jobs) {
+      end = ops->frame_boundary(data, length, length / jobs * created);
+      end = end < begin ? begin : end;
+    }
+    size_t warmup_begin =
+        ops->frame_boundary(data, length, begin > warmup ? begin - warmup : 0);
+
+    shard->ops = ops;
+    shard->output = output;
+    shard->data = data;
+    shard->warmup_begin = warmup_begin < begin ? warmup_begin : begin;
+    shard->begin = begin;
+    shard->end = end;
+    begin = end;
+  }
+
+  unsigned started = 0;
+  while (ok && started < jobs) {
+    if (pthread_create(
+            &threads[started], NULL, shard_thread, &shards[started]) != 0) {
+      fprintf(stderr, "Unable to start shard thread\n");
+      ok = false;
+      break;
+    }
+    started++;
+  }
+
+  for (unsigned i = 0; i < started; i++) {
+    pthread_join(threads[i], NULL);
+    if (shards[i].failed) {
+      fprintf(stderr, "Unable to write the output of shard %u\n", i);
+      ok = false;
+    }
+    if (ok && shards[i].spill != NULL &&
+        !copy_spill(output, shards[i].spill)) {
+      fprintf(stderr, "Unable to copy the output of shard %u\n", i);
+      ok = false;
+    }
+  }
+  for (unsigned i = 0; i < jobs; i++) {
+    if (i < created) {
+      ops->destroy(shards[i].converter);
+    }
+    if (shards[i].spill != NULL) {
+      fclose(shards[i].spill);
+    }
+  }
+  ok = ok && tool_output_flush(output);
+
+  free(shards);
+  free(threads);
+  return ok;
+}
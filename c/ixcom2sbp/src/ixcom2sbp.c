@@ -11,21 +11,28 @@
  */
 
 #include <getopt.h>
+#include <gnss-converters-extra/tool_io.h>
 #include <gnss-converters/ixcom_sbp.h>
 #include <ixcom2sbp/internal/ixcom2sbp.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#define DEFAULT_IMU_BATCH_LATENCY_MS 20
+
 static sbp_state_t sbp_state;
-static sbp_write_fn_t g_writefn;
+
+/* SBP frames produced while handling one iXCOM frame (or one IMU batch) are
+ * collected here and handed to the write function in one go */
+static tool_output_t output;
 
 static void sbp_write(u16 sender_id,
                       sbp_msg_type_t msg_type,
                       const sbp_msg_t *msg,
                       void *context) {
   (void)context;
-  sbp_message_send(&sbp_state, msg_type, sender_id, msg, g_writefn);
+  sbp_message_send(&sbp_state, msg_type, sender_id, msg, tool_output_writefn);
 }
 
 static void help(char *arg, const char *additional_opts_help) {
@@ -37,6 +44,14 @@ static void help(char *arg, const char *additional_opts_help) {
       "  -s, --sender_id use provided sender id. Can be hex format if prefixed "
       "with '0x'. Defaults to %d\n",
       DEFAULT_IXCOM_SENDER_ID);
+  fprintf(stderr,
+          "  --imu_batch N convert and write up to N IMURAW frames at a time, "
+          "at most %d\n",
+          IXCOM_MAX_IMU_BATCH);
+  fprintf(stderr,
+          "  --imu_batch_latency MS hold IMURAW frames back for at most MS "
+          "milliseconds of IMU time when batching. Defaults to %d\n",
+          DEFAULT_IMU_BATCH_LATENCY_MS);
 }
 
 int ixcom2sbp(int argc,
@@ -45,24 +60,38 @@ int ixcom2sbp(int argc,
               readfn_ptr readfn,
               writefn_ptr writefn,
               void *context) {
-  g_writefn = writefn;
+  tool_output_init(&output, writefn, context);
 
   sbp_state_init(&sbp_state);
-  sbp_state_set_io_context(&sbp_state, context);
+  sbp_state_set_io_context(&sbp_state, &output);
 
   struct ixcom_sbp_state state;
   ixcom_sbp_init(&state, &sbp_write, context);
 
+  size_t imu_batch = 0;
+  u32 imu_batch_latency_ms = DEFAULT_IMU_BATCH_LATENCY_MS;
+
   int opt;
   int option_index = 0;
   static struct option long_options[] = {
       {"sender_id", required_argument, 0, 's'},
+      {"imu_batch", required_argument, 0, 0},
+      {"imu_batch_latency", required_argument, 0, 0},
       {"help", no_argument, 0, 'h'},
       {0, 0, 0, 0}};
 
   while ((opt = getopt_long(argc, argv, "hs:", long_options, &option_index)) !=
          -1) {
     switch (opt) {
+      case 0:
+        if (strcmp("imu_batch", long_options[option_index].name) == 0) {
+          imu_batch = strtoul(optarg, NULL, 0);
+        } else if (strcmp("imu_batch_latency",
+                          long_options[option_index].name) == 0) {
+          imu_batch_latency_ms = (u32)strtoul(optarg, NULL, 0);
+        }
+        break;
+
       case 's':
         ixcom_set_sender_id(&state, (u16)strtol(optarg, NULL, 0));
         break;
@@ -76,9 +105,14 @@ int ixcom2sbp(int argc,
     }
   }
 
+  ixcom_sbp_set_imu_batching(&state, imu_batch, imu_batch_latency_ms);
+
   int ret;
   do {
     ret = ixcom_sbp_process(&state, readfn);
+    if (output.length > 0 && !tool_output_flush(&output)) {
+      return 1;
+    }
   } while (ret > 0);
 
   return 0;
@@ -135,6 +135,257 @@ START_TEST(test_wheeldata) {
 }
 END_TEST
 
+#define WHEELDATA_FRAME_SIZE 28
+
+/* WHEELDATA frame with a valid checksum */
+static void make_wheeldata(int32_t ticks, uint8_t frame[WHEELDATA_FRAME_SIZE]) {
+  memset(frame, 0, WHEELDATA_FRAME_SIZE);
+  frame[0] = XCOM_SYNC_BYTE;
+  frame[1] = XCOM_MSGID_WHEELDATA;
+  frame[4] = WHEELDATA_FRAME_SIZE;
+  memcpy(&frame[20], &ticks, sizeof(ticks));
+  uint16_t crc = ixcom_checksum(frame, WHEELDATA_FRAME_SIZE - 2);
+  frame[WHEELDATA_FRAME_SIZE - 2] = (uint8_t)crc;
+  frame[WHEELDATA_FRAME_SIZE - 1] = (uint8_t)(crc >> 8);
+}
+
+#define IMURAW_FRAME_SIZE 44
+
+/* IMURAW frame with a valid checksum */
+static void make_imuraw(uint32_t sec,
+                        uint32_t usec,
+                        float acc,
+                        uint8_t frame[IMURAW_FRAME_SIZE]) {
+  memset(frame, 0, IMURAW_FRAME_SIZE);
+  frame[0] = XCOM_SYNC_BYTE;
+  frame[1] = XCOM_MSGID_IMURAW;
+  frame[4] = IMURAW_FRAME_SIZE;
+  memcpy(&frame[8], &sec, sizeof(sec));
+  memcpy(&frame[12], &usec, sizeof(usec));
+  memcpy(&frame[16], &acc, sizeof(acc));
+  uint16_t crc = ixcom_checksum(frame, IMURAW_FRAME_SIZE - 2);
+  frame[IMURAW_FRAME_SIZE - 2] = (uint8_t)crc;
+  frame[IMURAW_FRAME_SIZE - 1] = (uint8_t)(crc >> 8);
+}
+
+/* in memory iXCOM stream, handed out max_read bytes at a time */
+struct test_stream {
+  uint8_t bytes[8192];
+  size_t length;
+  size_t offset;
+  size_t max_read;
+};
+
+static void append_frame(struct test_stream *stream,
+                         const uint8_t *frame,
+                         size_t length) {
+  ck_assert_uint_le(stream->length + length, sizeof(stream->bytes));
+  memcpy(&stream->bytes[stream->length], frame, length);
+  stream->length += length;
+}
+
+/* the read function and the callback share the state's context, which starts
+ * with the stream */
+static int read_test_stream(uint8_t *buf, size_t len, void *ctx) {
+  struct test_stream *stream = ctx;
+  size_t n = stream->length - stream->offset;
+  n = n < len ? n : len;
+  n = n < stream->max_read ? n : stream->max_read;
+  memcpy(buf, &stream->bytes[stream->offset], n);
+  stream->offset += n;
+  return (int)n;
+}
+
+struct resync_context {
+  struct test_stream stream;
+  int32_t ticks[8];
+  size_t n_ticks;
+};
+
+static void ixcom_sbp_callback_ticks(u16 sender_id,
+                                     sbp_msg_type_t msg_type,
+                                     const sbp_msg_t *msg,
+                                     void *ctx) {
+  (void)sender_id;
+  struct resync_context *context = ctx;
+  if (msg_type == SbpMsgWheeltick) {
+    ck_assert_uint_lt(context->n_ticks, 8);
+    context->ticks[context->n_ticks++] = (int32_t)msg->wheeltick.ticks;
+  }
+}
+
+START_TEST(test_resync) {
+  static struct resync_context context;
+  uint8_t frame[WHEELDATA_FRAME_SIZE];
+
+  /* foreign data larger than the read buffer, with stray sync bytes one of
+   * which claims an impossibly long frame */
+  memset(context.stream.bytes, 0x55, 6000);
+  context.stream.bytes[100] = XCOM_SYNC_BYTE;
+  context.stream.bytes[5000] = XCOM_SYNC_BYTE;
+  context.stream.bytes[5005] = 0xFF;
+  context.stream.length = 6000;
+
+  for (int32_t ticks = 1; ticks <= 4; ticks++) {
+    make_wheeldata(ticks, frame);
+    if (ticks == 2) {
+      /* corrupted frame, dropped on its checksum */
+      frame[20] ^= 0xFF;
+    }
+    append_frame(&context.stream, frame, sizeof(frame));
+  }
+
+  /* frames split across reads as well as several frames per read */
+  const size_t max_reads[] = {1, 7, 1000, 4096};
+  for (size_t i = 0; i < sizeof(max_reads) / sizeof(max_reads[0]); i++) {
+    context.stream.offset = 0;
+    context.stream.max_read = max_reads[i];
+    context.n_ticks = 0;
+
+    struct ixcom_sbp_state state;
+    ixcom_sbp_init(&state, ixcom_sbp_callback_ticks, &context);
+    int ret;
+    do {
+      ret = ixcom_sbp_process(&state, read_test_stream);
+    } while (ret > 0);
+
+    ck_assert_uint_eq(context.stream.offset, context.stream.length);
+    ck_assert_uint_eq(context.n_ticks, 3);
+    ck_assert_int_eq(context.ticks[0], 1);
+    ck_assert_int_eq(context.ticks[1], 3);
+    ck_assert_int_eq(context.ticks[2], 4);
+  }
+}
+END_TEST
+
+#define MAX_BATCH_OUTPUT 64
+
+struct batch_output {
+  sbp_msg_type_t msg_type;
+  uint32_t tow;
+  int16_t acc_x;
+  int32_t ticks;
+};
+
+struct batch_context {
+  struct test_stream stream;
+  struct batch_output output[MAX_BATCH_OUTPUT];
+  size_t n_output;
+};
+
+static void ixcom_sbp_callback_batch(u16 sender_id,
+                                     sbp_msg_type_t msg_type,
+                                     const sbp_msg_t *msg,
+                                     void *ctx) {
+  (void)sender_id;
+  struct batch_context *context = ctx;
+  ck_assert_uint_lt(context->n_output, MAX_BATCH_OUTPUT);
+  struct batch_output *output = &context->output[context->n_output++];
+  memset(output, 0, sizeof(*output));
+  output->msg_type = msg_type;
+  if (msg_type == SbpMsgImuRaw) {
+    output->tow = msg->imu_raw.tow;
+    output->acc_x = msg->imu_raw.acc_x;
+  } else if (msg_type == SbpMsgWheeltick) {
+    output->ticks = (int32_t)msg->wheeltick.ticks;
+  }
+}
+
+static void run_batch(struct batch_context *context,
+                      size_t max_frames,
+                      u32 max_span_ms) {
+  context->stream.offset = 0;
+  context->n_output = 0;
+
+  struct ixcom_sbp_state state;
+  ixcom_sbp_init(&state, ixcom_sbp_callback_batch, context);
+  ixcom_sbp_set_imu_batching(&state, max_frames, max_span_ms);
+  int ret;
+  do {
+    ret = ixcom_sbp_process(&state, read_test_stream);
+  } while (ret > 0);
+}
+
+START_TEST(test_imu_batching) {
+  static struct batch_context context;
+  static struct batch_output unbatched[MAX_BATCH_OUTPUT];
+  uint8_t imuraw[IMURAW_FRAME_SIZE];
+  uint8_t wheeldata[WHEELDATA_FRAME_SIZE];
+
+  /* 500 Hz IMU with a wheel tick in between */
+  context.stream.length = 0;
+  context.stream.max_read = 4096;
+  for (uint32_t i = 0; i < 17; i++) {
+    make_imuraw(100, i * 2000, (float)i, imuraw);
+    append_frame(&context.stream, imuraw, sizeof(imuraw));
+    if (i == 9) {
+      make_wheeldata(42, wheeldata);
+      append_frame(&context.stream, wheeldata, sizeof(wheeldata));
+    }
+  }
+
+  run_batch(&context, 0, 0);
+  /* 17 IMU_RAW, 1 IMU_AUX, ODOMETRY and WHEELTICK */
+  ck_assert_uint_eq(context.n_output, 20);
+  size_t n_unbatched = context.n_output;
+  memcpy(unbatched, context.output, sizeof(unbatched));
+
+  /* full batches, batches cut short by the latency bound and by the end of
+   * the stream all have to come out the same */
+  const size_t max_frames[] = {4, 64, 64, IXCOM_MAX_IMU_BATCH + 1};
+  const u32 max_span_ms[] = {1000, 5, 1000, 0};
+  for (size_t i = 0; i < sizeof(max_frames) / sizeof(max_frames[0]); i++) {
+    run_batch(&context, max_frames[i], max_span_ms[i]);
+    ck_assert_uint_eq(context.n_output, n_unbatched);
+    for (size_t j = 0; j < n_unbatched; j++) {
+      ck_assert_int_eq(context.output[j].msg_type, unbatched[j].msg_type);
+      ck_assert_uint_eq(context.output[j].tow, unbatched[j].tow);
+      ck_assert_int_eq(context.output[j].acc_x, unbatched[j].acc_x);
+      ck_assert_int_eq(context.output[j].ticks, unbatched[j].ticks);
+    }
+  }
+
+  /* frames are held back until the batch is sent */
+  context.stream.offset = 0;
+  context.n_output = 0;
+  struct ixcom_sbp_state state;
+  ixcom_sbp_init(&state, ixcom_sbp_callback_batch, &context);
+  ixcom_sbp_set_imu_batching(&state, 4, 1000);
+  for (int i = 0; i < 3; i++) {
+    ck_assert_int_eq(ixcom_sbp_process(&state, read_test_stream),
+                     IMURAW_FRAME_SIZE);
+    ck_assert_uint_eq(context.n_output, 0);
+  }
+  ck_assert_int_eq(ixcom_sbp_process(&state, read_test_stream),
+                   IMURAW_FRAME_SIZE);
+  /* four IMU_RAW and the first IMU_AUX */
+  ck_assert_uint_eq(context.n_output, 5);
+
+  /* a stalled stream leaves a partial batch pending until it is flushed */
+  for (int i = 0; i < 2; i++) {
+    ck_assert_int_eq(ixcom_sbp_process(&state, read_test_stream),
+                     IMURAW_FRAME_SIZE);
+  }
+  ck_assert_uint_eq(context.n_output, 5);
+  ixcom_sbp_flush(&state);
+  ck_assert_uint_eq(context.n_output, 7);
+
+  /* a batch covering the latency bound is sent without waiting for the next
+   * frame, frames are 2 ms apart */
+  context.stream.offset = 0;
+  context.n_output = 0;
+  ixcom_sbp_init(&state, ixcom_sbp_callback_batch, &context);
+  ixcom_sbp_set_imu_batching(&state, 64, 4);
+  for (int i = 0; i < 2; i++) {
+    ixcom_sbp_process(&state, read_test_stream);
+    ck_assert_uint_eq(context.n_output, 0);
+  }
+  ixcom_sbp_process(&state, read_test_stream);
+  /* three IMU_RAW and the first IMU_AUX */
+  ck_assert_uint_eq(context.n_output, 4);
+}
+END_TEST
+
 Suite *ixcom_suite(void) {
   Suite *s = suite_create("IXCOM");
 
@@ -142,8 +393,14 @@ Suite *ixcom_suite(void) {
   tcase_add_test(tc_imuraw, test_imuraw);
   TCase *tc_wheeldata = tcase_create("IXCOM_WHEELDATA");
   tcase_add_test(tc_wheeldata, test_wheeldata);
+  TCase *tc_resync = tcase_create("IXCOM_resync");
+  tcase_add_test(tc_resync, test_resync);
+  TCase *tc_batching = tcase_create("IXCOM_batching");
+  tcase_add_test(tc_batching, test_imu_batching);
   suite_add_tcase(s, tc_imuraw);
   suite_add_tcase(s, tc_wheeldata);
+  suite_add_tcase(s, tc_resync);
+  suite_add_tcase(s, tc_batching);
 
   return s;
 }
@@ -20,6 +20,9 @@ extern "C" {
 #include <ixcom/messages.h>
 
 uint16_t ixcom_checksum(const uint8_t buff[], size_t length);
+uint16_t ixcom_checksum_update(uint16_t crc,
+                               const uint8_t buff[],
+                               size_t length);
 ixcom_rc ixcom_decode_header(const uint8_t buff[], XCOMHeader *header);
 ixcom_rc ixcom_decode_footer(const uint8_t buff[], XCOMFooter *footer);
 
@@ -27,6 +30,14 @@ ixcom_rc ixcom_decode_imuraw(const uint8_t buff[], XCOMmsg_IMURAW *msg_imuraw);
 ixcom_rc ixcom_decode_wheeldata(const uint8_t buff[],
                                 XCOMmsg_WHEELDATA *msg_wheeldata);
 
+/* As above but without checking the CRC, for framers which have already
+ * verified it over the whole frame. The CRC is still decoded into the
+ * footer. */
+ixcom_rc ixcom_decode_imuraw_unchecked(const uint8_t buff[],
+                                       XCOMmsg_IMURAW *msg_imuraw);
+ixcom_rc ixcom_decode_wheeldata_unchecked(const uint8_t buff[],
+                                          XCOMmsg_WHEELDATA *msg_wheeldata);
+
 #ifdef __cplusplus
 }
 #endif
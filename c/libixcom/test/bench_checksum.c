@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 Swift Navigation Inc.
+ * Contact: Swift Navigation <dev@swiftnav.com>
+ *
+ * This source is subject to the license found in the file 'LICENSE' which must
+ * be distributed together with this source. All other rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+/*
+ * Throughput of ixcom_checksum against a one byte per lookup table loop, the
+ * way the checksum used to be computed. Not part of the test suite, build
+ * with `make bench_ixcom_checksum`.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <ixcom/decode.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define TOTAL_BYTES (256u * 1024u * 1024u)
+
+static uint16_t byte_table[256];
+
+static void init_byte_table(void) {
+  for (uint16_t i = 0; i < 256; i++) {
+    uint16_t crc = (uint16_t)(i << 8);
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (uint16_t)((crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1);
+    }
+    byte_table[i] = crc;
+  }
+}
+
+static uint16_t bytewise_checksum(const uint8_t buff[], size_t length) {
+  uint16_t crc = 0;
+  for (size_t i = 0; i < length; i++) {
+    crc = (uint16_t)((crc << 8) ^ byte_table[(crc >> 8) ^ buff[i]]);
+  }
+  return crc;
+}
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* returns MB/s, folds the checksums into *sink so the loop is kept */
+static double run(uint16_t (*checksum)(const uint8_t[], size_t),
+                  const uint8_t *buff,
+                  size_t length,
+                  unsigned *sink) {
+  size_t iterations = TOTAL_BYTES / length;
+  double start = now();
+  for (size_t i = 0; i < iterations; i++) {
+    *sink += checksum(buff, length);
+  }
+  double elapsed = now() - start;
+  return (double)(iterations * length) / elapsed / 1e6;
+}
+
+int main(void) {
+  /* an IMURAW frame, a typical read and a large mapped block */
+  static const size_t lengths[] = {36, 1024, 64 * 1024};
+
+  init_byte_table();
+
+  uint8_t *buff = malloc(64 * 1024);
+  if (buff == NULL) {
+    return 1;
+  }
+  srand(0);
+  for (size_t i = 0; i < 64 * 1024; i++) {
+    buff[i] = (uint8_t)rand();
+  }
+
+  if (bytewise_checksum(buff, 64 * 1024) != ixcom_checksum(buff, 64 * 1024)) {
+    fprintf(stderr, "checksum mismatch\n");
+    free(buff);
+    return 1;
+  }
+
+  unsigned sink = 0;
+  printf("%10s %14s %14s\n", "bytes", "bytewise MB/s", "sliced MB/s");
+  for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+    double bytewise = run(bytewise_checksum, buff, lengths[i], &sink);
+    double sliced = run(ixcom_checksum, buff, lengths[i], &sink);
+    printf("%10zu %14.0f %14.0f\n", lengths[i], bytewise, sliced);
+  }
+  fprintf(stderr, "checksum sink %u\n", sink);
+
+  free(buff);
+  return 0;
+}
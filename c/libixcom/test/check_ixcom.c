@@ -86,6 +86,16 @@ START_TEST(test_ixcom_imuraw) {
   ixcom_rc ret = ixcom_decode_imuraw(buff, &msg_imuraw_out);
   ck_assert_int_eq(IXCOM_RC_OK, ret);
   msg_imuraw_equals(&msg, &msg_imuraw_out);
+
+  /* only the checked decoder looks at the CRC */
+  buff[msg.header.msg_len - 1] ^= 0xff;
+  ret = ixcom_decode_imuraw(buff, &msg_imuraw_out);
+  ck_assert_int_eq(IXCOM_RC_INVALID_MESSAGE, ret);
+  ret = ixcom_decode_imuraw_unchecked(buff, &msg_imuraw_out);
+  ck_assert_int_eq(IXCOM_RC_OK, ret);
+  ck_assert_int_ne(msg.footer.crc16, msg_imuraw_out.footer.crc16);
+  msg_imuraw_out.footer.crc16 = msg.footer.crc16;
+  msg_imuraw_equals(&msg, &msg_imuraw_out);
 }
 END_TEST
 
@@ -115,6 +125,52 @@ START_TEST(test_ixcom_wheeldata) {
   ixcom_rc ret = ixcom_decode_wheeldata(buff, &msg_wheeldata_out);
   ck_assert_int_eq(IXCOM_RC_OK, ret);
   msg_wheeldata_equals(&msg, &msg_wheeldata_out);
+
+  /* only the checked decoder looks at the CRC */
+  buff[msg.header.msg_len - 1] ^= 0xff;
+  ret = ixcom_decode_wheeldata(buff, &msg_wheeldata_out);
+  ck_assert_int_eq(IXCOM_RC_INVALID_MESSAGE, ret);
+  ret = ixcom_decode_wheeldata_unchecked(buff, &msg_wheeldata_out);
+  ck_assert_int_eq(IXCOM_RC_OK, ret);
+  ck_assert_int_ne(msg.footer.crc16, msg_wheeldata_out.footer.crc16);
+  msg_wheeldata_out.footer.crc16 = msg.footer.crc16;
+  msg_wheeldata_equals(&msg, &msg_wheeldata_out);
+}
+END_TEST
+
+/* bit by bit CRC-16-CCITT, polynomial 0x1021 */
+static uint16_t reference_checksum(const uint8_t buff[], size_t length) {
+  uint16_t crc = 0;
+  for (size_t i = 0; i < length; i++) {
+    crc = (uint16_t)(crc ^ (buff[i] << 8));
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (uint16_t)((crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1);
+    }
+  }
+  return crc;
+}
+
+START_TEST(test_ixcom_checksum) {
+  const uint8_t check[] = "123456789";
+  ck_assert_uint_eq(ixcom_checksum(check, 9), 0x31c3);
+
+  uint8_t buff[300];
+  srand(1);
+  for (size_t i = 0; i < sizeof(buff); i++) {
+    buff[i] = (uint8_t)rand();
+  }
+
+  for (size_t length = 0; length <= sizeof(buff); length++) {
+    uint16_t expected = reference_checksum(buff, length);
+    ck_assert_uint_eq(ixcom_checksum(buff, length), expected);
+
+    /* the same checksum has to come out however the message is split */
+    for (size_t split = 0; split <= length; split += 7) {
+      uint16_t crc = ixcom_checksum_update(0, buff, split);
+      crc = ixcom_checksum_update(crc, buff + split, length - split);
+      ck_assert_uint_eq(crc, expected);
+    }
+  }
 }
 END_TEST
 
@@ -124,6 +180,7 @@ Suite *ixcom_suite(void) {
   TCase *tc_ixcom = tcase_create("ixcom");
   tcase_add_test(tc_ixcom, test_ixcom_imuraw);
   tcase_add_test(tc_ixcom, test_ixcom_wheeldata);
+  tcase_add_test(tc_ixcom, test_ixcom_checksum);
   suite_add_tcase(s, tc_ixcom);
 
   return s;
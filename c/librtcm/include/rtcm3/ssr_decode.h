@@ -27,6 +27,36 @@ rtcm3_rc rtcm3_decode_code_bias_bitstream(swiftnav_in_bitstream_t *buff,
 rtcm3_rc rtcm3_decode_phase_bias_bitstream(swiftnav_in_bitstream_t *buff,
                                            rtcm_msg_phase_bias *msg_phase_bias);
 
+bool is_ssr_code_biases_message(const uint16_t message_num);
+bool is_ssr_phase_biases_message(const uint16_t message_num);
+
+/* Streaming decoders for the SSR code and phase bias messages. These allow the
+ * biases to be consumed one satellite at a time directly off the bitstream
+ * rather than materialising the full rtcm_msg_code_bias/rtcm_msg_phase_bias
+ * tables. A message is laid out as its header, followed by header.num_sats
+ * satellites, each of which is followed by its own bias signals. */
+rtcm3_rc rtcm3_decode_code_bias_header_bitstream(swiftnav_in_bitstream_t *buff,
+                                                 rtcm_msg_ssr_header *header);
+rtcm3_rc rtcm3_decode_code_bias_sat_bitstream(
+    swiftnav_in_bitstream_t *buff,
+    const rtcm_msg_ssr_header *header,
+    uint8_t *sat_id,
+    uint8_t *num_code_biases);
+rtcm3_rc rtcm3_decode_code_bias_signal_bitstream(
+    swiftnav_in_bitstream_t *buff, rtcm_msg_ssr_code_bias_sig *signal);
+
+rtcm3_rc rtcm3_decode_phase_bias_header_bitstream(swiftnav_in_bitstream_t *buff,
+                                                  rtcm_msg_ssr_header *header);
+rtcm3_rc rtcm3_decode_phase_bias_sat_bitstream(
+    swiftnav_in_bitstream_t *buff,
+    const rtcm_msg_ssr_header *header,
+    uint8_t *sat_id,
+    uint8_t *num_phase_biases,
+    uint16_t *yaw_angle,
+    int8_t *yaw_rate);
+rtcm3_rc rtcm3_decode_phase_bias_signal_bitstream(
+    swiftnav_in_bitstream_t *buff, rtcm_msg_ssr_phase_bias_sig *signal);
+
 static inline rtcm3_rc rtcm3_decode_orbit(const uint8_t buff[],
                                           rtcm_msg_orbit *msg_orbit) {
   swiftnav_in_bitstream_t bitstream;
@@ -327,6 +327,66 @@ rtcm3_rc rtcm3_decode_orbit_clock_bitstream(
   return RC_OK;
 }
 
+/** Decode the header of an RTCMv3 Code bias message
+ *
+ * \param buff The input data buffer
+ * \param header RTCM SSR header struct
+ * \return  - RC_OK : Success
+ *          - RC_MESSAGE_TYPE_MISMATCH : Message type mismatch
+ *          - RC_INVALID_MESSAGE : Unknown constellation
+ */
+rtcm3_rc rtcm3_decode_code_bias_header_bitstream(swiftnav_in_bitstream_t *buff,
+                                                 rtcm_msg_ssr_header *header) {
+  assert(header);
+  if (!(RC_OK == decode_ssr_header(buff, header))) {
+    return RC_INVALID_MESSAGE;
+  }
+
+  if (!is_ssr_code_biases_message(header->message_num)) {
+    return RC_MESSAGE_TYPE_MISMATCH;
+  }
+  return RC_OK;
+}
+
+/** Decode the per satellite fields of an RTCMv3 Code bias message, the
+ * satellite's num_code_biases signals follow in the bitstream
+ *
+ * \param buff The input data buffer
+ * \param header RTCM SSR header struct of the message
+ * \param sat_id Decoded satellite ID
+ * \param num_code_biases Decoded number of code bias signals
+ * \return  - RC_OK : Success
+ *          - RC_INVALID_MESSAGE : Unknown constellation
+ */
+rtcm3_rc rtcm3_decode_code_bias_sat_bitstream(
+    swiftnav_in_bitstream_t *buff,
+    const rtcm_msg_ssr_header *header,
+    uint8_t *sat_id,
+    uint8_t *num_code_biases) {
+  assert(header);
+  if (!(RC_OK == decode_satellite_id(buff, header->constellation, sat_id))) {
+    return RC_INVALID_MESSAGE;
+  }
+
+  BITSTREAM_DECODE_U8(buff, *num_code_biases, 5);
+  return RC_OK;
+}
+
+/** Decode a single code bias signal of an RTCMv3 Code bias message
+ *
+ * \param buff The input data buffer
+ * \param signal Decoded code bias signal
+ * \return  - RC_OK : Success
+ *          - RC_INVALID_MESSAGE : Message too short
+ */
+rtcm3_rc rtcm3_decode_code_bias_signal_bitstream(
+    swiftnav_in_bitstream_t *buff, rtcm_msg_ssr_code_bias_sig *signal) {
+  assert(signal);
+  BITSTREAM_DECODE_U8(buff, signal->signal_id, 5);
+  BITSTREAM_DECODE_S16(buff, signal->code_bias, 14);
+  return RC_OK;
+}
+
 /** Decode an RTCMv3 Code bias message
  *
  * \param buff The input data buffer
@@ -338,36 +398,102 @@ rtcm3_rc rtcm3_decode_orbit_clock_bitstream(
 rtcm3_rc rtcm3_decode_code_bias_bitstream(swiftnav_in_bitstream_t *buff,
                                           rtcm_msg_code_bias *msg_code_bias) {
   assert(msg_code_bias);
-  if (!(RC_OK == decode_ssr_header(buff, &msg_code_bias->header))) {
-    return RC_INVALID_MESSAGE;
-  }
-
-  if (!is_ssr_code_biases_message(msg_code_bias->header.message_num)) {
-    return RC_MESSAGE_TYPE_MISMATCH;
+  rtcm3_rc ret =
+      rtcm3_decode_code_bias_header_bitstream(buff, &msg_code_bias->header);
+  if (RC_OK != ret) {
+    return ret;
   }
 
   for (int i = 0; i < msg_code_bias->header.num_sats; i++) {
     rtcm_msg_ssr_code_bias_sat *sat = &msg_code_bias->sats[i];
 
-    uint8_t number_of_bits_for_sat_id;
     if (!(RC_OK ==
-          get_number_of_bits_for_sat_id(msg_code_bias->header.constellation,
-                                        &number_of_bits_for_sat_id))) {
+          rtcm3_decode_code_bias_sat_bitstream(buff,
+                                               &msg_code_bias->header,
+                                               &sat->sat_id,
+                                               &sat->num_code_biases))) {
       return RC_INVALID_MESSAGE;
     }
 
-    BITSTREAM_DECODE_U8(buff, sat->sat_id, number_of_bits_for_sat_id);
-
-    BITSTREAM_DECODE_U8(buff, sat->num_code_biases, 5);
-
     for (int j = 0; j < sat->num_code_biases; j++) {
-      BITSTREAM_DECODE_U8(buff, sat->signals[j].signal_id, 5);
-      BITSTREAM_DECODE_S16(buff, sat->signals[j].code_bias, 14);
+      if (!(RC_OK ==
+            rtcm3_decode_code_bias_signal_bitstream(buff, &sat->signals[j]))) {
+        return RC_INVALID_MESSAGE;
+      }
     }
   }
   return RC_OK;
 }
 
+/** Decode the header of an RTCMv3 Phase bias message
+ *
+ * \param buff The input data buffer
+ * \param header RTCM SSR header struct
+ * \return  - RC_OK : Success
+ *          - RC_MESSAGE_TYPE_MISMATCH : Message type mismatch
+ *          - RC_INVALID_MESSAGE : Unknown constellation
+ */
+rtcm3_rc rtcm3_decode_phase_bias_header_bitstream(swiftnav_in_bitstream_t *buff,
+                                                  rtcm_msg_ssr_header *header) {
+  assert(header);
+  if (!(RC_OK == decode_ssr_header(buff, header))) {
+    return RC_INVALID_MESSAGE;
+  }
+
+  if (!is_ssr_phase_biases_message(header->message_num)) {
+    return RC_MESSAGE_TYPE_MISMATCH;
+  }
+  return RC_OK;
+}
+
+/** Decode the per satellite fields of an RTCMv3 Phase bias message, the
+ * satellite's num_phase_biases signals follow in the bitstream
+ *
+ * \param buff The input data buffer
+ * \param header RTCM SSR header struct of the message
+ * \param sat_id Decoded satellite ID
+ * \param num_phase_biases Decoded number of phase bias signals
+ * \param yaw_angle Decoded yaw angle
+ * \param yaw_rate Decoded yaw rate
+ * \return  - RC_OK : Success
+ *          - RC_INVALID_MESSAGE : Unknown constellation
+ */
+rtcm3_rc rtcm3_decode_phase_bias_sat_bitstream(
+    swiftnav_in_bitstream_t *buff,
+    const rtcm_msg_ssr_header *header,
+    uint8_t *sat_id,
+    uint8_t *num_phase_biases,
+    uint16_t *yaw_angle,
+    int8_t *yaw_rate) {
+  assert(header);
+  if (!(RC_OK == decode_satellite_id(buff, header->constellation, sat_id))) {
+    return RC_INVALID_MESSAGE;
+  }
+
+  BITSTREAM_DECODE_U8(buff, *num_phase_biases, 5);
+  BITSTREAM_DECODE_U16(buff, *yaw_angle, 9);
+  BITSTREAM_DECODE_S8(buff, *yaw_rate, 8);
+  return RC_OK;
+}
+
+/** Decode a single phase bias signal of an RTCMv3 Phase bias message
+ *
+ * \param buff The input data buffer
+ * \param signal Decoded phase bias signal
+ * \return  - RC_OK : Success
+ *          - RC_INVALID_MESSAGE : Message too short
+ */
+rtcm3_rc rtcm3_decode_phase_bias_signal_bitstream(
+    swiftnav_in_bitstream_t *buff, rtcm_msg_ssr_phase_bias_sig *signal) {
+  assert(signal);
+  BITSTREAM_DECODE_U8(buff, signal->signal_id, 5);
+  BITSTREAM_DECODE_BOOL(buff, signal->integer_indicator, 1);
+  BITSTREAM_DECODE_U8(buff, signal->widelane_indicator, 2);
+  BITSTREAM_DECODE_U8(buff, signal->discontinuity_indicator, 4);
+  BITSTREAM_DECODE_S32(buff, signal->phase_bias, 20);
+  return RC_OK;
+}
+
 /** Decode an RTCMv3 Phase bias message
  *
  * \param buff The input data buffer
@@ -379,36 +505,30 @@ rtcm3_rc rtcm3_decode_code_bias_bitstream(swiftnav_in_bitstream_t *buff,
 rtcm3_rc rtcm3_decode_phase_bias_bitstream(
     swiftnav_in_bitstream_t *buff, rtcm_msg_phase_bias *msg_phase_bias) {
   assert(msg_phase_bias);
-  if (!(RC_OK == decode_ssr_header(buff, &msg_phase_bias->header))) {
-    return RC_INVALID_MESSAGE;
-  }
-
-  if (!is_ssr_phase_biases_message(msg_phase_bias->header.message_num)) {
-    return RC_MESSAGE_TYPE_MISMATCH;
+  rtcm3_rc ret =
+      rtcm3_decode_phase_bias_header_bitstream(buff, &msg_phase_bias->header);
+  if (RC_OK != ret) {
+    return ret;
   }
 
   for (int i = 0; i < msg_phase_bias->header.num_sats; i++) {
     rtcm_msg_ssr_phase_bias_sat *sat = &msg_phase_bias->sats[i];
 
-    uint8_t number_of_bits_for_sat_id;
     if (!(RC_OK ==
-          get_number_of_bits_for_sat_id(msg_phase_bias->header.constellation,
-                                        &number_of_bits_for_sat_id))) {
+          rtcm3_decode_phase_bias_sat_bitstream(buff,
+                                                &msg_phase_bias->header,
+                                                &sat->sat_id,
+                                                &sat->num_phase_biases,
+                                                &sat->yaw_angle,
+                                                &sat->yaw_rate))) {
       return RC_INVALID_MESSAGE;
     }
 
-    BITSTREAM_DECODE_U8(buff, sat->sat_id, number_of_bits_for_sat_id);
-
-    BITSTREAM_DECODE_U8(buff, sat->num_phase_biases, 5);
-    BITSTREAM_DECODE_U16(buff, sat->yaw_angle, 9);
-    BITSTREAM_DECODE_S8(buff, sat->yaw_rate, 8);
-
     for (int j = 0; j < sat->num_phase_biases; j++) {
-      BITSTREAM_DECODE_U8(buff, sat->signals[j].signal_id, 5);
-      BITSTREAM_DECODE_BOOL(buff, sat->signals[j].integer_indicator, 1);
-      BITSTREAM_DECODE_U8(buff, sat->signals[j].widelane_indicator, 2);
-      BITSTREAM_DECODE_U8(buff, sat->signals[j].discontinuity_indicator, 4);
-      BITSTREAM_DECODE_S32(buff, sat->signals[j].phase_bias, 20);
+      if (!(RC_OK ==
+            rtcm3_decode_phase_bias_signal_bitstream(buff, &sat->signals[j]))) {
+        return RC_INVALID_MESSAGE;
+      }
     }
   }
   return RC_OK;
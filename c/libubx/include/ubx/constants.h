@@ -17,6 +17,9 @@
 
 #define UBX_MAX_NUM_OBS 256
 
+/* Size of a single RXM-RAWX measurement record in bytes */
+#define UBX_RXM_RAWX_MEAS_SIZE 32
+
 #define UBX_SYNC_CHAR_1 0xB5
 #define UBX_SYNC_CHAR_2 0x62
 
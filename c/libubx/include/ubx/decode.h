@@ -28,6 +28,10 @@ ubx_rc ubx_decode_hnr_pvt_bytestream(swiftnav_bytestream_t *buff,
                                      ubx_hnr_pvt *msg_hnr_pvt);
 ubx_rc ubx_decode_rxm_rawx_bytestream(swiftnav_bytestream_t *buff,
                                       ubx_rxm_rawx *msg_rawx);
+ubx_rc ubx_decode_rxm_rawx_header_bytestream(swiftnav_bytestream_t *buff,
+                                             ubx_rxm_rawx_header *header);
+ubx_rc ubx_decode_rxm_rawx_meas_bytestream(swiftnav_bytestream_t *buff,
+                                           ubx_rxm_rawx_meas *meas);
 ubx_rc ubx_decode_nav_att_bytestream(swiftnav_bytestream_t *buff,
                                      ubx_nav_att *msg_nav_att);
 ubx_rc ubx_decode_nav_clock_bytestream(swiftnav_bytestream_t *buff,
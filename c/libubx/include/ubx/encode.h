@@ -43,6 +43,16 @@ uint16_t ubx_encode_rxm_sfrbx(const ubx_rxm_sfrbx *msg_rxm_sfrbx,
 uint16_t ubx_encode_esf_ins(const ubx_esf_ins *msg_esf_ins, uint8_t buff[]);
 uint16_t ubx_encode_esf_meas(const ubx_esf_meas *msg_esf_meas, uint8_t buff[]);
 uint16_t ubx_encode_esf_raw(const ubx_esf_raw *msg_esf_raw, uint8_t buff[]);
+uint16_t ubx_encode_frame(uint8_t class_id,
+                          uint8_t msg_id,
+                          const void *msg,
+                          uint8_t buff[]);
+
+/* ubx_encode_rawx under the ubx_encode_<name>() spelling of UBX_MESSAGE_LIST */
+static inline uint16_t ubx_encode_rxm_rawx(const ubx_rxm_rawx *msg_rawx,
+                                           uint8_t buff[]) {
+  return ubx_encode_rawx(msg_rawx, buff);
+}
 
 #ifdef __cplusplus
 }
@@ -52,6 +52,109 @@ typedef enum ubx_rc_e {
 #define UBX_CLASS_MON 0x0A
 #define UBX_MSG_MON_HW 0x09
 
+/* Declarative list of the messages libubx can decode and encode. Every entry
+ * expands to X(CLASS, MSG, name), which names UBX_CLASS_<CLASS>,
+ * UBX_MSG_<CLASS>_<MSG>, the ubx_<name> message type and its
+ * ubx_decode_<name>_bytestream() / ubx_encode_<name>() functions. The list
+ * drives ubx_encode_frame(), the UBX to SBP converter's dispatch table and
+ * the AFL testcase generator.
+ *
+ * A message can be compiled out of all of these by defining
+ * UBX_DISABLE_<CLASS>_<MSG>, e.g. -DUBX_DISABLE_ESF_INS. The same switch also
+ * removes its decoder and encoder from libubx and its handler, along with the
+ * helpers only that handler uses, from the UBX to SBP converter. The
+ * declarations stay visible, calling a disabled message's functions fails to
+ * link. */
+#ifndef UBX_DISABLE_HNR_PVT
+#define UBX_MESSAGE_ENTRY_HNR_PVT(X) X(HNR, PVT, hnr_pvt)
+#else
+#define UBX_MESSAGE_ENTRY_HNR_PVT(X)
+#endif
+
+#ifndef UBX_DISABLE_NAV_ATT
+#define UBX_MESSAGE_ENTRY_NAV_ATT(X) X(NAV, ATT, nav_att)
+#else
+#define UBX_MESSAGE_ENTRY_NAV_ATT(X)
+#endif
+
+#ifndef UBX_DISABLE_NAV_CLOCK
+#define UBX_MESSAGE_ENTRY_NAV_CLOCK(X) X(NAV, CLOCK, nav_clock)
+#else
+#define UBX_MESSAGE_ENTRY_NAV_CLOCK(X)
+#endif
+
+#ifndef UBX_DISABLE_NAV_PVT
+#define UBX_MESSAGE_ENTRY_NAV_PVT(X) X(NAV, PVT, nav_pvt)
+#else
+#define UBX_MESSAGE_ENTRY_NAV_PVT(X)
+#endif
+
+#ifndef UBX_DISABLE_NAV_VELECEF
+#define UBX_MESSAGE_ENTRY_NAV_VELECEF(X) X(NAV, VELECEF, nav_velecef)
+#else
+#define UBX_MESSAGE_ENTRY_NAV_VELECEF(X)
+#endif
+
+#ifndef UBX_DISABLE_NAV_SAT
+#define UBX_MESSAGE_ENTRY_NAV_SAT(X) X(NAV, SAT, nav_sat)
+#else
+#define UBX_MESSAGE_ENTRY_NAV_SAT(X)
+#endif
+
+#ifndef UBX_DISABLE_NAV_STATUS
+#define UBX_MESSAGE_ENTRY_NAV_STATUS(X) X(NAV, STATUS, nav_status)
+#else
+#define UBX_MESSAGE_ENTRY_NAV_STATUS(X)
+#endif
+
+#ifndef UBX_DISABLE_RXM_RAWX
+#define UBX_MESSAGE_ENTRY_RXM_RAWX(X) X(RXM, RAWX, rxm_rawx)
+#else
+#define UBX_MESSAGE_ENTRY_RXM_RAWX(X)
+#endif
+
+#ifndef UBX_DISABLE_RXM_SFRBX
+#define UBX_MESSAGE_ENTRY_RXM_SFRBX(X) X(RXM, SFRBX, rxm_sfrbx)
+#else
+#define UBX_MESSAGE_ENTRY_RXM_SFRBX(X)
+#endif
+
+#ifndef UBX_DISABLE_ESF_INS
+#define UBX_MESSAGE_ENTRY_ESF_INS(X) X(ESF, INS, esf_ins)
+#else
+#define UBX_MESSAGE_ENTRY_ESF_INS(X)
+#endif
+
+#ifndef UBX_DISABLE_ESF_MEAS
+#define UBX_MESSAGE_ENTRY_ESF_MEAS(X) X(ESF, MEAS, esf_meas)
+#else
+#define UBX_MESSAGE_ENTRY_ESF_MEAS(X)
+#endif
+
+#ifndef UBX_DISABLE_ESF_RAW
+#define UBX_MESSAGE_ENTRY_ESF_RAW(X) X(ESF, RAW, esf_raw)
+#else
+#define UBX_MESSAGE_ENTRY_ESF_RAW(X)
+#endif
+
+/* Packs class and id into a single key, e.g. for dispatching on both */
+#define UBX_MESSAGE_KEY(class_id, msg_id) \
+  ((uint16_t)(((class_id) << 8) | (msg_id)))
+
+#define UBX_MESSAGE_LIST(X)        \
+  UBX_MESSAGE_ENTRY_HNR_PVT(X)     \
+  UBX_MESSAGE_ENTRY_NAV_ATT(X)     \
+  UBX_MESSAGE_ENTRY_NAV_CLOCK(X)   \
+  UBX_MESSAGE_ENTRY_NAV_PVT(X)     \
+  UBX_MESSAGE_ENTRY_NAV_VELECEF(X) \
+  UBX_MESSAGE_ENTRY_NAV_SAT(X)     \
+  UBX_MESSAGE_ENTRY_NAV_STATUS(X)  \
+  UBX_MESSAGE_ENTRY_RXM_RAWX(X)    \
+  UBX_MESSAGE_ENTRY_RXM_SFRBX(X)   \
+  UBX_MESSAGE_ENTRY_ESF_INS(X)     \
+  UBX_MESSAGE_ENTRY_ESF_MEAS(X)    \
+  UBX_MESSAGE_ENTRY_ESF_RAW(X)
+
 /* Max number of data words in RXM-SFRBX */
 #define UBX_RXM_SFRBX_MAX_DATA_WORDS 10
 
@@ -113,6 +216,38 @@ typedef struct {
   uint8_t reserved2[UBX_MAX_NUM_OBS];
 } ubx_rxm_rawx;
 
+/* Fixed part of an RXM-RAWX message, followed by num_meas records */
+typedef struct {
+  uint8_t class_id;
+  uint8_t msg_id;
+  uint16_t length;
+  double rcv_tow;
+  uint16_t rcv_wn;
+  int8_t leap_second;
+  uint8_t num_meas;
+  uint8_t rec_status;
+  uint8_t version;
+  uint8_t reserved1[2];
+} ubx_rxm_rawx_header;
+
+/* Single measurement record of an RXM-RAWX message */
+typedef struct {
+  double pseudorange_m;
+  double carrier_phase_cycles;
+  float doppler_hz;
+  uint8_t gnss_id;
+  uint8_t sat_id;
+  uint8_t sig_id;
+  uint8_t freq_id;
+  uint16_t lock_time;
+  uint8_t cno_dbhz;
+  uint8_t pr_std_m;
+  uint8_t cp_std_cycles;
+  uint8_t doppler_std_hz;
+  uint8_t track_state;
+  uint8_t reserved2;
+} ubx_rxm_rawx_meas;
+
 typedef struct {
   uint8_t class_id;
   uint8_t msg_id;
@@ -18,26 +18,47 @@
 // little endian.
 // TODO(yizhe) write endian-independent code
 
+/* Number of bytes folded into the checksum per block */
+#define UBX_CHECKSUM_BLOCK_SIZE 32
+
 /** Writes checksum over `length` bytes of `buf` into `CK_A` and `CK_B`. The
  * `length` includes class id, msg id, length bytes, and payload. Uses the 8-Bit
  * Fletcher Algorithm.
  *
+ * Whole blocks are folded in at once: over a block of n bytes, CK_A grows by
+ * the plain sum of the bytes and CK_B by n * CK_A plus the sum of the bytes
+ * weighted n, n - 1, ..., 1. The per block sums have no loop carried
+ * dependency and can be vectorised. Both are accumulated in 32 bits, which
+ * preserves the result modulo 256 regardless of overflow.
+ *
  * \param buff Buffer containing a ubx message.
  * \param length Length of the ubx message
  * \param CK_A first byte of checksum
  * \param CK_B second byte of checksum
  */
 void ubx_checksum(const uint8_t buff[], size_t length, uint8_t *checksum) {
-  uint8_t *CK_A = checksum;
-  uint8_t *CK_B = checksum + 1;
-  *CK_A = 0;
-  *CK_B = 0;
-  for (size_t i = 0; i < length; i++) {
-    *CK_A = *CK_A + buff[i];
-    *CK_B = *CK_B + *CK_A;
+  uint32_t ck_a = 0;
+  uint32_t ck_b = 0;
+  size_t i = 0;
+  for (; i + UBX_CHECKSUM_BLOCK_SIZE <= length; i += UBX_CHECKSUM_BLOCK_SIZE) {
+    uint32_t sum = 0;
+    uint32_t weighted_sum = 0;
+    for (uint32_t j = 0; j < UBX_CHECKSUM_BLOCK_SIZE; j++) {
+      sum += buff[i + j];
+      weighted_sum += (UBX_CHECKSUM_BLOCK_SIZE - j) * (uint32_t)buff[i + j];
+    }
+    ck_b += UBX_CHECKSUM_BLOCK_SIZE * ck_a + weighted_sum;
+    ck_a += sum;
+  }
+  for (; i < length; i++) {
+    ck_a += buff[i];
+    ck_b += ck_a;
   }
+  checksum[0] = (uint8_t)ck_a;
+  checksum[1] = (uint8_t)ck_b;
 }
 
+#ifndef UBX_DISABLE_HNR_PVT
 /** Deserialize the ubx_hnr_pvt message
  *
  * \param buff incoming data buffer
@@ -95,58 +116,129 @@ ubx_rc ubx_decode_hnr_pvt_bytestream(swiftnav_bytestream_t *buff,
 
   return RC_OK;
 }
+#endif
 
-/** Deserialize the ubx_rxm_rawx message
+#ifndef UBX_DISABLE_RXM_RAWX
+/** Deserialize the fixed part of an ubx_rxm_rawx message, leaving `buff` at
+ * the first measurement record
  *
  * \param buff incoming data buffer
- * \param msg_rawx UBX rawx message
- * \return UBX return code
+ * \param header UBX rawx message header
+ * \return UBX return code, RC_INVALID_MESSAGE unless all the num_meas records
+ * are present in `buff`
  */
-ubx_rc ubx_decode_rxm_rawx_bytestream(swiftnav_bytestream_t *buff,
-                                      ubx_rxm_rawx *msg_rawx) {
-  assert(msg_rawx);
-  BYTESTREAM_DECODE_BYTES(buff, msg_rawx->class_id, 1);
-  BYTESTREAM_DECODE_BYTES(buff, msg_rawx->msg_id, 1);
+ubx_rc ubx_decode_rxm_rawx_header_bytestream(swiftnav_bytestream_t *buff,
+                                             ubx_rxm_rawx_header *header) {
+  assert(header);
+  BYTESTREAM_DECODE_BYTES(buff, header->class_id, 1);
+  BYTESTREAM_DECODE_BYTES(buff, header->msg_id, 1);
 
-  if (msg_rawx->class_id != 0x02) {
+  if (header->class_id != 0x02) {
     return RC_MESSAGE_TYPE_MISMATCH;
   }
 
-  if (msg_rawx->msg_id != 0x15) {
+  if (header->msg_id != 0x15) {
     return RC_MESSAGE_TYPE_MISMATCH;
   }
 
-  BYTESTREAM_DECODE_BYTES(buff, msg_rawx->length, 2);
+  BYTESTREAM_DECODE_BYTES(buff, header->length, 2);
 
-  BYTESTREAM_DECODE_BYTES(buff, msg_rawx->rcv_tow, 8);
-  BYTESTREAM_DECODE_BYTES(buff, msg_rawx->rcv_wn, 2);
-  BYTESTREAM_DECODE_BYTES(buff, msg_rawx->leap_second, 1);
-  BYTESTREAM_DECODE_BYTES(buff, msg_rawx->num_meas, 1);
-  BYTESTREAM_DECODE_BYTES(buff, msg_rawx->rec_status, 1);
-  BYTESTREAM_DECODE_BYTES(buff, msg_rawx->version, 1);
+  BYTESTREAM_DECODE_BYTES(buff, header->rcv_tow, 8);
+  BYTESTREAM_DECODE_BYTES(buff, header->rcv_wn, 2);
+  BYTESTREAM_DECODE_BYTES(buff, header->leap_second, 1);
+  BYTESTREAM_DECODE_BYTES(buff, header->num_meas, 1);
+  BYTESTREAM_DECODE_BYTES(buff, header->rec_status, 1);
+  BYTESTREAM_DECODE_BYTES(buff, header->version, 1);
   for (int i = 0; i < 2; i++) {
-    BYTESTREAM_DECODE_BYTES(buff, msg_rawx->reserved1[i], 1);
+    BYTESTREAM_DECODE_BYTES(buff, header->reserved1[i], 1);
+  }
+
+  if (swiftnav_bytestream_remaining(buff) <
+      (size_t)header->num_meas * UBX_RXM_RAWX_MEAS_SIZE) {
+    return RC_INVALID_MESSAGE;
   }
+  return RC_OK;
+}
+
+/** Deserialize a single measurement record of an ubx_rxm_rawx message
+ *
+ * \param buff incoming data buffer, positioned at the record
+ * \param meas UBX rawx measurement
+ * \return UBX return code
+ */
+ubx_rc ubx_decode_rxm_rawx_meas_bytestream(swiftnav_bytestream_t *buff,
+                                           ubx_rxm_rawx_meas *meas) {
+  assert(meas);
+  BYTESTREAM_DECODE_BYTES(buff, meas->pseudorange_m, 8);
+  BYTESTREAM_DECODE_BYTES(buff, meas->carrier_phase_cycles, 8);
+  BYTESTREAM_DECODE_BYTES(buff, meas->doppler_hz, 4);
+  BYTESTREAM_DECODE_BYTES(buff, meas->gnss_id, 1);
+  BYTESTREAM_DECODE_BYTES(buff, meas->sat_id, 1);
+  BYTESTREAM_DECODE_BYTES(buff, meas->sig_id, 1);
+  BYTESTREAM_DECODE_BYTES(buff, meas->freq_id, 1);
+  BYTESTREAM_DECODE_BYTES(buff, meas->lock_time, 2);
+  BYTESTREAM_DECODE_BYTES(buff, meas->cno_dbhz, 1);
+  BYTESTREAM_DECODE_BYTES(buff, meas->pr_std_m, 1);
+  BYTESTREAM_DECODE_BYTES(buff, meas->cp_std_cycles, 1);
+  BYTESTREAM_DECODE_BYTES(buff, meas->doppler_std_hz, 1);
+  BYTESTREAM_DECODE_BYTES(buff, meas->track_state, 1);
+  BYTESTREAM_DECODE_BYTES(buff, meas->reserved2, 1);
+  return RC_OK;
+}
+
+/** Deserialize the ubx_rxm_rawx message
+ *
+ * \param buff incoming data buffer
+ * \param msg_rawx UBX rawx message
+ * \return UBX return code
+ */
+ubx_rc ubx_decode_rxm_rawx_bytestream(swiftnav_bytestream_t *buff,
+                                      ubx_rxm_rawx *msg_rawx) {
+  assert(msg_rawx);
+  ubx_rxm_rawx_header header;
+  ubx_rc ret = ubx_decode_rxm_rawx_header_bytestream(buff, &header);
+  if (ret != RC_OK) {
+    return ret;
+  }
+
+  msg_rawx->class_id = header.class_id;
+  msg_rawx->msg_id = header.msg_id;
+  msg_rawx->length = header.length;
+  msg_rawx->rcv_tow = header.rcv_tow;
+  msg_rawx->rcv_wn = header.rcv_wn;
+  msg_rawx->leap_second = header.leap_second;
+  msg_rawx->num_meas = header.num_meas;
+  msg_rawx->rec_status = header.rec_status;
+  msg_rawx->version = header.version;
+  msg_rawx->reserved1[0] = header.reserved1[0];
+  msg_rawx->reserved1[1] = header.reserved1[1];
 
   for (int i = 0; i < msg_rawx->num_meas; i++) {
-    BYTESTREAM_DECODE_BYTES(buff, msg_rawx->pseudorange_m[i], 8);
-    BYTESTREAM_DECODE_BYTES(buff, msg_rawx->carrier_phase_cycles[i], 8);
-    BYTESTREAM_DECODE_BYTES(buff, msg_rawx->doppler_hz[i], 4);
-    BYTESTREAM_DECODE_BYTES(buff, msg_rawx->gnss_id[i], 1);
-    BYTESTREAM_DECODE_BYTES(buff, msg_rawx->sat_id[i], 1);
-    BYTESTREAM_DECODE_BYTES(buff, msg_rawx->sig_id[i], 1);
-    BYTESTREAM_DECODE_BYTES(buff, msg_rawx->freq_id[i], 1);
-    BYTESTREAM_DECODE_BYTES(buff, msg_rawx->lock_time[i], 2);
-    BYTESTREAM_DECODE_BYTES(buff, msg_rawx->cno_dbhz[i], 1);
-    BYTESTREAM_DECODE_BYTES(buff, msg_rawx->pr_std_m[i], 1);
-    BYTESTREAM_DECODE_BYTES(buff, msg_rawx->cp_std_cycles[i], 1);
-    BYTESTREAM_DECODE_BYTES(buff, msg_rawx->doppler_std_hz[i], 1);
-    BYTESTREAM_DECODE_BYTES(buff, msg_rawx->track_state[i], 1);
-    BYTESTREAM_DECODE_BYTES(buff, msg_rawx->reserved2[i], 1);
+    ubx_rxm_rawx_meas meas;
+    ret = ubx_decode_rxm_rawx_meas_bytestream(buff, &meas);
+    if (ret != RC_OK) {
+      return ret;
+    }
+    msg_rawx->pseudorange_m[i] = meas.pseudorange_m;
+    msg_rawx->carrier_phase_cycles[i] = meas.carrier_phase_cycles;
+    msg_rawx->doppler_hz[i] = meas.doppler_hz;
+    msg_rawx->gnss_id[i] = meas.gnss_id;
+    msg_rawx->sat_id[i] = meas.sat_id;
+    msg_rawx->sig_id[i] = meas.sig_id;
+    msg_rawx->freq_id[i] = meas.freq_id;
+    msg_rawx->lock_time[i] = meas.lock_time;
+    msg_rawx->cno_dbhz[i] = meas.cno_dbhz;
+    msg_rawx->pr_std_m[i] = meas.pr_std_m;
+    msg_rawx->cp_std_cycles[i] = meas.cp_std_cycles;
+    msg_rawx->doppler_std_hz[i] = meas.doppler_std_hz;
+    msg_rawx->track_state[i] = meas.track_state;
+    msg_rawx->reserved2[i] = meas.reserved2;
   }
   return RC_OK;
 }
+#endif
 
+#ifndef UBX_DISABLE_NAV_ATT
 /** Deserialize the ubx_nav_att message
  *
  * \param buff incoming data buffer
@@ -185,7 +277,9 @@ ubx_rc ubx_decode_nav_att_bytestream(swiftnav_bytestream_t *buff,
 
   return RC_OK;
 }
+#endif
 
+#ifndef UBX_DISABLE_NAV_CLOCK
 /** Deserialize the ubx_nav_clock message
  *
  * \param buff incoming data buffer
@@ -217,7 +311,9 @@ ubx_rc ubx_decode_nav_clock_bytestream(swiftnav_bytestream_t *buff,
 
   return RC_OK;
 }
+#endif
 
+#ifndef UBX_DISABLE_NAV_PVT
 /** Deserialize the ubx_nav_pvt message
  *
  * \param buff incoming data buffer
@@ -284,7 +380,9 @@ ubx_rc ubx_decode_nav_pvt_bytestream(swiftnav_bytestream_t *buff,
   }
   return RC_OK;
 }
+#endif
 
+#ifndef UBX_DISABLE_NAV_VELECEF
 /** Deserialize the ubx_nav_velecef message
  *
  * \param buff incoming data buffer
@@ -316,7 +414,9 @@ ubx_rc ubx_decode_nav_velecef_bytestream(swiftnav_bytestream_t *buff,
 
   return RC_OK;
 }
+#endif
 
+#ifndef UBX_DISABLE_NAV_SAT
 /** Deserialize the ubx_nav_sat message
  *
  * \param buff incoming data buffer
@@ -363,7 +463,9 @@ ubx_rc ubx_decode_nav_sat_bytestream(swiftnav_bytestream_t *buff,
 
   return RC_OK;
 }
+#endif
 
+#ifndef UBX_DISABLE_NAV_STATUS
 /** Deserialize the ubx_nav_status message
  *
  * \param buff incoming data buffer
@@ -397,6 +499,7 @@ ubx_rc ubx_decode_nav_status_bytestream(swiftnav_bytestream_t *buff,
 
   return RC_OK;
 }
+#endif
 
 /** Deserialize the ubx_mga_gps_eph message
  *
@@ -461,6 +564,7 @@ ubx_rc ubx_decode_mga_gps_eph_bytestream(swiftnav_bytestream_t *buff,
   return RC_OK;
 }
 
+#ifndef UBX_DISABLE_RXM_SFRBX
 /** Deserialize the ubx_rxm_sfrbx message
  *
  * \param buff incoming data buffer
@@ -503,7 +607,9 @@ ubx_rc ubx_decode_rxm_sfrbx_bytestream(swiftnav_bytestream_t *buff,
 
   return RC_OK;
 }
+#endif
 
+#ifndef UBX_DISABLE_ESF_INS
 /** Deserialize the ubx_esf_ins message
  *
  * \param buff incoming data buffer
@@ -543,7 +649,9 @@ ubx_rc ubx_decode_esf_ins_bytestream(swiftnav_bytestream_t *buff,
 
   return RC_OK;
 }
+#endif
 
+#ifndef UBX_DISABLE_ESF_MEAS
 /** Deserialize the ubx_esf_meas message
  *
  * \param buff incoming data buffer
@@ -583,7 +691,9 @@ ubx_rc ubx_decode_esf_meas_bytestream(swiftnav_bytestream_t *buff,
 
   return RC_OK;
 }
+#endif
 
+#ifndef UBX_DISABLE_ESF_RAW
 /** Deserialize the ubx_esf_raw message
  *
  * \param buff incoming data buffer
@@ -621,3 +731,4 @@ ubx_rc ubx_decode_esf_raw_bytestream(swiftnav_bytestream_t *buff,
 
   return RC_OK;
 }
+#endif
@@ -17,6 +17,7 @@
 
 #include <string.h>
 #include <swiftnav/bits.h>
+#include <ubx/decode.h>
 #include <ubx/encode.h>
 
 // UBX protocol is little-endian.
@@ -59,6 +60,7 @@ void ubx_setbitsl(uint8_t *buff, uint32_t pos, uint32_t len, int64_t data) {
   ubx_setbitul(buff, pos, len, (uint64_t)data);
 }
 
+#ifndef UBX_DISABLE_HNR_PVT
 /** Serialize the ubx_hnr_pvt message
  *
  * \param buff outgoing data buffer
@@ -134,7 +136,9 @@ uint16_t ubx_encode_hnr_pvt(const ubx_hnr_pvt *msg_hnr_pvt, uint8_t buff[]) {
   }
   return index;
 }
+#endif
 
+#ifndef UBX_DISABLE_RXM_RAWX
 /** Serialize the ubx_rxm_rawx message
  *
  * \param buff outgoing data buffer
@@ -202,7 +206,9 @@ uint16_t ubx_encode_rawx(const ubx_rxm_rawx *msg_rawx, uint8_t buff[]) {
   }
   return index;
 }
+#endif
 
+#ifndef UBX_DISABLE_NAV_ATT
 /** Serialize the ubx_nav_att message
  *
  * \param buff outgoing data buffer
@@ -244,7 +250,9 @@ uint16_t ubx_encode_nav_att(const ubx_nav_att *msg_nav_att, uint8_t buff[]) {
 
   return index;
 }
+#endif
 
+#ifndef UBX_DISABLE_NAV_CLOCK
 /** Serialize the ubx_nav_att message
  *
  * \param buff outgoing data buffer
@@ -276,7 +284,9 @@ uint16_t ubx_encode_nav_clock(const ubx_nav_clock *msg_nav_clock,
 
   return index;
 }
+#endif
 
+#ifndef UBX_DISABLE_NAV_PVT
 /** Serialize the ubx_nav_pvt message
  *
  * \param buff outgoing data buffer
@@ -365,7 +375,9 @@ uint16_t ubx_encode_nav_pvt(const ubx_nav_pvt *msg_nav_pvt, uint8_t buff[]) {
   index += 2;
   return index;
 }
+#endif
 
+#ifndef UBX_DISABLE_NAV_VELECEF
 /** Serialize the ubx_nav_velecef message
  *
  * \param buff outgoing data buffer
@@ -397,7 +409,9 @@ uint16_t ubx_encode_nav_velecef(const ubx_nav_velecef *msg_nav_velecef,
 
   return index;
 }
+#endif
 
+#ifndef UBX_DISABLE_NAV_SAT
 /** Serialize the ubx_nav_sat message
  *
  * \param buff outgoing data buffer
@@ -449,7 +463,9 @@ uint16_t ubx_encode_nav_sat(const ubx_nav_sat *msg_nav_sat, uint8_t buff[]) {
 
   return index;
 }
+#endif
 
+#ifndef UBX_DISABLE_NAV_STATUS
 /** Serialize the ubx_nav_status message
  *
  * \param buff outgoing data buffer
@@ -485,6 +501,7 @@ uint16_t ubx_encode_nav_status(const ubx_nav_status *msg_nav_status,
 
   return index;
 }
+#endif
 
 /** Serialize the ubx_mga_gps_eph message
  *
@@ -574,6 +591,7 @@ uint16_t ubx_encode_mga_gps_eph(const ubx_mga_gps_eph *msg_mga_gps_eph,
   return index;
 }
 
+#ifndef UBX_DISABLE_RXM_SFRBX
 /** Serialize the ubx_rxm_sfrbx message
  *
  * \param buff outgoing data buffer
@@ -618,7 +636,9 @@ uint16_t ubx_encode_rxm_sfrbx(const ubx_rxm_sfrbx *msg_rxm_sfrbx,
 
   return index;
 }
+#endif
 
+#ifndef UBX_DISABLE_ESF_INS
 /** Serialize the ubx_esf_ins message
  *
  * \param buff outgoing data buffer
@@ -662,7 +682,9 @@ uint16_t ubx_encode_esf_ins(const ubx_esf_ins *msg_esf_ins, uint8_t buff[]) {
 
   return index;
 }
+#endif
 
+#ifndef UBX_DISABLE_ESF_MEAS
 /** Serialize the ubx_esf_meas message
  *
  * \param buff outgoing data buffer
@@ -701,7 +723,9 @@ uint16_t ubx_encode_esf_meas(const ubx_esf_meas *msg_esf_meas, uint8_t buff[]) {
 
   return index;
 }
+#endif
 
+#ifndef UBX_DISABLE_ESF_RAW
 /** Serialize the ubx_esf_raw message
  *
  * \param buff outgoing data buffer
@@ -731,3 +755,36 @@ uint16_t ubx_encode_esf_raw(const ubx_esf_raw *msg_esf_raw, uint8_t buff[]) {
   }
   return index;
 }
+#endif
+
+/** Serialize any message of UBX_MESSAGE_LIST into a complete frame
+ *
+ * \param class_id UBX class of the message
+ * \param msg_id UBX id of the message
+ * \param msg message to serialize, its type must match class_id and msg_id
+ * \param buff outgoing data buffer, receives the sync chars and checksum too
+ * \return number of bytes serialized, 0 if the message isn't in the list
+ */
+uint16_t ubx_encode_frame(uint8_t class_id,
+                          uint8_t msg_id,
+                          const void *msg,
+                          uint8_t buff[]) {
+  assert(msg);
+
+  uint16_t length;
+  switch (UBX_MESSAGE_KEY(class_id, msg_id)) {
+#define UBX_ENCODE_FRAME_CASE(CLASS, MSG, name)                     \
+  case UBX_MESSAGE_KEY(UBX_CLASS_##CLASS, UBX_MSG_##CLASS##_##MSG): \
+    length = ubx_encode_##name((const ubx_##name *)msg, &buff[2]);  \
+    break;
+    UBX_MESSAGE_LIST(UBX_ENCODE_FRAME_CASE)
+#undef UBX_ENCODE_FRAME_CASE
+    default:
+      return 0;
+  }
+
+  buff[0] = UBX_SYNC_CHAR_1;
+  buff[1] = UBX_SYNC_CHAR_2;
+  ubx_checksum(&buff[2], length, &buff[2 + length]);
+  return (uint16_t)(length + 4);
+}
@@ -24,6 +24,29 @@
 
 #define FLOAT_EPS 1e-6
 
+/* Byte at a time Fletcher-8, the reference for ubx_checksum */
+static void ubx_checksum_reference(const uint8_t buff[],
+                                   size_t length,
+                                   uint8_t *checksum) {
+  uint8_t ck_a = 0;
+  uint8_t ck_b = 0;
+  for (size_t i = 0; i < length; i++) {
+    ck_a = (uint8_t)(ck_a + buff[i]);
+    ck_b = (uint8_t)(ck_b + ck_a);
+  }
+  checksum[0] = ck_a;
+  checksum[1] = ck_b;
+}
+
+static void check_checksum_equivalence(const uint8_t buff[], size_t length) {
+  uint8_t expected[2];
+  uint8_t actual[2];
+  ubx_checksum_reference(buff, length, expected);
+  ubx_checksum(buff, length, actual);
+  ck_assert_uint_eq(actual[0], expected[0]);
+  ck_assert_uint_eq(actual[1], expected[1]);
+}
+
 void msg_hnr_pvt_equals(const ubx_hnr_pvt *msg_in, const ubx_hnr_pvt *msg_out) {
   ck_assert_uint_eq(msg_in->class_id, msg_out->class_id);
   ck_assert_uint_eq(msg_in->msg_id, msg_out->msg_id);
@@ -737,6 +760,78 @@ START_TEST(test_ubx_esf_raw) {
 
 END_TEST
 
+START_TEST(test_ubx_checksum) {
+  static uint8_t buff[4096];
+
+  /* Every length of a frame up to the converter frame size, against all zero,
+   * all 0xFF (largest intermediate sums) and pseudo random contents */
+  uint32_t seed = 0x12345678;
+  for (size_t i = 0; i < sizeof(buff); i++) {
+    seed = seed * 1103515245u + 12345u;
+    buff[i] = (uint8_t)(seed >> 16);
+  }
+  for (size_t length = 0; length <= sizeof(buff); length++) {
+    check_checksum_equivalence(buff, length);
+  }
+  for (size_t offset = 1; offset < 64; offset++) {
+    check_checksum_equivalence(buff + offset, sizeof(buff) - offset);
+  }
+
+  memset(buff, 0xFF, sizeof(buff));
+  for (size_t length = 0; length <= sizeof(buff); length++) {
+    check_checksum_equivalence(buff, length);
+  }
+
+  /* Every byte value at every position of a buffer spanning two blocks and a
+   * tail */
+  memset(buff, 0, sizeof(buff));
+  for (size_t pos = 0; pos < 75; pos++) {
+    for (uint32_t value = 0; value < 256; value++) {
+      buff[pos] = (uint8_t)value;
+      check_checksum_equivalence(buff, 75);
+    }
+    buff[pos] = 0;
+  }
+}
+END_TEST
+
+START_TEST(test_ubx_encode_frame) {
+  uint8_t buff[1024];
+  uint8_t checksum[2];
+  swiftnav_bytestream_t bs;
+
+  /* Every message of the list makes a well formed frame which its own
+   * decoder accepts */
+#define CHECK_ENCODE_FRAME(CLASS, MSG, name)                                  \
+  {                                                                           \
+    ubx_##name msg;                                                           \
+    memset(&msg, 0, sizeof(msg));                                             \
+    msg.class_id = UBX_CLASS_##CLASS;                                         \
+    msg.msg_id = UBX_MSG_##CLASS##_##MSG;                                     \
+    uint16_t n = ubx_encode_frame(msg.class_id, msg.msg_id, &msg, buff);      \
+    ck_assert_uint_ge(n, 8);                                                  \
+    msg.length = (uint16_t)(n - 8);                                           \
+    ck_assert_uint_eq(ubx_encode_frame(msg.class_id, msg.msg_id, &msg, buff), \
+                      n);                                                     \
+    ck_assert_uint_eq(buff[0], UBX_SYNC_CHAR_1);                              \
+    ck_assert_uint_eq(buff[1], UBX_SYNC_CHAR_2);                              \
+    ubx_checksum(&buff[2], n - 4u, checksum);                                 \
+    ck_assert_uint_eq(buff[n - 2], checksum[0]);                              \
+    ck_assert_uint_eq(buff[n - 1], checksum[1]);                              \
+    swiftnav_bytestream_init(&bs, &buff[2], n - 4u);                          \
+    ubx_##name decoded;                                                       \
+    ck_assert_int_eq(ubx_decode_##name##_bytestream(&bs, &decoded), RC_OK);   \
+  }
+  UBX_MESSAGE_LIST(CHECK_ENCODE_FRAME)
+#undef CHECK_ENCODE_FRAME
+
+  ubx_nav_att msg;
+  memset(&msg, 0, sizeof(msg));
+  ck_assert_uint_eq(ubx_encode_frame(UBX_CLASS_MON, UBX_MSG_MON_HW, &msg, buff),
+                    0);
+}
+END_TEST
+
 Suite *ubx_suite(void) {
   Suite *s = suite_create("ubx");
 
@@ -754,6 +849,8 @@ Suite *ubx_suite(void) {
   tcase_add_test(tc_ubx, test_ubx_esf_ins);
   tcase_add_test(tc_ubx, test_ubx_esf_meas);
   tcase_add_test(tc_ubx, test_ubx_esf_raw);
+  tcase_add_test(tc_ubx, test_ubx_checksum);
+  tcase_add_test(tc_ubx, test_ubx_encode_frame);
   suite_add_tcase(s, tc_ubx);
 
   return s;
@@ -12,6 +12,15 @@
 
 #include "crc_checker.h"
 
+#include <cstring>
+
+#include "read_little_endian.h"
+
+#if defined(__ARM_FEATURE_CRC32) && defined(__aarch64__)
+#include <arm_acle.h>
+#define NOVATEL_HAVE_HW_CRC32 1
+#endif
+
 namespace Novatel {
 
 /**
@@ -31,16 +40,73 @@ uint32_t CrcChecker::crc32_byte_value(uint8_t byte) {
   return crc_temp;
 }
 
-uint32_t CrcChecker::get_crc(const uint8_t *bytes, uint32_t n_bytes) {
+/**
+ * tables[0] is the classic byte-at-a-time table, tables[k][i] is the CRC of
+ * byte i followed by k zero bytes. This lets get_crc_table() fold eight input
+ * bytes with eight independent lookups instead of eight dependent ones.
+ */
+const CrcChecker::Crc32Tables &CrcChecker::crc32_tables() {
+  struct Tables {
+    Crc32Tables values;
+    Tables() : values() {
+      for (uint32_t i = 0; i < 256; i++) {
+        values[0][i] = crc32_byte_value(static_cast<uint8_t>(i));
+      }
+      for (size_t k = 1; k < kCrc32Slices; k++) {
+        for (uint32_t i = 0; i < 256; i++) {
+          uint32_t previous = values[k - 1][i];
+          values[k][i] = (previous >> 8) ^ values[0][previous & 0xFF];
+        }
+      }
+    }
+  };
+  static const Tables tables;
+  return tables.values;
+}
+
+uint32_t CrcChecker::get_crc_table(const uint8_t *bytes, uint32_t n_bytes) {
+  const Crc32Tables &t = crc32_tables();
   uint32_t crc = 0;
 
+  while (n_bytes >= kCrc32Slices) {
+    // frames start at any offset in the parser's buffer, load through memcpy
+    uint64_t word = Util::read_le_uint64(bytes);
+    uint32_t low = static_cast<uint32_t>(word) ^ crc;
+    uint32_t high = static_cast<uint32_t>(word >> 32);
+    crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^
+          t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^ t[3][high & 0xFF] ^
+          t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^
+          t[0][high >> 24];
+    bytes += kCrc32Slices;
+    n_bytes -= kCrc32Slices;
+  }
+
   while (n_bytes-- != 0) {
-    uint32_t temp1 = (crc >> 8) & 0x00FFFFFFL;
-    uint32_t temp2 = crc32_byte_value((crc ^ *bytes++) & 0xFF);
-    crc = temp1 ^ temp2;
+    crc = (crc >> 8) ^ t[0][(crc ^ *bytes++) & 0xFF];
   }
 
   return crc;
 }
 
+uint32_t CrcChecker::get_crc(const uint8_t *bytes, uint32_t n_bytes) {
+#if NOVATEL_HAVE_HW_CRC32
+  // The ACLE intrinsics implement exactly this CRC: same reflected polynomial,
+  // no inversion of the initial value or the result.
+  uint32_t crc = 0;
+  while (n_bytes >= sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, bytes, sizeof(word));
+    crc = __crc32d(crc, Util::kIsBigEndianHost ? bswap_64(word) : word);
+    bytes += sizeof(uint64_t);
+    n_bytes -= sizeof(uint64_t);
+  }
+  while (n_bytes-- != 0) {
+    crc = __crc32b(crc, *bytes++);
+  }
+  return crc;
+#else
+  return get_crc_table(bytes, n_bytes);
+#endif
+}
+
 }  // namespace Novatel
@@ -13,6 +13,7 @@
 #ifndef NOVATEL_PARSER_CRC_CHECKER_H_
 #define NOVATEL_PARSER_CRC_CHECKER_H_
 
+#include <cstddef>
 #include <cstdint>
 
 namespace Novatel {
@@ -21,10 +22,26 @@ class CrcChecker {
  private:
   static constexpr uint32_t kCrc32Polynomial = 0xEDB88320;
 
+  // Number of bytes folded per step of the table driven implementation.
+  static constexpr size_t kCrc32Slices = 8;
+
+  using Crc32Tables = uint32_t[kCrc32Slices][256];
+
   static uint32_t crc32_byte_value(uint8_t byte);
+  static const Crc32Tables &crc32_tables();
 
  public:
+  /**
+   * Novatel CRC-32 (reflected 0x04C11DB7, zero initial value, no final xor).
+   * Uses the ARMv8 CRC32 instructions when the target supports them and
+   * slicing-by-8 lookup tables otherwise.
+   */
   static uint32_t get_crc(const uint8_t *bytes, uint32_t n_bytes);
+
+  /**
+   * Portable slicing-by-8 implementation, always available.
+   */
+  static uint32_t get_crc_table(const uint8_t *bytes, uint32_t n_bytes);
 };
 
 }  // namespace Novatel
@@ -14,6 +14,8 @@
 #define NOVATEL_PARSER_MESSAGE_H_
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 
 #include "binary_header.h"
@@ -50,10 +52,25 @@ enum Id {
  * mycallback.callfn = [&](const BinaryHeader *header, const void *body) {
  *      printf("My callback!\n");
  * };
+ *
+ * Setting view hands the callback a View of the raw message body instead of
+ * the decoded message struct, which skips decoding fields the callback never
+ * looks at.
  */
 struct Callback {
   Id message_id;
   std::function<void(const BinaryHeader *, const void *)> callfn;
+  bool view = false;
+};
+
+/**
+ * Raw message body passed to callbacks registered with Callback::view.
+ * Messages which are expensive to decode in full provide an accessor on top
+ * of it, e.g. RANGECMP_view_t.
+ */
+struct View {
+  const uint8_t *bytes;
+  size_t n_bytes;
 };
 
 using CallbackArray = std::array<Callback, kNumMessageIds>;
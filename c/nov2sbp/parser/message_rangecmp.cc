@@ -25,15 +25,69 @@ namespace Novatel {
  * Constant numbers are taken from the manual:
  * https://www.novatel.com/assets/Documents/Manuals/om-20000129.pdf
  *
+ * Rather than walking the record bit by bit, the 24 byte record is loaded as
+ * three little endian 64 bit words and every field is cut out of its word(s)
+ * with a shift and a mask. Only the pseudorange straddles two words.
+ *
  * Also of note, the signed values require some bitshift trickery to get the
  * proper sign extension.
  */
-void Message::RANGECMP_t::FromBytes(const uint8_t *bytes, size_t n_bytes) {
+namespace {
+
+struct RecordWords {
+  uint64_t lo;   // bits 0 - 63
+  uint64_t mid;  // bits 64 - 127
+  uint64_t hi;   // bits 128 - 191
+
+  explicit RecordWords(const uint8_t *bytes)
+      : lo(Util::read_le_uint64(bytes)),
+        mid(Util::read_le_uint64(bytes + 8)),
+        hi(Util::read_le_uint64(bytes + 16)) {}
+
+  uint32_t tracking_status() const {
+    return static_cast<uint32_t>(Util::word_bits(lo, 0, 32));
+  }
+  int32_t doppler() const {
+    uint32_t doppler_bits = static_cast<uint32_t>(Util::word_bits(lo, 32, 28));
+    return static_cast<int32_t>(doppler_bits << 4) >> 4;
+  }
+  uint64_t pseudorange() const {
+    return Util::word_bits(lo, 60, 4) | (Util::word_bits(mid, 0, 32) << 4);
+  }
+  int32_t ADR() const {
+    return static_cast<int32_t>(Util::word_bits(mid, 32, 32));
+  }
+  uint8_t stddev_psr() const {
+    return static_cast<uint8_t>(Util::word_bits(hi, 0, 4));
+  }
+  uint8_t stddev_adr() const {
+    return static_cast<uint8_t>(Util::word_bits(hi, 4, 4));
+  }
+  uint8_t prn_slot() const {
+    return static_cast<uint8_t>(Util::word_bits(hi, 8, 8));
+  }
+  uint32_t lock_time() const {
+    return static_cast<uint32_t>(Util::word_bits(hi, 16, 21));
+  }
+  uint8_t CN0() const {
+    return static_cast<uint8_t>(Util::word_bits(hi, 37, 5));
+  }
+  uint8_t glo_freq_no() const {
+    return static_cast<uint8_t>(Util::word_bits(hi, 42, 6));
+  }
+  uint16_t reserved() const {
+    return static_cast<uint16_t>(Util::word_bits(hi, 48, 16));
+  }
+};
+
+/**
+ * Read the record count which precedes the records, limited to MAX_CHANNELS.
+ */
+size_t read_n_records(const uint8_t *bytes, size_t n_bytes) {
   (void)n_bytes;
   assert(n_bytes >= sizeof(uint32_t));
 
-  n_records = Util::read_le_uint32(bytes);
-  bytes += sizeof(uint32_t);
+  size_t n_records = Util::read_le_uint32(bytes);
 
   size_t n_record_bytes =
       n_records * Message::RANGECMP_record_t::kRecordBinarySize;
@@ -43,22 +97,66 @@ void Message::RANGECMP_t::FromBytes(const uint8_t *bytes, size_t n_bytes) {
   if (n_records > MAX_CHANNELS) {
     n_records = MAX_CHANNELS;
   }
+  return n_records;
+}
+
+}  // namespace
+
+void Message::RANGECMP_record_t::FromBytes(const uint8_t *bytes) {
+  RecordWords words(bytes);
+  tracking_status = words.tracking_status();
+  doppler = words.doppler();
+  pseudorange = words.pseudorange();
+  ADR = words.ADR();
+  stddev_psr = words.stddev_psr();
+  stddev_adr = words.stddev_adr();
+  prn_slot = words.prn_slot();
+  lock_time = words.lock_time();
+  CN0 = words.CN0();
+  glo_freq_no = words.glo_freq_no();
+  reserved = words.reserved();
+}
+
+void Message::RANGECMP_t::FromBytes(const uint8_t *bytes, size_t n_bytes) {
+  n_records = read_n_records(bytes, n_bytes);
+  bytes += sizeof(uint32_t);
+
+  for (size_t i = 0; i < n_records; ++i) {
+    records[i].FromBytes(bytes);
+    bytes += Message::RANGECMP_record_t::kRecordBinarySize;
+  }
+}
+
+void Message::RANGECMP_view_t::FromBytes(const uint8_t *bytes,
+                                         size_t n_bytes) {
+  n_records = read_n_records(bytes, n_bytes);
+  records = bytes + sizeof(uint32_t);
+}
+
+Message::RANGECMP_record_t Message::RANGECMP_view_t::record(size_t i) const {
+  assert(i < n_records);
+  RANGECMP_record_t record;
+  record.FromBytes(records + i * RANGECMP_record_t::kRecordBinarySize);
+  return record;
+}
+
+void Message::RANGECMP_soa_t::FromBytes(const uint8_t *bytes, size_t n_bytes) {
+  n_records = read_n_records(bytes, n_bytes);
+  bytes += sizeof(uint32_t);
 
   for (size_t i = 0; i < n_records; ++i) {
-    records[i].tracking_status = Novatel::Util::read_le_bits32(bytes, 0, 32);
-    uint32_t doppler_bits = Novatel::Util::read_le_bits32(bytes, 32, 28);
-    records[i].doppler =
-        ((*reinterpret_cast<int32_t *>(&doppler_bits)) << 4) >> 4;  // NOLINT
-    records[i].pseudorange = Novatel::Util::read_le_bits64(bytes, 60, 36);
-    uint32_t ADR_bits = Novatel::Util::read_le_bits32(bytes, 96, 32);
-    records[i].ADR = *reinterpret_cast<int32_t *>(&ADR_bits);  // NOLINT
-    records[i].stddev_psr = Novatel::Util::read_le_bits8(bytes, 128, 4);
-    records[i].stddev_adr = Novatel::Util::read_le_bits8(bytes, 132, 4);
-    records[i].prn_slot = Novatel::Util::read_le_bits8(bytes, 136, 8);
-    records[i].lock_time = Novatel::Util::read_le_bits32(bytes, 144, 21);
-    records[i].CN0 = Novatel::Util::read_le_bits8(bytes, 165, 5);
-    records[i].glo_freq_no = Novatel::Util::read_le_bits8(bytes, 170, 6);
-    records[i].reserved = Novatel::Util::read_le_bits16(bytes, 176, 16);
+    RecordWords words(bytes);
+    tracking_status[i] = words.tracking_status();
+    doppler[i] = words.doppler();
+    pseudorange[i] = words.pseudorange();
+    ADR[i] = words.ADR();
+    stddev_psr[i] = words.stddev_psr();
+    stddev_adr[i] = words.stddev_adr();
+    prn_slot[i] = words.prn_slot();
+    lock_time[i] = words.lock_time();
+    CN0[i] = words.CN0();
+    glo_freq_no[i] = words.glo_freq_no();
+    reserved[i] = words.reserved();
     bytes += Message::RANGECMP_record_t::kRecordBinarySize;
   }
 }
@@ -19,6 +19,8 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "message.h"
+
 namespace Novatel {
 namespace Message {
 
@@ -35,6 +37,11 @@ struct RANGECMP_record_t {
   uint8_t CN0;
   uint8_t glo_freq_no;
   uint16_t reserved;
+
+  /**
+   * Decode a single kRecordBinarySize byte record.
+   */
+  void FromBytes(const uint8_t *bytes);
 };
 
 struct RANGECMP_t {
@@ -44,6 +51,40 @@ struct RANGECMP_t {
   void FromBytes(const uint8_t *bytes, size_t n_bytes);
 };
 
+/**
+ * RANGECMP log decoded into one array per record field, for consumers which
+ * work through a whole epoch one field at a time.
+ */
+struct RANGECMP_soa_t {
+  size_t n_records;
+  std::array<uint32_t, MAX_CHANNELS> tracking_status;
+  std::array<int32_t, MAX_CHANNELS> doppler;
+  std::array<uint64_t, MAX_CHANNELS> pseudorange;
+  std::array<int32_t, MAX_CHANNELS> ADR;
+  std::array<uint8_t, MAX_CHANNELS> stddev_psr;
+  std::array<uint8_t, MAX_CHANNELS> stddev_adr;
+  std::array<uint8_t, MAX_CHANNELS> prn_slot;
+  std::array<uint32_t, MAX_CHANNELS> lock_time;
+  std::array<uint8_t, MAX_CHANNELS> CN0;
+  std::array<uint8_t, MAX_CHANNELS> glo_freq_no;
+  std::array<uint16_t, MAX_CHANNELS> reserved;
+
+  void FromBytes(const uint8_t *bytes, size_t n_bytes);
+};
+
+/**
+ * RANGECMP log left in its raw form, records are only decoded when asked for.
+ * The view does not own the bytes, it is valid as long as the body it was
+ * created from.
+ */
+struct RANGECMP_view_t {
+  size_t n_records;
+  const uint8_t *records;
+
+  void FromBytes(const uint8_t *bytes, size_t n_bytes);
+  RANGECMP_record_t record(size_t i) const;
+};
+
 }  // namespace Message
 }  // namespace Novatel
 
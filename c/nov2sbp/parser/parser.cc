@@ -12,6 +12,7 @@
 
 #include "parser.h"
 
+#include <algorithm>
 #include <cstdarg>
 #include <cstdio>
 #include <cstring>
@@ -49,17 +50,26 @@ Parser::Parser(ReadFunction readfn,
                LogFunction logfn,
                const Message::CallbackArray &callbacks,
                void *context)
-    : num_bytes_in_buffer_(0),
+    : read_offset_(0),
+      write_offset_(0),
+      pending_frame_len_(0),
+      in_sync_(true),
+      num_resyncs_(0),
+      num_crc_failures_(0),
+      num_bytes_discarded_(0),
       readfn_(readfn),
       logfn_(logfn),
       callbacks_{callbacks},
       context_(context) {}
 
 void Parser::process() {
+  int num_bytes_read;
   do {
+    make_room();
+
     // fill buffer_
-    int num_bytes_read = readfn_(buffer_ + num_bytes_in_buffer_,
-                                 sizeof(buffer_) - num_bytes_in_buffer_,
+    num_bytes_read = readfn_(buffer_ + write_offset_,
+                                 kBufferSize - write_offset_,
                                  context_);
 
     if (num_bytes_read < 0) {
@@ -67,93 +77,200 @@ void Parser::process() {
       return;
     }
 
-    num_bytes_in_buffer_ += num_bytes_read;
-    uint32_t num_bytes_consumed = 1;
+    write_offset_ += num_bytes_read;
+
+    // a read which returns nothing means no more input is coming, incomplete
+    // frames left in the buffer can be skipped
+    parse_buffer(num_bytes_read == 0);
+  } while (num_bytes_read > 0);
+}
+
+void Parser::process(const uint8_t *bytes, size_t n_bytes) {
+  while (n_bytes > 0) {
+    make_room();
+
+    size_t n = std::min(n_bytes, kBufferSize - write_offset_);
+    memcpy(buffer_ + write_offset_, bytes, n);
+    write_offset_ += static_cast<uint32_t>(n);
+    bytes += n;
+    n_bytes -= n;
+
+    parse_buffer(false);
+  }
+}
+
+void Parser::flush() { parse_buffer(true); }
+
+/*
+ * Ensure there is space to append input to buffer_
+ */
+void Parser::make_room() {
+  if (read_offset_ == write_offset_) {
+    read_offset_ = 0;
+    write_offset_ = 0;
+  } else if (write_offset_ == kBufferSize) {
+    compact();
+  }
+  // a complete frame always fits, so there is room for at least one byte
+  assert(write_offset_ < kBufferSize);
+}
+
+/*
+ * Parse every complete frame in buffer_, stop at the first incomplete one
+ * unless this is the end of the input
+ */
+void Parser::parse_buffer(bool end_of_input) {
+  while (read_offset_ < write_offset_) {
+    const uint8_t *start = buffer_ + read_offset_;
+    uint32_t num_bytes = write_offset_ - read_offset_;
+
+    // skip straight to the next potential preamble
+    if (start[0] != MSG_REGULAR_PREAMBLE[0]) {
+      const void *preamble = memchr(start, MSG_REGULAR_PREAMBLE[0], num_bytes);
+      read_offset_ += discard(
+          preamble == nullptr
+              ? num_bytes
+              : static_cast<uint32_t>(static_cast<const uint8_t *>(preamble) -
+                                      start));
+      continue;
+    }
 
-    if (num_bytes_in_buffer_ >= sizeof(MSG_REGULAR_PREAMBLE)) {
+    uint32_t num_bytes_consumed = 0;
+    pending_frame_len_ = sizeof(MSG_REGULAR_PREAMBLE);
+    if (num_bytes >= sizeof(MSG_REGULAR_PREAMBLE)) {
       // check for regular preamble (0xAA, 0x44, 0x12)
       if (0 ==
-          memcmp(buffer_, MSG_REGULAR_PREAMBLE, sizeof(MSG_REGULAR_PREAMBLE))) {
-        num_bytes_consumed = parse_regular_message();
+          memcmp(start, MSG_REGULAR_PREAMBLE, sizeof(MSG_REGULAR_PREAMBLE))) {
+        num_bytes_consumed = parse_regular_message(start, num_bytes);
         // check for short preamble (0xAA, 0x44, 0x13)
-      } else if (0 == memcmp(buffer_,
+      } else if (0 == memcmp(start,
                              MSG_SHORT_PREAMBLE,
                              sizeof(MSG_SHORT_PREAMBLE))) {
-        num_bytes_consumed = parse_short_message();
+        num_bytes_consumed = parse_short_message(start, num_bytes);
+      } else {
+        num_bytes_consumed = discard(1);
+      }
+    }
+
+    if (num_bytes_consumed == 0) {
+      if (!end_of_input) {
+        // wait for the rest of the frame, make room for it if necessary
+        if (read_offset_ + pending_frame_len_ > kBufferSize) {
+          compact();
+        }
+        return;
       }
+      num_bytes_consumed = discard(1);
     }
 
-    // drop consumed bytes from buffer_
-    assert(num_bytes_consumed <= num_bytes_in_buffer_);
-    num_bytes_in_buffer_ -= num_bytes_consumed;
-    memmove(buffer_, buffer_ + num_bytes_consumed, num_bytes_in_buffer_);
-  } while (num_bytes_in_buffer_ > 0);
+    assert(num_bytes_consumed <= num_bytes);
+    read_offset_ += num_bytes_consumed;
+  }
 }
 
 /*
- * Attempt to parse buffer_ as a regular Novatel Binary Message, return number
- * of bytes consumed
+ * Move the unparsed bytes to the start of buffer_
  */
-uint32_t Parser::parse_regular_message() const {
-  if (num_bytes_in_buffer_ >= MSG_REGULAR_HEADER_LEN + MSG_CRC_LEN) {
-    // header length is in byte following preamble
-    if (buffer_[sizeof(MSG_REGULAR_PREAMBLE)] == MSG_REGULAR_HEADER_LEN) {
-      BinaryHeaderRegular header;
-      // skip extra byte since 'header' does not include header length
-      header.read(buffer_ + sizeof(MSG_REGULAR_PREAMBLE) + 1);
-
-      if (header.message_len <=
-          num_bytes_in_buffer_ - MSG_REGULAR_HEADER_LEN - MSG_CRC_LEN) {
-        uint32_t crc_expected = Util::read_le_uint32(
-            &buffer_[MSG_REGULAR_HEADER_LEN + header.message_len]);
-        uint32_t crc_calculated = CrcChecker::get_crc(
-            buffer_, MSG_REGULAR_HEADER_LEN + header.message_len);
-        if (crc_expected == crc_calculated) {
-          parse_body(header, buffer_ + MSG_REGULAR_HEADER_LEN);
-          return MSG_REGULAR_HEADER_LEN + MSG_CRC_LEN + header.message_len;
-        }
-        warn("Unexpected CRC %.8x vs %.8x", crc_expected, crc_calculated);
-      } else {
-        warn("Unexpectedly large message length %i", header.message_len);
-      }
-    } else {
-      warn("Unexpected header length %i",
-           buffer_[sizeof(MSG_REGULAR_PREAMBLE)]);
-    }
+void Parser::compact() {
+  uint32_t num_bytes = write_offset_ - read_offset_;
+  memmove(buffer_, buffer_ + read_offset_, num_bytes);
+  read_offset_ = 0;
+  write_offset_ = num_bytes;
+}
+
+/*
+ * Account for bytes which are skipped while looking for the next frame,
+ * returns num_bytes
+ */
+uint32_t Parser::discard(uint32_t num_bytes) {
+  if (in_sync_) {
+    num_resyncs_++;
+    in_sync_ = false;
+  }
+  num_bytes_discarded_ += num_bytes;
+  return num_bytes;
+}
+
+/*
+ * Attempt to parse frame as a regular Novatel Binary Message, return number
+ * of bytes consumed or 0 if the frame is incomplete
+ */
+uint32_t Parser::parse_regular_message(const uint8_t *frame,
+                                       uint32_t num_bytes) {
+  pending_frame_len_ = MSG_REGULAR_HEADER_LEN + MSG_CRC_LEN;
+  if (num_bytes < pending_frame_len_) {
+    return 0;
+  }
+
+  // header length is in byte following preamble
+  if (frame[sizeof(MSG_REGULAR_PREAMBLE)] != MSG_REGULAR_HEADER_LEN) {
+    warn("Unexpected header length %i", frame[sizeof(MSG_REGULAR_PREAMBLE)]);
+    // parsing failed, drop 1 byte and try again
+    return discard(1);
+  }
+
+  BinaryHeaderRegular header;
+  // skip extra byte since 'header' does not include header length
+  header.read(frame + sizeof(MSG_REGULAR_PREAMBLE) + 1);
+
+  pending_frame_len_ =
+      MSG_REGULAR_HEADER_LEN + header.message_len + MSG_CRC_LEN;
+  if (pending_frame_len_ > kBufferSize) {
+    warn("Unexpectedly large message length %i", header.message_len);
+    return discard(1);
+  }
+  if (num_bytes < pending_frame_len_) {
+    return 0;
+  }
+
+  uint32_t crc_expected =
+      Util::read_le_uint32(&frame[MSG_REGULAR_HEADER_LEN + header.message_len]);
+  uint32_t crc_calculated =
+      CrcChecker::get_crc(frame, MSG_REGULAR_HEADER_LEN + header.message_len);
+  if (crc_expected != crc_calculated) {
+    warn("Unexpected CRC %.8x vs %.8x", crc_expected, crc_calculated);
+    num_crc_failures_++;
+    return discard(1);
   }
 
-  // parsing failed, drop 1 byte and try again
-  return 1;
+  in_sync_ = true;
+  parse_body(header, frame + MSG_REGULAR_HEADER_LEN);
+  return pending_frame_len_;
 }
 
 /*
- * Attempt to parse buffer_ as a short Novatel Binary Message, return number
- * of bytes consumed
+ * Attempt to parse frame as a short Novatel Binary Message, return number
+ * of bytes consumed or 0 if the frame is incomplete
  */
-uint32_t Parser::parse_short_message() const {
-  if (num_bytes_in_buffer_ >= MSG_SHORT_HEADER_LEN + MSG_CRC_LEN) {
-    BinaryHeaderShort header;
-    header.read(buffer_ + sizeof(MSG_SHORT_PREAMBLE));
-
-    if (header.message_len <=
-        num_bytes_in_buffer_ - MSG_SHORT_HEADER_LEN - MSG_CRC_LEN) {
-      uint32_t crc_expected = Util::read_le_uint32(
-          &buffer_[MSG_SHORT_HEADER_LEN + header.message_len]);
-      uint32_t crc_calculated = CrcChecker::get_crc(
-          buffer_, MSG_SHORT_HEADER_LEN + header.message_len);
-
-      if (crc_expected == crc_calculated) {
-        parse_body(header, buffer_ + MSG_SHORT_HEADER_LEN);
-        return MSG_SHORT_HEADER_LEN + MSG_CRC_LEN + header.message_len;
-      }
-      warn("Unexpected CRC %.8x vs %.8x", crc_expected, crc_calculated);
-    } else {
-      warn("Unexpectedly large message length %i", header.message_len);
-    }
+uint32_t Parser::parse_short_message(const uint8_t *frame,
+                                     uint32_t num_bytes) {
+  pending_frame_len_ = MSG_SHORT_HEADER_LEN + MSG_CRC_LEN;
+  if (num_bytes < pending_frame_len_) {
+    return 0;
+  }
+
+  BinaryHeaderShort header;
+  header.read(frame + sizeof(MSG_SHORT_PREAMBLE));
+
+  // a short message length is a single byte so it always fits into buffer_
+  pending_frame_len_ = MSG_SHORT_HEADER_LEN + header.message_len + MSG_CRC_LEN;
+  if (num_bytes < pending_frame_len_) {
+    return 0;
+  }
+
+  uint32_t crc_expected =
+      Util::read_le_uint32(&frame[MSG_SHORT_HEADER_LEN + header.message_len]);
+  uint32_t crc_calculated =
+      CrcChecker::get_crc(frame, MSG_SHORT_HEADER_LEN + header.message_len);
+  if (crc_expected != crc_calculated) {
+    warn("Unexpected CRC %.8x vs %.8x", crc_expected, crc_calculated);
+    num_crc_failures_++;
+    return discard(1);
   }
 
-  // parsing failed, drop 1 byte and try again
-  return 1;
+  in_sync_ = true;
+  parse_body(header, frame + MSG_SHORT_HEADER_LEN);
+  return pending_frame_len_;
 }
 
 /**
@@ -161,6 +278,24 @@ uint32_t Parser::parse_short_message() const {
  * message ID.
  */
 void Parser::parse_body(const BinaryHeader &header, const uint8_t *data) const {
+  // view callbacks get the raw body, the message is only decoded if some
+  // other callback wants it
+  bool decode = false;
+  const Message::View view{data, header.message_len};
+  for (const auto &callback : callbacks_) {
+    if (callback.message_id != header.message_id || !callback.callfn) {
+      continue;
+    }
+    if (callback.view) {
+      callback.callfn(&header, &view);
+    } else {
+      decode = true;
+    }
+  }
+  if (!decode) {
+    return;
+  }
+
   switch (header.message_id) {
     case Message::Id::GPSEPHEM: {
       Message::GPSEPHEM_t msg;
@@ -218,7 +353,8 @@ void Parser::parse_body(const BinaryHeader &header, const uint8_t *data) const {
 void Parser::invoke_callback(const BinaryHeader &header,
                              const void *data) const {
   for (const auto &callback : callbacks_) {
-    if (callback.message_id == header.message_id && callback.callfn) {
+    if (callback.message_id == header.message_id && callback.callfn &&
+        !callback.view) {
       callback.callfn(&header, data);
     }
   }
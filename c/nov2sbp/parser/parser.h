@@ -49,6 +49,36 @@ class Parser {
    */
   void process();
 
+  /**
+   * Parse a chunk of input handed in by the caller instead of pulling it
+   * through the read function. Callbacks fire for every frame completed by
+   * the chunk, an incomplete frame at the end is kept for the next call.
+   */
+  void process(const uint8_t *bytes, size_t n_bytes);
+
+  /**
+   * Signal the end of the input handed in through process(bytes, n_bytes).
+   * Bytes held back for an incomplete frame are rescanned for complete
+   * frames and dropped.
+   */
+  void flush();
+
+  /**
+   * Number of times the parser lost synchronisation, i.e. had to skip bytes
+   * which were not part of a valid frame.
+   */
+  uint32_t num_resyncs() const { return num_resyncs_; }
+
+  /**
+   * Number of complete frames dropped because of a CRC mismatch.
+   */
+  uint32_t num_crc_failures() const { return num_crc_failures_; }
+
+  /**
+   * Total number of bytes skipped while resynchronising.
+   */
+  size_t num_bytes_discarded() const { return num_bytes_discarded_; }
+
  private:
   /**
    * Long enough to hold either a header (up to 256 bytes),
@@ -59,7 +89,20 @@ class Parser {
    */
   static constexpr size_t kBufferSize = 4096;
   uint8_t buffer_[kBufferSize];
-  uint32_t num_bytes_in_buffer_;
+
+  // buffer_[read_offset_, write_offset_) holds the bytes not parsed yet. The
+  // data is only moved back to the start of buffer_ when the frame at
+  // read_offset_ would not fit otherwise.
+  uint32_t read_offset_;
+  uint32_t write_offset_;
+
+  // Length of the incomplete frame at read_offset_, as far as it is known.
+  uint32_t pending_frame_len_;
+
+  bool in_sync_;
+  uint32_t num_resyncs_;
+  uint32_t num_crc_failures_;
+  size_t num_bytes_discarded_;
 
   ReadFunction readfn_;
   LogFunction logfn_;
@@ -68,8 +111,12 @@ class Parser {
 
   void *context_;
 
-  uint32_t parse_regular_message() const;
-  uint32_t parse_short_message() const;
+  void parse_buffer(bool end_of_input);
+  void make_room();
+  void compact();
+  uint32_t discard(uint32_t num_bytes);
+  uint32_t parse_regular_message(const uint8_t *frame, uint32_t num_bytes);
+  uint32_t parse_short_message(const uint8_t *frame, uint32_t num_bytes);
   void parse_body(const BinaryHeader &header, const uint8_t *data) const;
   void invoke_callback(const BinaryHeader &header, const void *data) const;
   void warn(const char *format, ...) const SWIFT_ATTR_FORMAT(2, 3);
@@ -30,6 +30,7 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 
 namespace Novatel {
 
@@ -54,6 +55,13 @@ static inline uint32_t read_le_uint32(const uint8_t *bytes) {
   return _le32toh(*reinterpret_cast<const uint32_t *>(bytes));
 }
 
+static inline uint64_t read_le_uint64(const uint8_t *bytes) {
+  // memcpy rather than a cast since packed records put words at any offset
+  uint64_t le;
+  memcpy(&le, bytes, sizeof(le));
+  return _le64toh(le);
+}
+
 static inline int32_t read_le_int32(const uint8_t *bytes) {
   // NOLINTNEXTLINE
   uint32_t swapped = _le32toh(*reinterpret_cast<const uint32_t *>(bytes));
@@ -113,6 +121,21 @@ static inline uint32_t read_le_bits32(const uint8_t *bytes,
   return static_cast<uint32_t>(read_le_bits64(bytes, bit_offset, n_bits));
 }
 
+/**
+ * Extract n_bits starting at bit_offset from a word loaded with one of the
+ * read_le_uint* functions. Equivalent to read_le_bits64 on the original
+ * bytes, but a handful of instructions rather than a loop over the bits.
+ */
+static inline uint64_t word_bits(uint64_t word,
+                                 size_t bit_offset,
+                                 size_t n_bits) {
+  assert(n_bits <= 64 && bit_offset + n_bits <= 64);
+  if (n_bits == 0) {
+    return 0;
+  }
+  return (word >> bit_offset) & (~0ULL >> (64 - n_bits));
+}
+
 static inline uint16_t _le16toh(uint16_t le) {
   if (kIsBigEndianHost) {
     return bswap_16(le);
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026 Swift Navigation Inc.
+ * Contact: Swift Navigation <dev@swift-nav.com>
+ *
+ * This source is subject to the license found in the file 'LICENSE' which must
+ * be be distributed together with this source. All other rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <random>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "crc_checker.h"
+
+// Bit at a time implementation from the Novatel manual, used as the reference.
+static uint32_t reference_crc(const uint8_t *bytes, uint32_t n_bytes) {
+  uint32_t crc = 0;
+  while (n_bytes-- != 0) {
+    uint32_t value = (crc ^ *bytes++) & 0xFF;
+    for (int j = 8; j > 0; j--) {
+      value = (value & 1) != 0 ? (value >> 1) ^ 0xEDB88320 : value >> 1;
+    }
+    crc = ((crc >> 8) & 0x00FFFFFF) ^ value;
+  }
+  return crc;
+}
+
+TEST_CASE("CRC of known data.") {
+  const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+  REQUIRE(0x2DFD2D88 == Novatel::CrcChecker::get_crc(check, sizeof(check)));
+  REQUIRE(0x2DFD2D88 ==
+          Novatel::CrcChecker::get_crc_table(check, sizeof(check)));
+  REQUIRE(0 == Novatel::CrcChecker::get_crc(check, 0));
+}
+
+TEST_CASE("CRC matches the reference on random buffers.") {
+  std::mt19937 generator(0x4E4F5641);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::vector<uint8_t> buffer(4096 + 8);
+  for (auto &value : buffer) {
+    value = static_cast<uint8_t>(byte(generator));
+  }
+
+  // Every length up to a few slices and every misalignment of the start.
+  for (uint32_t offset = 0; offset < 8; offset++) {
+    for (uint32_t length = 0; length < 300; length++) {
+      uint32_t expected = reference_crc(&buffer[offset], length);
+      REQUIRE(expected ==
+              Novatel::CrcChecker::get_crc_table(&buffer[offset], length));
+      REQUIRE(expected ==
+              Novatel::CrcChecker::get_crc(&buffer[offset], length));
+    }
+  }
+
+  std::uniform_int_distribution<uint32_t> length(0, 4096);
+  for (int i = 0; i < 200; i++) {
+    uint32_t n_bytes = length(generator);
+    uint32_t expected = reference_crc(buffer.data(), n_bytes);
+    REQUIRE(expected == Novatel::CrcChecker::get_crc(buffer.data(), n_bytes));
+  }
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026 Swift Navigation Inc.
+ * Contact: Swift Navigation <dev@swift-nav.com>
+ *
+ * This source is subject to the license found in the file 'LICENSE' which must
+ * be be distributed together with this source. All other rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "message_rangecmp.h"
+#include "read_little_endian.h"
+
+namespace Novatel {
+
+// Bit by bit decoding of a record, as laid out in the manual.
+static Message::RANGECMP_record_t reference_record(const uint8_t *bytes) {
+  Message::RANGECMP_record_t record;
+  record.tracking_status = Util::read_le_bits32(bytes, 0, 32);
+  uint32_t doppler_bits = Util::read_le_bits32(bytes, 32, 28);
+  record.doppler = static_cast<int32_t>(doppler_bits << 4) >> 4;
+  record.pseudorange = Util::read_le_bits64(bytes, 60, 36);
+  record.ADR = static_cast<int32_t>(Util::read_le_bits32(bytes, 96, 32));
+  record.stddev_psr = Util::read_le_bits8(bytes, 128, 4);
+  record.stddev_adr = Util::read_le_bits8(bytes, 132, 4);
+  record.prn_slot = Util::read_le_bits8(bytes, 136, 8);
+  record.lock_time = Util::read_le_bits32(bytes, 144, 21);
+  record.CN0 = Util::read_le_bits8(bytes, 165, 5);
+  record.glo_freq_no = Util::read_le_bits8(bytes, 170, 6);
+  record.reserved = Util::read_le_bits16(bytes, 176, 16);
+  return record;
+}
+
+// RANGECMP body with n_records random records
+static std::vector<uint8_t> make_rangecmp(uint32_t n_records,
+                                          std::mt19937 *generator) {
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::vector<uint8_t> body(
+      sizeof(uint32_t) +
+      n_records * Message::RANGECMP_record_t::kRecordBinarySize);
+  for (auto &value : body) {
+    value = static_cast<uint8_t>(byte(*generator));
+  }
+  for (size_t i = 0; i < sizeof(uint32_t); i++) {
+    body[i] = static_cast<uint8_t>(n_records >> (8 * i));
+  }
+  return body;
+}
+
+TEST_CASE("RANGECMP records match the bitwise reference.") {
+  std::mt19937 generator(0x52414E47);
+  auto rangecmp = std::make_unique<Message::RANGECMP_t>();
+  auto soa = std::make_unique<Message::RANGECMP_soa_t>();
+  Message::RANGECMP_view_t view;
+
+  for (uint32_t n_records = 0; n_records <= MAX_CHANNELS; n_records++) {
+    std::vector<uint8_t> body = make_rangecmp(n_records, &generator);
+    rangecmp->FromBytes(body.data(), body.size());
+    soa->FromBytes(body.data(), body.size());
+    view.FromBytes(body.data(), body.size());
+    REQUIRE(rangecmp->n_records == n_records);
+    REQUIRE(soa->n_records == n_records);
+    REQUIRE(view.n_records == n_records);
+
+    for (size_t i = 0; i < n_records; i++) {
+      const uint8_t *bytes =
+          &body[sizeof(uint32_t) +
+                i * Message::RANGECMP_record_t::kRecordBinarySize];
+      Message::RANGECMP_record_t expected = reference_record(bytes);
+      const Message::RANGECMP_record_t &record = rangecmp->records[i];
+
+      REQUIRE(record.tracking_status == expected.tracking_status);
+      REQUIRE(record.doppler == expected.doppler);
+      REQUIRE(record.pseudorange == expected.pseudorange);
+      REQUIRE(record.ADR == expected.ADR);
+      REQUIRE(record.stddev_psr == expected.stddev_psr);
+      REQUIRE(record.stddev_adr == expected.stddev_adr);
+      REQUIRE(record.prn_slot == expected.prn_slot);
+      REQUIRE(record.lock_time == expected.lock_time);
+      REQUIRE(record.CN0 == expected.CN0);
+      REQUIRE(record.glo_freq_no == expected.glo_freq_no);
+      REQUIRE(record.reserved == expected.reserved);
+
+      REQUIRE(soa->tracking_status[i] == expected.tracking_status);
+      REQUIRE(soa->doppler[i] == expected.doppler);
+      REQUIRE(soa->pseudorange[i] == expected.pseudorange);
+      REQUIRE(soa->ADR[i] == expected.ADR);
+      REQUIRE(soa->stddev_psr[i] == expected.stddev_psr);
+      REQUIRE(soa->stddev_adr[i] == expected.stddev_adr);
+      REQUIRE(soa->prn_slot[i] == expected.prn_slot);
+      REQUIRE(soa->lock_time[i] == expected.lock_time);
+      REQUIRE(soa->CN0[i] == expected.CN0);
+      REQUIRE(soa->glo_freq_no[i] == expected.glo_freq_no);
+      REQUIRE(soa->reserved[i] == expected.reserved);
+
+      Message::RANGECMP_record_t viewed = view.record(i);
+      REQUIRE(viewed.tracking_status == expected.tracking_status);
+      REQUIRE(viewed.doppler == expected.doppler);
+      REQUIRE(viewed.pseudorange == expected.pseudorange);
+      REQUIRE(viewed.ADR == expected.ADR);
+      REQUIRE(viewed.stddev_psr == expected.stddev_psr);
+      REQUIRE(viewed.stddev_adr == expected.stddev_adr);
+      REQUIRE(viewed.prn_slot == expected.prn_slot);
+      REQUIRE(viewed.lock_time == expected.lock_time);
+      REQUIRE(viewed.CN0 == expected.CN0);
+      REQUIRE(viewed.glo_freq_no == expected.glo_freq_no);
+      REQUIRE(viewed.reserved == expected.reserved);
+    }
+  }
+}
+
+}  // namespace Novatel
@@ -10,11 +10,16 @@
  * WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR PURPOSE.
  */
 
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
+#include <cstring>
+#include <vector>
 
 #include "catch/catch.hpp"
+#include "crc_checker.h"
 #include "message_gloephemeris.h"
+#include "message_insatt.h"
 #include "parser.h"
 
 static void logfn(const char *msg) { printf("%s\n", msg); }
@@ -43,6 +48,19 @@ static void count_message(const BinaryHeader *header, const void *data) {
   num_messages++;
 }
 
+static std::vector<uint8_t> read_file(const char *path) {
+  FILE *f = fopen(path, "r");
+  assert(f);
+  std::vector<uint8_t> bytes;
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+    bytes.insert(bytes.end(), buf, buf + n);
+  }
+  fclose(f);
+  return bytes;
+}
+
 TEST_CASE("Will it run?") {
   Message::CallbackArray callbacks{{
       Message::Callback{Message::GPSEPHEM, count_message},
@@ -52,7 +70,213 @@ TEST_CASE("Will it run?") {
   }};
   Parser parser{readfn, logfn, callbacks, nullptr};
   parser.process();
+  int num_read_messages = num_messages;
+
+  // The whole file handed over in one go, so no frame can straddle a read.
+  num_messages = 0;
+  std::vector<uint8_t> bytes = read_file(UNIT_TEST_DATA_PATH "/novatel.bin");
+  Parser push_parser{nullptr, logfn, callbacks, nullptr};
+  push_parser.process(bytes.data(), bytes.size());
+  push_parser.flush();
+
+  // The read error at the end of the file only drops a trailing incomplete
+  // frame, so both parses see every complete frame of the file. Before the
+  // in place parser the read error also dropped the last buffer's worth of
+  // complete frames, 5701 is the count from that time.
+  REQUIRE(num_read_messages == num_messages);
+  REQUIRE(num_read_messages >= 5701);
+  REQUIRE(parser.num_crc_failures() == 0);
+}
+
+// Short binary INSATT frame with a valid CRC
+static std::vector<uint8_t> make_short_insatt(uint32_t week) {
+  std::vector<uint8_t> frame = {0xAA, 0x44, 0x13, 40, 0x07, 0x01};
+  frame.resize(12 + 40);
+  memcpy(&frame[12], &week, sizeof(week));
+  uint32_t crc = CrcChecker::get_crc(frame.data(), frame.size());
+  for (int i = 0; i < 4; i++) {
+    frame.push_back(static_cast<uint8_t>(crc >> (8 * i)));
+  }
+  return frame;
+}
+
+struct Stream {
+  std::vector<uint8_t> bytes;
+  size_t offset;
+  size_t max_read;
+  // fail the read at the end of the input rather than return 0
+  bool read_error_at_end;
+};
+
+// Hands out the stream in small pieces to exercise frames split across reads
+static int read_stream(uint8_t *buf, uint32_t n_bytes, void *context) {
+  auto *stream = static_cast<Stream *>(context);
+  if (stream->read_error_at_end && stream->offset == stream->bytes.size()) {
+    return -1;
+  }
+  size_t n = std::min({static_cast<size_t>(n_bytes),
+                       stream->max_read,
+                       stream->bytes.size() - stream->offset});
+  memcpy(buf, &stream->bytes[stream->offset], n);
+  stream->offset += n;
+  return static_cast<int>(n);
+}
+
+static std::vector<uint32_t> insatt_weeks;
+static void record_insatt(const BinaryHeader *header, const void *data) {
+  (void)header;
+  const auto *insatt = static_cast<const Message::INSATT_t *>(data);
+  insatt_weeks.push_back(insatt->gnss_week);
+}
+
+TEST_CASE("Resynchronise on corrupted and foreign data.") {
+  Stream stream{{}, 0, 0, false};
+  auto append = [&stream](const std::vector<uint8_t> &bytes) {
+    stream.bytes.insert(stream.bytes.end(), bytes.begin(), bytes.end());
+  };
+
+  // Foreign data long enough to fill the buffer several times over, with a
+  // few stray preamble bytes.
+  std::vector<uint8_t> garbage(10000, 0x55);
+  garbage[100] = 0xAA;
+  garbage[5000] = 0xAA;
+  garbage[5001] = 0x44;
+  append(garbage);
+  append(make_short_insatt(1));
+  std::vector<uint8_t> corrupted = make_short_insatt(2);
+  corrupted[20] ^= 0xFF;
+  append(corrupted);
+  append(make_short_insatt(3));
+  append(make_short_insatt(4));
+  // truncated frame at the end of the input
+  std::vector<uint8_t> truncated = make_short_insatt(5);
+  truncated.resize(30);
+  append(truncated);
+
+  Message::CallbackArray callbacks{{
+      Message::Callback{Message::INSATT, record_insatt},
+  }};
+
+  // Frames split across reads as well as frames which need the buffer to be
+  // compacted.
+  for (size_t max_read : {1, 7, 1000, 4096}) {
+    stream.offset = 0;
+    stream.max_read = max_read;
+    insatt_weeks.clear();
+
+    Parser parser{read_stream, nullptr, callbacks, &stream};
+    parser.process();
+
+    REQUIRE(insatt_weeks == std::vector<uint32_t>{1, 3, 4});
+    REQUIRE(parser.num_crc_failures() == 1);
+    REQUIRE(parser.num_resyncs() == 3);
+    REQUIRE(parser.num_bytes_discarded() ==
+            garbage.size() + corrupted.size() + truncated.size());
+  }
+}
+
+TEST_CASE("Parse every complete frame before a read error.") {
+  Stream stream{{}, 0, 0, true};
+  for (uint32_t week = 1; week <= 200; week++) {
+    std::vector<uint8_t> frame = make_short_insatt(week);
+    stream.bytes.insert(stream.bytes.end(), frame.begin(), frame.end());
+  }
+  std::vector<uint8_t> truncated = make_short_insatt(201);
+  truncated.resize(30);
+  stream.bytes.insert(stream.bytes.end(), truncated.begin(), truncated.end());
+
+  Message::CallbackArray callbacks{{
+      Message::Callback{Message::INSATT, record_insatt},
+  }};
+
+  // the frames fill the buffer several times over
+  for (size_t max_read : {7, 4096}) {
+    stream.offset = 0;
+    stream.max_read = max_read;
+    insatt_weeks.clear();
+
+    Parser parser{read_stream, nullptr, callbacks, &stream};
+    parser.process();
+
+    REQUIRE(insatt_weeks.size() == 200);
+    REQUIRE(insatt_weeks.back() == 200);
+    REQUIRE(parser.num_crc_failures() == 0);
+  }
+}
+
+TEST_CASE("Parse input pushed in chunks.") {
+  std::vector<uint8_t> bytes(5000, 0x55);
+  auto append = [&bytes](const std::vector<uint8_t> &frame) {
+    bytes.insert(bytes.end(), frame.begin(), frame.end());
+  };
+  append(make_short_insatt(1));
+  append(make_short_insatt(2));
+  append(make_short_insatt(3));
+  std::vector<uint8_t> truncated = make_short_insatt(4);
+  truncated.resize(30);
+  append(truncated);
+
+  Message::CallbackArray callbacks{{
+      Message::Callback{Message::INSATT, record_insatt},
+  }};
+
+  // chunks smaller than a frame as well as chunks larger than the buffer
+  for (size_t chunk_size : {1, 7, 1000, 20000}) {
+    insatt_weeks.clear();
+
+    Parser parser{nullptr, nullptr, callbacks, nullptr};
+    for (size_t offset = 0; offset < bytes.size(); offset += chunk_size) {
+      parser.process(&bytes[offset],
+                     std::min(chunk_size, bytes.size() - offset));
+    }
+    REQUIRE(insatt_weeks == std::vector<uint32_t>{1, 2, 3});
+    REQUIRE(parser.num_bytes_discarded() == 5000);
+
+    // the truncated frame is only given up on at the end of the input
+    parser.flush();
+    REQUIRE(insatt_weeks == std::vector<uint32_t>{1, 2, 3});
+    REQUIRE(parser.num_resyncs() == 2);
+    REQUIRE(parser.num_bytes_discarded() == 5000 + truncated.size());
+  }
+}
 
-  REQUIRE(num_messages == 5701);
+TEST_CASE("View callbacks receive the raw body.") {
+  std::vector<uint8_t> bytes;
+  for (uint32_t week : {1, 2}) {
+    std::vector<uint8_t> frame = make_short_insatt(week);
+    bytes.insert(bytes.end(), frame.begin(), frame.end());
+  }
+
+  std::vector<uint32_t> viewed_weeks;
+  auto record_view = [&viewed_weeks](const BinaryHeader *header,
+                                     const void *data) {
+    const auto *view = static_cast<const Message::View *>(data);
+    REQUIRE(view->n_bytes == header->message_len);
+    REQUIRE(view->n_bytes == 40);
+    uint32_t week;
+    memcpy(&week, view->bytes, sizeof(week));
+    viewed_weeks.push_back(week);
+  };
+
+  // only view callbacks, the message is never decoded
+  insatt_weeks.clear();
+  Message::CallbackArray view_only{{
+      Message::Callback{Message::INSATT, record_view, true},
+  }};
+  Parser view_parser{nullptr, nullptr, view_only, nullptr};
+  view_parser.process(bytes.data(), bytes.size());
+  REQUIRE(viewed_weeks == std::vector<uint32_t>{1, 2});
+  REQUIRE(insatt_weeks.empty());
+
+  // view and decoded callbacks for the same message
+  viewed_weeks.clear();
+  Message::CallbackArray mixed{{
+      Message::Callback{Message::INSATT, record_view, true},
+      Message::Callback{Message::INSATT, record_insatt},
+  }};
+  Parser mixed_parser{nullptr, nullptr, mixed, nullptr};
+  mixed_parser.process(bytes.data(), bytes.size());
+  REQUIRE(viewed_weeks == std::vector<uint32_t>{1, 2});
+  REQUIRE(insatt_weeks == std::vector<uint32_t>{1, 2});
 }
 }  // namespace Novatel
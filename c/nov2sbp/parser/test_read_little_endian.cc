@@ -59,3 +59,15 @@ TEST_CASE("Read bits.") {
 TEST_CASE("Read a negative number.") {
   REQUIRE(-16711936 == Novatel::Util::read_le_int32(test_bytes + 1));
 }
+
+TEST_CASE("Read bits out of a word.") {
+  const uint64_t word = Novatel::Util::read_le_uint64(test_bytes);
+  REQUIRE(0x00FFFFFF00FF00FFULL == word);
+
+  for (size_t offset = 0; offset < 64; offset++) {
+    for (size_t n_bits = 0; offset + n_bits <= 64; n_bits++) {
+      REQUIRE(Novatel::Util::read_le_bits64(test_bytes, offset, n_bits) ==
+              Novatel::Util::word_bits(word, offset, n_bits));
+    }
+  }
+}
@@ -29,6 +29,44 @@ int nov2sbp(int argc,
             readfn_ptr,
             writefn_ptr,
             void *);
+
+/**
+ * C interface to Novatel::Nov2SbpConverter, one handle per receiver.
+ */
+typedef struct nov2sbp_converter nov2sbp_converter_t;
+
+/**
+ * Returned by nov2sbp_converter_process() and nov2sbp_converter_flush() when
+ * the conversion failed, e.g. because memory ran out. *sbp is NULL in that
+ * case and the handle should be deleted.
+ */
+#define NOV2SBP_CONVERTER_ERROR SIZE_MAX
+
+/**
+ * @return a new converter handle, NULL if it could not be allocated
+ */
+nov2sbp_converter_t *nov2sbp_converter_new(void);
+void nov2sbp_converter_delete(nov2sbp_converter_t *converter);
+
+/**
+ * Convert the next chunk of a Novatel stream, see
+ * Novatel::Nov2SbpConverter::process(). On return *sbp points at the
+ * produced SBP bytes, which stay valid until the next call on the handle.
+ *
+ * @return number of SBP bytes at *sbp, NOV2SBP_CONVERTER_ERROR on failure
+ */
+size_t nov2sbp_converter_process(nov2sbp_converter_t *converter,
+                                 const uint8_t *data,
+                                 size_t length,
+                                 const uint8_t **sbp);
+
+/**
+ * Signal the end of the stream, see Novatel::Nov2SbpConverter::flush().
+ *
+ * @return number of SBP bytes at *sbp, NOV2SBP_CONVERTER_ERROR on failure
+ */
+size_t nov2sbp_converter_flush(nov2sbp_converter_t *converter,
+                               const uint8_t **sbp);
 }
 
 #endif  // NOV2SBP_INTERNAL_NOV2SBP_H
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2026 Swift Navigation Inc.
+ * Contact: Swift Navigation <dev@swift-nav.com>
+ *
+ * This source is subject to the license found in the file 'LICENSE' which must
+ * be be distributed together with this source. All other rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#ifndef NOV2SBP_INTERNAL_NOV2SBP_CONVERTER_H
+#define NOV2SBP_INTERNAL_NOV2SBP_CONVERTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Novatel {
+
+/**
+ * Converts a Novatel binary stream into SBP.
+ *
+ * Every instance owns its parser, SBP framing and time tracking state, so
+ * any number of receivers can be converted side by side in one process. An
+ * instance must not be used from more than one thread at a time.
+ */
+class Nov2SbpConverter {
+ public:
+  /**
+   * View of the SBP bytes produced by a call to process().
+   */
+  struct Bytes {
+    const uint8_t *data;
+    size_t size;
+  };
+
+  Nov2SbpConverter();
+  ~Nov2SbpConverter();
+
+  Nov2SbpConverter(const Nov2SbpConverter &) = delete;
+  Nov2SbpConverter &operator=(const Nov2SbpConverter &) = delete;
+
+  /**
+   * Convert the next chunk of the Novatel stream. Chunks may split frames
+   * anywhere, incomplete frames are held back until the rest arrives.
+   *
+   * @return SBP frames for every Novatel message completed by this chunk. The
+   * bytes are owned by the converter and stay valid until the next call.
+   */
+  Bytes process(const uint8_t *data, size_t length);
+
+  /**
+   * Signal the end of the stream, frames still held back are converted or
+   * dropped. The returned bytes follow the same rules as for process().
+   */
+  Bytes flush();
+
+  /**
+   * Statistics of the underlying Novatel parser.
+   */
+  uint32_t num_resyncs() const;
+  uint32_t num_crc_failures() const;
+  size_t num_bytes_discarded() const;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace Novatel
+
+#endif  // NOV2SBP_INTERNAL_NOV2SBP_CONVERTER_H
@@ -0,0 +1,390 @@
+/*
+ * Copyright (C) 2026 Swift Navigation Inc.
+ * Contact: Swift Navigation <dev@swift-nav.com>
+ *
+ * This source is subject to the license found in the file 'LICENSE' which must
+ * be be distributed together with this source. All other rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <nov2sbp/internal/nov2sbp.h>
+#include <nov2sbp/internal/nov2sbp_converter.h>
+#include <swiftnav/logging.h>
+
+#include <exception>
+#include <new>
+#include <vector>
+
+#include "parser/novatel.h"
+#include "swiftnav_conversion_helpers.h"
+
+static void logfn(const char *msg) { log_warn("%s", msg); }
+
+namespace Novatel {
+
+// Arbitrarily chosen sender ID for the Novatel device.
+static constexpr uint16_t kNovatelSbpSenderId = 5000;
+
+/**
+ * Given an array of mini navmeas types, send as many sbp obs messages
+ * as necessary to convey all of the information.
+ *
+ * This function is an amalgam of code shamelessly lifted from PFWP.
+ * It is all duplicated code, and not very pretty so it lives in a separate
+ * file.
+ */
+extern "C" void send_sbp_obs_messages(uint8_t n,
+                                      const mini_navigation_measurement_t *nm,
+                                      const gps_time_t *gps_time,
+                                      void (*send_sbp)(uint32_t,
+                                                       size_t,
+                                                       uint8_t *,
+                                                       void *),
+                                      void *context);
+
+// used to track the last known time from various messages
+// (note: use msg_gps_time_t instead of gps_time_t since gps_time_t
+// stores tow as a double)
+typedef struct timestamps_t {
+  // time sent in last SBP_MSG_GPS_TIME message
+  msg_gps_time_t gps_time;
+  // time of last received RAWIMUSX_t message
+  msg_gps_time_t imu_recv_time;
+  // time of last sent SBP_MSG_IMU_AUX message
+  msg_gps_time_t imu_aux_time;
+} timestamps_t;
+
+struct Nov2SbpConverter::Impl {
+  Impl();
+
+  sbp_state_t sbp;
+  timestamps_t time_tracker;
+  std::vector<uint8_t> output;
+  Parser parser;
+
+  static s32 write_output(uint8_t *bytes, uint32_t n_bytes, void *context);
+  static void send_obs_fn(uint32_t msg_id,
+                          size_t n_bytes,
+                          uint8_t *bytes,
+                          void *context);
+  void send_message(uint16_t msg_id, size_t n_bytes, uint8_t *bytes);
+  void send_time_message(msg_gps_time_t *time_msg);
+
+  void write_sbp_range_cmp(const BinaryHeader *header, const void *data);
+  void write_sbp_gps_ephem(const BinaryHeader *header, const void *data);
+  void write_sbp_best_pos(const BinaryHeader *header, const void *data);
+  void write_sbp_best_vel(const BinaryHeader *header, const void *data);
+  void write_sbp_ins_att(const BinaryHeader *header, const void *data);
+  void write_sbp_raw_imu(const BinaryHeader *header, const void *data);
+};
+
+Nov2SbpConverter::Impl::Impl()
+    : sbp(),
+      time_tracker{
+          {0, 0, 0, 0},  // gps_time
+          {0, 0, 0, 0},  // imu_recv_time
+          {0, 0, 0, 0}   // imu_aux_time
+      },
+      output(),
+      parser{nullptr,
+             logfn,
+             {{
+                 {Message::Id::GPSEPHEM,
+                  [this](const BinaryHeader *header, const void *data) {
+                    write_sbp_gps_ephem(header, data);
+                  }},
+                 {Message::Id::BESTPOS,
+                  [this](const BinaryHeader *header, const void *data) {
+                    write_sbp_best_pos(header, data);
+                  }},
+                 {Message::Id::BESTVEL,
+                  [this](const BinaryHeader *header, const void *data) {
+                    write_sbp_best_vel(header, data);
+                  }},
+                 {Message::Id::RANGECMP,
+                  [this](const BinaryHeader *header, const void *data) {
+                    write_sbp_range_cmp(header, data);
+                  },
+                  true},
+                 {Message::Id::INSATT,
+                  [this](const BinaryHeader *header, const void *data) {
+                    write_sbp_ins_att(header, data);
+                  }},
+                 {Message::Id::RAWIMUSX,
+                  [this](const BinaryHeader *header, const void *data) {
+                    write_sbp_raw_imu(header, data);
+                  }},
+             }},
+             this} {
+  sbp_state_init(&sbp);
+  sbp_state_set_io_context(&sbp, this);
+}
+
+/*
+ * SBP frames are collected in memory, process() hands them to the caller
+ */
+s32 Nov2SbpConverter::Impl::write_output(uint8_t *bytes,
+                                         uint32_t n_bytes,
+                                         void *context) {
+  auto *impl = static_cast<Impl *>(context);
+  impl->output.insert(impl->output.end(), bytes, bytes + n_bytes);
+  return static_cast<s32>(n_bytes);
+}
+
+void Nov2SbpConverter::Impl::send_obs_fn(uint32_t msg_id,
+                                         size_t n_bytes,
+                                         uint8_t *bytes,
+                                         void *context) {
+  static_cast<Impl *>(context)->send_message(
+      static_cast<uint16_t>(msg_id), n_bytes, bytes);
+}
+
+void Nov2SbpConverter::Impl::send_message(uint16_t msg_id,
+                                          size_t n_bytes,
+                                          uint8_t *bytes) {
+  auto ret = sbp_send_message(&sbp,
+                              msg_id,
+                              kNovatelSbpSenderId,
+                              static_cast<uint8_t>(n_bytes),
+                              bytes,
+                              write_output);
+  if (ret != SBP_OK) {
+    log_warn("Unable to send SBP message %u: %d", msg_id, ret);
+  }
+}
+
+/*
+ * Send 'time_msg' as an SBP_MSG_GPS_TIME message if it is different
+ * from the last sent message
+ */
+void Nov2SbpConverter::Impl::send_time_message(msg_gps_time_t *time_msg) {
+  if (!gps_time_compare(&time_tracker.gps_time, time_msg)) {
+    send_message(SBP_MSG_GPS_TIME,
+                 sizeof(*time_msg),
+                 reinterpret_cast<uint8_t *>(time_msg));  // NOLINT
+  }
+
+  time_tracker.gps_time = *time_msg;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Message callbacks.
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Write as many observation messages as necessary to transmit all of the
+ * observation data. The implementation here is largely informed by that in
+ * PFWP/common_calc_pvt.c.
+ */
+void Nov2SbpConverter::Impl::write_sbp_range_cmp(const BinaryHeader *header,
+                                                 const void *data) {
+  // registered as a view callback, records are decoded one at a time
+  // straight into the navigation measurements
+  const auto *view = static_cast<const Message::View *>(data);
+  Message::RANGECMP_view_t rangecmp;
+  rangecmp.FromBytes(view->bytes, view->n_bytes);
+  assert(rangecmp.n_records <= MAX_CHANNELS);
+
+  std::array<mini_navigation_measurement_t, MAX_CHANNELS> nm{};
+  for (size_t i = 0; i < rangecmp.n_records; ++i) {
+    Message::RANGECMP_record_t record = rangecmp.record(i);
+    convert_rangecmp_record_to_mini_navmeas(&record, nm.data() + i);
+  }
+  gps_time_t gps_time;
+  gps_time.wn = static_cast<int16_t>(header->week);
+  gps_time.tow = header->ms / 1000.0;
+  send_sbp_obs_messages(static_cast<uint8_t>(rangecmp.n_records),
+                        nm.data(),
+                        &gps_time,
+                        send_obs_fn,
+                        this);
+}
+
+/**
+ * Write an ephemeris GPS message. Nothing tricky here.
+ */
+void Nov2SbpConverter::Impl::write_sbp_gps_ephem(const BinaryHeader *header,
+                                                 const void *data) {
+  (void)header;
+  const auto *gpsephem =
+      reinterpret_cast<const Message::GPSEPHEM_t *>(data);  // NOLINT
+  msg_ephemeris_gps_t ephem_msg;
+  convert_gpsephem_to_ephemeris_gps(gpsephem, &ephem_msg);
+  send_message(SBP_MSG_EPHEMERIS_GPS,
+               sizeof(ephem_msg),
+               reinterpret_cast<uint8_t *>(&ephem_msg));  // NOLINT
+}
+
+/**
+ * Write an LLH position message. Note that this must be preceded by a GPS time
+ * message.
+ */
+void Nov2SbpConverter::Impl::write_sbp_best_pos(const BinaryHeader *header,
+                                                const void *data) {
+  const auto *bestpos =
+      reinterpret_cast<const Message::BESTPOS_t *>(data);  // NOLINT
+
+  msg_gps_time_t time_msg;
+  convert_header_to_gps_time(header, &time_msg);
+  send_time_message(&time_msg);
+
+  msg_pos_llh_t llh_msg;
+  convert_bestpos_to_pos_llh(header, bestpos, &llh_msg);
+  send_message(SBP_MSG_POS_LLH,
+               sizeof(llh_msg),
+               reinterpret_cast<uint8_t *>(&llh_msg));  // NOLINT
+}
+
+void Nov2SbpConverter::Impl::write_sbp_best_vel(const BinaryHeader *header,
+                                                const void *data) {
+  const auto *bestvel =
+      reinterpret_cast<const Message::BESTVEL_t *>(data);  // NOLINT
+
+  msg_gps_time_t time_msg;
+  convert_header_to_gps_time(header, &time_msg);
+  send_time_message(&time_msg);
+
+  msg_vel_ned_t vel_msg;
+  convert_bestvel_to_vel_ned(header, bestvel, &vel_msg);
+  send_message(SBP_MSG_VEL_NED,
+               sizeof(vel_msg),
+               reinterpret_cast<uint8_t *>(&vel_msg));  // NOLINT
+}
+
+void Nov2SbpConverter::Impl::write_sbp_ins_att(const BinaryHeader *header,
+                                               const void *data) {
+  const auto *insatt =
+      reinterpret_cast<const Message::INSATT_t *>(data);  // NOLINT
+
+  msg_orient_euler_t orient_euler_msg;
+  convert_insatt_to_orient_euler(header, insatt, &orient_euler_msg);
+  send_message(SBP_MSG_ORIENT_EULER,
+               sizeof(orient_euler_msg),
+               reinterpret_cast<uint8_t *>(&orient_euler_msg));  // NOLINT
+}
+
+void Nov2SbpConverter::Impl::write_sbp_raw_imu(const BinaryHeader *header,
+                                               const void *data) {
+  const auto *rawimu =
+      reinterpret_cast<const Message::RAWIMUSX_t *>(data);  // NOLINT
+
+  msg_angular_rate_t angular_rate_msg;
+  if (convert_rawimu_to_angular_rate(
+          header, rawimu, &time_tracker.imu_recv_time, &angular_rate_msg)) {
+    send_message(SBP_MSG_ANGULAR_RATE,
+                 sizeof(angular_rate_msg),
+                 reinterpret_cast<uint8_t *>(&angular_rate_msg));  // NOLINT
+  }
+
+  msg_imu_raw_t imu_raw_msg;
+  if (convert_rawimu_to_imu_raw(
+          header, rawimu, &time_tracker.imu_recv_time, &imu_raw_msg)) {
+    send_message(SBP_MSG_IMU_RAW,
+                 sizeof(imu_raw_msg),
+                 reinterpret_cast<uint8_t *>(&imu_raw_msg));  // NOLINT
+  }
+
+  msg_imu_aux_t imu_aux_msg;
+  if (convert_rawimu_to_imu_aux(
+          header, rawimu, &time_tracker.imu_aux_time, &imu_aux_msg)) {
+    send_message(SBP_MSG_IMU_AUX,
+                 sizeof(imu_aux_msg),
+                 reinterpret_cast<uint8_t *>(&imu_aux_msg));  // NOLINT
+
+    time_tracker.imu_aux_time.tow = static_cast<uint32_t>(header->ms);
+    time_tracker.imu_aux_time.wn = header->week;
+  }
+
+  time_tracker.imu_recv_time.tow = static_cast<uint32_t>(header->ms);
+  time_tracker.imu_recv_time.wn = header->week;
+}
+
+Nov2SbpConverter::Nov2SbpConverter() : impl_(new Impl()) {}
+
+Nov2SbpConverter::~Nov2SbpConverter() = default;
+
+Nov2SbpConverter::Bytes Nov2SbpConverter::process(const uint8_t *data,
+                                                  size_t length) {
+  impl_->output.clear();
+  impl_->parser.process(data, length);
+  return {impl_->output.data(), impl_->output.size()};
+}
+
+Nov2SbpConverter::Bytes Nov2SbpConverter::flush() {
+  impl_->output.clear();
+  impl_->parser.flush();
+  return {impl_->output.data(), impl_->output.size()};
+}
+
+uint32_t Nov2SbpConverter::num_resyncs() const {
+  return impl_->parser.num_resyncs();
+}
+
+uint32_t Nov2SbpConverter::num_crc_failures() const {
+  return impl_->parser.num_crc_failures();
+}
+
+size_t Nov2SbpConverter::num_bytes_discarded() const {
+  return impl_->parser.num_bytes_discarded();
+}
+
+}  // namespace Novatel
+
+struct nov2sbp_converter {
+  Novatel::Nov2SbpConverter converter;
+};
+
+/*
+ * The functions below are called from C, nothing may propagate out of them.
+ * Any exception (allocation failure in the parser or the output buffer) is
+ * reported through the return value instead.
+ */
+nov2sbp_converter_t *nov2sbp_converter_new(void) {
+  try {
+    return new (std::nothrow) nov2sbp_converter();
+  } catch (const std::exception &e) {
+    log_error("Unable to create Novatel converter: %s", e.what());
+  } catch (...) {
+    log_error("Unable to create Novatel converter");
+  }
+  return nullptr;
+}
+
+void nov2sbp_converter_delete(nov2sbp_converter_t *converter) {
+  delete converter;
+}
+
+size_t nov2sbp_converter_process(nov2sbp_converter_t *converter,
+                                 const uint8_t *data,
+                                 size_t length,
+                                 const uint8_t **sbp) {
+  *sbp = nullptr;
+  try {
+    Novatel::Nov2SbpConverter::Bytes output =
+        converter->converter.process(data, length);
+    *sbp = output.data;
+    return output.size;
+  } catch (const std::exception &e) {
+    log_error("Novatel conversion failed: %s", e.what());
+  } catch (...) {
+    log_error("Novatel conversion failed");
+  }
+  return NOV2SBP_CONVERTER_ERROR;
+}
+
+size_t nov2sbp_converter_flush(nov2sbp_converter_t *converter,
+                               const uint8_t **sbp) {
+  *sbp = nullptr;
+  try {
+    Novatel::Nov2SbpConverter::Bytes output = converter->converter.flush();
+    *sbp = output.data;
+    return output.size;
+  } catch (const std::exception &e) {
+    log_error("Novatel conversion failed: %s", e.what());
+  } catch (...) {
+    log_error("Novatel conversion failed");
+  }
+  return NOV2SBP_CONVERTER_ERROR;
+}
@@ -187,14 +187,18 @@ static s8 pack_obs_content(double P,
 void send_sbp_obs_messages(uint8_t n,
                            const mini_navigation_measurement_t *m,
                            const gps_time_t *t,
-                           void (*sbp_send_msg)(uint32_t, size_t, uint8_t *)) {
+                           void (*sbp_send_msg)(uint32_t,
+                                                size_t,
+                                                uint8_t *,
+                                                void *),
+                           void *context) {
   u32 msg_obs_max_size = SBP_MAX_PAYLOAD_LEN;
-  static u8 buff[256];
+  u8 buff[256];
 
   if ((0 == n) || (nullptr == m) || (nullptr == t)) {
     gps_time_t t_dummy = GPS_TIME_UNKNOWN;
     pack_obs_header(&t_dummy, 1, 0, (observation_header_t *)buff);  // NOLINT
-    sbp_send_msg(SBP_MSG_OBS, sizeof(observation_header_t), buff);
+    sbp_send_msg(SBP_MSG_OBS, sizeof(observation_header_t), buff, context);
     return;
   }
 
@@ -242,7 +246,8 @@ void send_sbp_obs_messages(uint8_t n,
     sbp_send_msg(
         SBP_MSG_OBS,
         sizeof(observation_header_t) + curr_n * sizeof(packed_obs_content_t),
-        buff);
+        buff,
+        context);
     // clang-format on
   }
 }
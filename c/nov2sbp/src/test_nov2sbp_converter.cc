@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2026 Swift Navigation Inc.
+ * Contact: Swift Navigation <dev@swift-nav.com>
+ *
+ * This source is subject to the license found in the file 'LICENSE' which must
+ * be be distributed together with this source. All other rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+ * EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <nov2sbp/internal/nov2sbp.h>
+#include <nov2sbp/internal/nov2sbp_converter.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "parser/catch/catch.hpp"
+#include "parser/crc_checker.h"
+
+namespace Novatel {
+
+// Short binary INSATT frame with a valid CRC, converted to SBP_MSG_ORIENT_EULER
+static std::vector<uint8_t> make_short_insatt(uint32_t week, double roll) {
+  std::vector<uint8_t> frame = {0xAA, 0x44, 0x13, 40, 0x07, 0x01};
+  frame.resize(12 + 40);
+  memcpy(&frame[12], &week, sizeof(week));
+  memcpy(&frame[24], &roll, sizeof(roll));
+  uint32_t crc = CrcChecker::get_crc(frame.data(), frame.size());
+  for (int i = 0; i < 4; i++) {
+    frame.push_back(static_cast<uint8_t>(crc >> (8 * i)));
+  }
+  return frame;
+}
+
+static std::vector<uint8_t> make_stream() {
+  std::vector<uint8_t> bytes(100, 0x55);
+  for (uint32_t week = 2000; week < 2010; week++) {
+    std::vector<uint8_t> frame = make_short_insatt(week, week / 1000.0);
+    bytes.insert(bytes.end(), frame.begin(), frame.end());
+  }
+  // truncated frame at the end of the stream
+  std::vector<uint8_t> truncated = make_short_insatt(2010, 0.0);
+  bytes.insert(bytes.end(), truncated.begin(), truncated.begin() + 30);
+  return bytes;
+}
+
+static void append(std::vector<uint8_t> *out, const uint8_t *sbp, size_t n) {
+  out->insert(out->end(), sbp, sbp + n);
+}
+
+TEST_CASE("C interface matches a single-shot conversion.") {
+  std::vector<uint8_t> bytes = make_stream();
+
+  std::vector<uint8_t> expected;
+  Nov2SbpConverter reference;
+  Nov2SbpConverter::Bytes output =
+      reference.process(bytes.data(), bytes.size());
+  append(&expected, output.data, output.size);
+  output = reference.flush();
+  append(&expected, output.data, output.size);
+  REQUIRE(!expected.empty());
+
+  // chunks smaller than a frame, chunks splitting frames at odd offsets and
+  // the whole stream at once
+  for (size_t chunk_size : {1, 7, 61, 100, 1000}) {
+    nov2sbp_converter_t *converter = nov2sbp_converter_new();
+    REQUIRE(converter != nullptr);
+
+    std::vector<uint8_t> actual;
+    const uint8_t *sbp = nullptr;
+    size_t n = 0;
+    for (size_t offset = 0; offset < bytes.size(); offset += chunk_size) {
+      size_t length = std::min(chunk_size, bytes.size() - offset);
+      n = nov2sbp_converter_process(converter, &bytes[offset], length, &sbp);
+      REQUIRE(n != NOV2SBP_CONVERTER_ERROR);
+      append(&actual, sbp, n);
+    }
+    n = nov2sbp_converter_flush(converter, &sbp);
+    REQUIRE(n != NOV2SBP_CONVERTER_ERROR);
+    append(&actual, sbp, n);
+
+    REQUIRE(actual == expected);
+    nov2sbp_converter_delete(converter);
+  }
+}
+
+TEST_CASE("Converted bytes stay valid until the next call.") {
+  std::vector<uint8_t> bytes = make_stream();
+  size_t half = bytes.size() / 2;
+
+  nov2sbp_converter_t *first = nov2sbp_converter_new();
+  nov2sbp_converter_t *second = nov2sbp_converter_new();
+  REQUIRE(first != nullptr);
+  REQUIRE(second != nullptr);
+
+  const uint8_t *sbp = nullptr;
+  size_t n = nov2sbp_converter_process(first, bytes.data(), half, &sbp);
+  REQUIRE(n != NOV2SBP_CONVERTER_ERROR);
+  REQUIRE(n > 0);
+  std::vector<uint8_t> copy(sbp, sbp + n);
+
+  // other handles own their output, using them leaves *sbp untouched
+  const uint8_t *other_sbp = nullptr;
+  size_t other_n =
+      nov2sbp_converter_process(second, bytes.data(), bytes.size(), &other_sbp);
+  REQUIRE(other_n != NOV2SBP_CONVERTER_ERROR);
+  REQUIRE(other_sbp != sbp);
+  REQUIRE(std::equal(copy.begin(), copy.end(), sbp));
+
+  // the next call on the handle produces the rest of the stream
+  const uint8_t *rest = nullptr;
+  n = nov2sbp_converter_process(
+      first, bytes.data() + half, bytes.size() - half, &rest);
+  REQUIRE(n != NOV2SBP_CONVERTER_ERROR);
+  copy.insert(copy.end(), rest, rest + n);
+  REQUIRE(copy == std::vector<uint8_t>(other_sbp, other_sbp + other_n));
+
+  nov2sbp_converter_delete(first);
+  nov2sbp_converter_delete(second);
+}
+
+}  // namespace Novatel
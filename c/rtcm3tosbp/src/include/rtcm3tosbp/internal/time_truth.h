@@ -10,6 +10,14 @@ extern "C" {
 extern TimeTruth *rtcm_time_truth;
 extern TimeTruthCache *rtcm_time_truth_cache;
 
+/* Private instances for converters which must not share the time truth of
+ * the process, e.g. the shards of a parallel conversion. The constructors
+ * return NULL when out of memory. */
+TimeTruth *rtcm_time_truth_new(void);
+void rtcm_time_truth_delete(TimeTruth *time_truth);
+TimeTruthCache *rtcm_time_truth_cache_new(void);
+void rtcm_time_truth_cache_delete(TimeTruthCache *time_truth_cache);
+
 #ifdef __cplusplus
 }
 #endif
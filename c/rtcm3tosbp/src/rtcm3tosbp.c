@@ -19,6 +19,7 @@
 
 #include <assert.h>
 #include <getopt.h>
+#include <gnss-converters-extra/tool_io.h>
 #include <gnss-converters/options.h>
 #include <gnss-converters/rtcm3_sbp.h>
 #include <libsbp/edc.h>
@@ -43,20 +44,28 @@ static struct rtcm3_sbp_state state;
 static void parse_biases(char *arg);
 static void parse_glonass_code_biases(char *arg);
 static void parse_glonass_phase_biases(char *arg);
-static void update_obs_time(const sbp_observation_header_t *header);
+static void update_obs_time(struct rtcm3_sbp_state *rtcm_state,
+                            const sbp_observation_header_t *header);
 
-/* Write the SBP packet to STDOUT. */
-static void cb_rtcm_to_sbp(uint16_t sender_id,
+/* With a user provided time the converter follows the observation time */
+static void track_obs_time(struct rtcm3_sbp_state *rtcm_state,
                            sbp_msg_type_t msg_type,
-                           const sbp_msg_t *msg,
-                           void *context) {
-  if (rtcm2sbp_is_using_user_provided_time(&state)) {
+                           const sbp_msg_t *msg) {
+  if (rtcm2sbp_is_using_user_provided_time(rtcm_state)) {
     if (msg_type == SbpMsgObs) {
-      update_obs_time(&msg->obs.header);
+      update_obs_time(rtcm_state, &msg->obs.header);
     } else if (msg_type == SbpMsgOsr) {
-      update_obs_time(&msg->osr.header);
+      update_obs_time(rtcm_state, &msg->osr.header);
     }
   }
+}
+
+/* Write the SBP packet to STDOUT. */
+static void cb_rtcm_to_sbp(uint16_t sender_id,
+                           sbp_msg_type_t msg_type,
+                           const sbp_msg_t *msg,
+                           void *context) {
+  track_obs_time(&state, msg_type, msg);
 
   (void)(context); /* squash warning */
   s8 ret = sbp_message_send(
@@ -68,6 +77,130 @@ static void cb_rtcm_to_sbp(uint16_t sender_id,
   }
 }
 
+/* Sets up the time source picked on the command line, either the start
+ * time given with -o or, if `start_time` is NULL, the time truth estimators
+ * of `time_truth` */
+static void configure_time(struct rtcm3_sbp_state *rtcm_state,
+                           TimeTruth *time_truth,
+                           TimeTruthCache *time_truth_cache,
+                           const gps_time_t *start_time) {
+  rtcm2sbp_set_gps_week_reference(GPS_WEEK_REFERENCE, rtcm_state);
+  if (start_time != NULL) {
+    rtcm2sbp_set_time(start_time, NULL, rtcm_state);
+    return;
+  }
+
+  ObservationTimeEstimator *observation_estimator;
+  EphemerisTimeEstimator *ephemeris_estimator;
+  Rtcm1013TimeEstimator *rtcm_1013_estimator;
+
+  time_truth_request_observation_time_estimator(
+      time_truth, TIME_TRUTH_SOURCE_LOCAL, &observation_estimator);
+  time_truth_request_ephemeris_time_estimator(
+      time_truth, TIME_TRUTH_SOURCE_LOCAL, &ephemeris_estimator);
+  time_truth_request_rtcm_1013_time_estimator(
+      time_truth, TIME_TRUTH_SOURCE_LOCAL, &rtcm_1013_estimator);
+
+  rtcm2sbp_set_time_truth_cache(time_truth_cache, rtcm_state);
+  rtcm2sbp_set_time_truth_estimators(observation_estimator,
+                                     ephemeris_estimator,
+                                     rtcm_1013_estimator,
+                                     rtcm_state);
+}
+
+/* Output buffer used in mmap mode, collects the output into large writes */
+static tool_output_t output;
+
+/* Converter of one shard of a mapped file, see tool_convert_sharded(). Each
+ * shard has its own time truth so that it only learns the time from the
+ * frames it converts. */
+struct rtcm_shard {
+  struct rtcm3_sbp_state state;
+  TimeTruth *time_truth;
+  TimeTruthCache *time_truth_cache;
+  sbp_write_fn_t writefn;
+};
+
+static void rtcm_shard_sbp_write(uint16_t sender_id,
+                                 sbp_msg_type_t msg_type,
+                                 const sbp_msg_t *msg,
+                                 void *context) {
+  struct rtcm_shard *shard = context;
+  track_obs_time(&shard->state, msg_type, msg);
+  sbp_message_send(
+      &shard->state.sbp_state, msg_type, sender_id, msg, shard->writefn);
+}
+
+static void rtcm_shard_destroy(void *converter) {
+  struct rtcm_shard *shard = converter;
+  rtcm_time_truth_cache_delete(shard->time_truth_cache);
+  rtcm_time_truth_delete(shard->time_truth);
+  free(shard);
+}
+
+/* `context` is the start time given with -o, NULL if there is none */
+static void *rtcm_shard_create(void *context,
+                               sbp_write_fn_t writefn,
+                               void *write_context) {
+  const gps_time_t *start_time = context;
+  struct rtcm_shard *shard = calloc(1, sizeof(*shard));
+  if (shard == NULL) {
+    return NULL;
+  }
+  shard->time_truth = rtcm_time_truth_new();
+  shard->time_truth_cache = rtcm_time_truth_cache_new();
+  if (shard->time_truth == NULL || shard->time_truth_cache == NULL) {
+    rtcm_shard_destroy(shard);
+    return NULL;
+  }
+  rtcm2sbp_init(
+      &shard->state, shard->time_truth, rtcm_shard_sbp_write, NULL, shard);
+  sbp_state_set_io_context(&shard->state.sbp_state, write_context);
+  configure_time(&shard->state,
+                 shard->time_truth,
+                 shard->time_truth_cache,
+                 start_time);
+  shard->writefn = writefn;
+  return shard;
+}
+
+static void rtcm_shard_process(void *converter,
+                               const uint8_t *data,
+                               size_t length) {
+  struct rtcm_shard *shard = converter;
+  rtcm2sbp_process_buffer(&shard->state, data, length);
+}
+
+static const tool_shard_ops_t rtcm_shard_ops = {
+    .frame_boundary = rtcm2sbp_frame_boundary,
+    .create = rtcm_shard_create,
+    .process = rtcm_shard_process,
+    .destroy = rtcm_shard_destroy,
+};
+
+struct mapped_conversion {
+  unsigned jobs;
+  size_t warmup;
+  gps_time_t *start_time;
+};
+
+/* Offline mode, frames straight out of the mapped input file. With more than
+ * one job the file is converted in shards. */
+static bool convert_mapping(const uint8_t *data, size_t length, void *context) {
+  struct mapped_conversion *conversion = context;
+  if (conversion->jobs > 1) {
+    return tool_convert_sharded(&output,
+                                data,
+                                length,
+                                conversion->jobs,
+                                conversion->warmup,
+                                &rtcm_shard_ops,
+                                conversion->start_time);
+  }
+  rtcm2sbp_process_buffer(&state, data, length);
+  return tool_output_flush(&output);
+}
+
 static void help(char *arg, const char *additional_opts_help) {
   fprintf(stderr, "Usage: %s [options]%s\n", arg, additional_opts_help);
   fprintf(stderr, "  -h this message\n");
@@ -96,6 +229,20 @@ static void help(char *arg, const char *additional_opts_help) {
           "a time to be provided with -d, -w, or -s\n");
   fprintf(stderr, "  -[GREICJS] disables a constellation\n");
   fprintf(stderr, "  -v for stderr verbosity\n");
+  fprintf(stderr,
+          "  --mmap FILE convert FILE instead of stdin. The file is memory "
+          "mapped and output is written in large blocks, intended for "
+          "reprocessing logs.\n");
+  fprintf(stderr,
+          "  --jobs N with --mmap, split FILE at frame boundaries into N "
+          "shards (at most %u) which are converted in parallel and written "
+          "out in order. Each shard learns the time on its own.\n",
+          TOOL_MAX_JOBS);
+  fprintf(stderr,
+          "  --warmup BYTES with --jobs, amount of input each shard converts "
+          "without output before its own range so that ephemeris and time "
+          "state can settle. Defaults to %u\n",
+          TOOL_DEFAULT_WARMUP_SIZE);
 }
 
 static gps_time_t time2gps_apply_offset(const time_t t_unix) {
@@ -124,14 +271,42 @@ int rtcm3tosbp(int argc,
   /* use observations instead of ephemerides as time source */
   bool use_obs_time = false;
 
+  /* convert this file instead of reading from readfn */
+  const char *mmap_path = NULL;
+  unsigned jobs = 1;
+  size_t warmup = TOOL_DEFAULT_WARMUP_SIZE;
+
   rtcm3tosbp_writefn = writefn;
 
   int opt;
-  while ((opt = getopt(argc, argv, "hb:c:l:tw:d:soGRECJS:v")) != -1) {
+  int option_index = 0;
+  static struct option long_options[] = {{"mmap", required_argument, 0, 0},
+                                         {"jobs", required_argument, 0, 0},
+                                         {"warmup", required_argument, 0, 0},
+                                         {0, 0, 0, 0}};
+  while ((opt = getopt_long(argc,
+                            argv,
+                            "hb:c:l:tw:d:soGRECJS:v",
+                            long_options,
+                            &option_index)) != -1) {
     if (optarg && *optarg == '=') {
       optarg++;
     }
     switch (opt) {
+      case 0:
+        if (strcmp("mmap", long_options[option_index].name) == 0) {
+          mmap_path = optarg;
+        } else if (strcmp("jobs", long_options[option_index].name) == 0) {
+          jobs = (unsigned)strtoul(optarg, NULL, 0);
+          if (jobs == 0 || jobs > TOOL_MAX_JOBS) {
+            fprintf(
+                stderr, "--jobs must be between 1 and %u\n", TOOL_MAX_JOBS);
+            return -1;
+          }
+        } else if (strcmp("warmup", long_options[option_index].name) == 0) {
+          warmup = (size_t)strtoull(optarg, NULL, 0);
+        }
+        break;
       case 'h':
         help(argv[0], additional_opts_help);
         return 0;
@@ -219,20 +394,15 @@ int rtcm3tosbp(int argc,
     }
   }
 
-  ObservationTimeEstimator *observation_estimator;
-  EphemerisTimeEstimator *ephemeris_estimator;
-  Rtcm1013TimeEstimator *rtcm_1013_estimator;
-
-  time_truth_request_observation_time_estimator(
-      rtcm_time_truth, TIME_TRUTH_SOURCE_LOCAL, &observation_estimator);
-  time_truth_request_ephemeris_time_estimator(
-      rtcm_time_truth, TIME_TRUTH_SOURCE_LOCAL, &ephemeris_estimator);
-  time_truth_request_rtcm_1013_time_estimator(
-      rtcm_time_truth, TIME_TRUTH_SOURCE_LOCAL, &rtcm_1013_estimator);
+  if (jobs > 1 && mmap_path == NULL) {
+    fprintf(stderr, "--jobs requires --mmap\n");
+    return -1;
+  }
 
   rtcm2sbp_init(&state, rtcm_time_truth, cb_rtcm_to_sbp, NULL, context);
-  rtcm2sbp_set_gps_week_reference(GPS_WEEK_REFERENCE, &state);
 
+  gps_time_t start_time;
+  gps_time_t *start_time_ptr = NULL;
   if (use_obs_time) {
     if (ct_utc_unix == 0) {
       fprintf(stderr,
@@ -244,15 +414,21 @@ int rtcm3tosbp(int argc,
 
     gps_time_t unix_time = time2gps_t(ct_utc_unix);
     int8_t leap_seconds = get_gps_utc_offset(&unix_time, NULL);
-    gps_time_t gps_time = time2gps_t(ct_utc_unix + leap_seconds);
-
-    rtcm2sbp_set_time(&gps_time, NULL, &state);
-  } else {
-    rtcm2sbp_set_time_truth_cache(rtcm_time_truth_cache, &state);
-    rtcm2sbp_set_time_truth_estimators(observation_estimator,
-                                       ephemeris_estimator,
-                                       rtcm_1013_estimator,
-                                       &state);
+    start_time = time2gps_t(ct_utc_unix + leap_seconds);
+    start_time_ptr = &start_time;
+  }
+  configure_time(
+      &state, rtcm_time_truth, rtcm_time_truth_cache, start_time_ptr);
+
+  if (mmap_path != NULL) {
+    tool_output_init(&output, writefn, context);
+    sbp_state_set_io_context(&state.sbp_state, &output);
+    rtcm3tosbp_writefn = tool_output_writefn;
+    struct mapped_conversion conversion = {
+        .jobs = jobs, .warmup = warmup, .start_time = start_time_ptr};
+    return tool_convert_mapped_file(mmap_path, convert_mapping, &conversion)
+               ? 0
+               : -1;
   }
 
   /* todo: Do we want to return a non-zero value on an error? */
@@ -329,13 +505,14 @@ static void parse_glonass_phase_biases(char *arg) {
   }
 }
 
-static void update_obs_time(const sbp_observation_header_t *header) {
+static void update_obs_time(struct rtcm3_sbp_state *rtcm_state,
+                            const sbp_observation_header_t *header) {
   gps_time_t obs_time;
   obs_time.tow = header->t.tow / 1000.0; /* ms to sec */
   obs_time.wn = (s16)header->t.wn;
   /* Some receivers output a TOW 0 whenever it's in a denied environment
    * (teseoV) This stops us updating that as a valid observation time */
   if (fabs(obs_time.tow) > FLOAT_EQUALITY_EPS) {
-    rtcm2sbp_set_time(&obs_time, NULL, &state);
+    rtcm2sbp_set_time(&obs_time, NULL, rtcm_state);
   }
 }
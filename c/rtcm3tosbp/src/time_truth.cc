@@ -1,7 +1,21 @@
 #include <rtcm3tosbp/internal/time_truth.h>
 
+#include <new>
+
 static TimeTruth singleton_time_truth;
 static TimeTruthCache singleton_time_truth_cache;
 
 TimeTruth *rtcm_time_truth = &singleton_time_truth;
 TimeTruthCache *rtcm_time_truth_cache = &singleton_time_truth_cache;
+
+TimeTruth *rtcm_time_truth_new(void) { return new (std::nothrow) TimeTruth(); }
+
+void rtcm_time_truth_delete(TimeTruth *time_truth) { delete time_truth; }
+
+TimeTruthCache *rtcm_time_truth_cache_new(void) {
+  return new (std::nothrow) TimeTruthCache();
+}
+
+void rtcm_time_truth_cache_delete(TimeTruthCache *time_truth_cache) {
+  delete time_truth_cache;
+}
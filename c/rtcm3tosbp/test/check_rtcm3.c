@@ -855,6 +855,78 @@ static s32 sbp_read_file(u8 *buff, u32 n, void *context) {
   return fread(buff, 1, n, f);
 }
 
+/* SBP frames converted from an RTCM file, encoded the way the tool writes them
+ * minus the preamble and CRC */
+struct sbp_capture {
+  FILE *fp;
+  u8 data[4 * MAX_FILE_SIZE];
+  size_t length;
+  bool muted;
+};
+
+static int rtcm_read_capture_file(uint8_t *buf, size_t len, void *context) {
+  struct sbp_capture *capture = context;
+  return (int)fread(buf, 1, len, capture->fp);
+}
+
+static void sbp_capture_callback(uint16_t sender_id,
+                                 sbp_msg_type_t msg_type,
+                                 const sbp_msg_t *msg,
+                                 void *context) {
+  struct sbp_capture *capture = context;
+  if (capture->muted) {
+    return;
+  }
+  ck_assert_uint_le(capture->length + 5 + SBP_MAX_PAYLOAD_LEN,
+                    sizeof(capture->data));
+
+  u8 *frame = &capture->data[capture->length];
+  frame[0] = (u8)msg_type;
+  frame[1] = (u8)((u16)msg_type >> 8);
+  frame[2] = (u8)sender_id;
+  frame[3] = (u8)(sender_id >> 8);
+  ck_assert_int_eq(
+      sbp_message_encode(
+          &frame[5], SBP_MAX_PAYLOAD_LEN, &frame[4], msg_type, msg),
+      SBP_OK);
+  capture->length += 5 + (size_t)frame[4];
+}
+
+/* Converts `filename` once through the streaming interface and once as a
+ * single buffer, as rtcm3tosbp does with and without --mmap, and requires
+ * the same SBP output from both */
+static void check_process_buffer(const char *filename, gps_time_t time) {
+  static u8 contents[MAX_FILE_SIZE];
+  static struct sbp_capture streamed;
+  static struct sbp_capture buffered;
+  const int8_t leap_seconds = 18;
+
+  streamed.length = 0;
+  streamed.fp = fopen(filename, "rb");
+  ck_assert(streamed.fp != NULL);
+  rtcm2sbp_init(&state, NULL, sbp_capture_callback, NULL, &streamed);
+  rtcm2sbp_set_time(&time, &leap_seconds, &state);
+  while (rtcm2sbp_process(&state, rtcm_read_capture_file) > 0) {
+  }
+  fclose(streamed.fp);
+
+  FILE *fp = fopen(filename, "rb");
+  ck_assert(fp != NULL);
+  size_t length = fread(contents, 1, sizeof(contents), fp);
+  fclose(fp);
+  ck_assert_uint_gt(length, 0);
+
+  buffered.length = 0;
+  rtcm2sbp_init(&state, NULL, sbp_capture_callback, NULL, &buffered);
+  rtcm2sbp_set_time(&time, &leap_seconds, &state);
+  ck_assert_uint_le(rtcm2sbp_process_buffer(&state, contents, length),
+                    length);
+
+  ck_assert_uint_gt(streamed.length, 0);
+  ck_assert_uint_eq(buffered.length, streamed.length);
+  ck_assert(memcmp(buffered.data, streamed.data, streamed.length) == 0);
+}
+
 static void ephemeris_glo_callback(u16 sender_id,
                                    sbp_msg_type_t msg_type,
                                    const sbp_msg_t *msg,
@@ -1144,6 +1216,60 @@ void rtcm3_setup_basic(void) {
 
 /* end fixtures */
 
+/* Converts `filename` in `n_shards` pieces split with
+ * rtcm2sbp_frame_boundary(), each by its own converter, the way rtcm3tosbp
+ * --jobs does, and requires the same SBP output as a serial conversion */
+static void check_sharded_conversion(const char *filename,
+                                     gps_time_t time,
+                                     size_t n_shards) {
+  static u8 contents[MAX_FILE_SIZE];
+  static struct sbp_capture serial;
+  static struct sbp_capture sharded;
+  const int8_t leap_seconds = 18;
+
+  FILE *fp = fopen(filename, "rb");
+  ck_assert(fp != NULL);
+  size_t length = fread(contents, 1, sizeof(contents), fp);
+  fclose(fp);
+
+  serial.length = 0;
+  rtcm2sbp_init(&state, NULL, sbp_capture_callback, NULL, &serial);
+  rtcm2sbp_set_time(&time, &leap_seconds, &state);
+  rtcm2sbp_process_buffer(&state, contents, length);
+
+  size_t first = rtcm2sbp_frame_boundary(contents, length, 0);
+  ck_assert_uint_lt(first, length);
+  ck_assert_uint_eq(contents[first], RTCM3_PREAMBLE);
+  ck_assert_uint_eq(rtcm2sbp_frame_boundary(contents, length, length),
+                    length);
+
+  /* Each shard replays everything before its range with the output muted,
+   * then keeps the output of its own frames only */
+  sharded.length = 0;
+  size_t begin = 0;
+  for (size_t i = 0; i < n_shards; i++) {
+    size_t end = length;
+    if (i + 1 < n_shards) {
+      end = rtcm2sbp_frame_boundary(
+          contents, length, length / n_shards * (i + 1));
+      ck_assert_uint_gt(end, begin);
+      ck_assert_uint_eq(contents[end], RTCM3_PREAMBLE);
+    }
+
+    rtcm2sbp_init(&state, NULL, sbp_capture_callback, NULL, &sharded);
+    rtcm2sbp_set_time(&time, &leap_seconds, &state);
+    sharded.muted = true;
+    rtcm2sbp_process_buffer(&state, contents, begin);
+    sharded.muted = false;
+    rtcm2sbp_process_buffer(&state, &contents[begin], end - begin);
+    begin = end;
+  }
+
+  ck_assert_uint_gt(serial.length, 0);
+  ck_assert_uint_eq(sharded.length, serial.length);
+  ck_assert(memcmp(sharded.data, serial.data, serial.length) == 0);
+}
+
 START_TEST(test_gps_time) {
   current_time.wn = 1945;
   current_time.tow = 277500;
@@ -1152,6 +1278,26 @@ START_TEST(test_gps_time) {
 }
 END_TEST
 
+START_TEST(test_process_buffer) {
+  check_process_buffer(RELATIVE_PATH_PREFIX "/data/RTCM3.bin",
+                       (gps_time_t){.wn = 1945, .tow = 277500});
+  check_process_buffer(RELATIVE_PATH_PREFIX "/data/piksi-5Hz.rtcm3",
+                       (gps_time_t){.wn = 2036, .tow = 204236});
+  check_process_buffer(RELATIVE_PATH_PREFIX "/data/dropped-packets-STR24.rtcm3",
+                       (gps_time_t){.wn = 2007, .tow = 289790});
+}
+END_TEST
+
+START_TEST(test_sharded_conversion) {
+  check_sharded_conversion(RELATIVE_PATH_PREFIX "/data/piksi-5Hz.rtcm3",
+                           (gps_time_t){.wn = 2036, .tow = 204236},
+                           3);
+  check_sharded_conversion(RELATIVE_PATH_PREFIX "/data/RTCM3.bin",
+                           (gps_time_t){.wn = 1945, .tow = 277500},
+                           4);
+}
+END_TEST
+
 START_TEST(test_glo_day_rollover) {
   current_time.wn = 1959;
   current_time.tow = 510191;
@@ -2641,10 +2787,16 @@ static void set_sample_cons_meas_map(struct rtcm3_sbp_state *rtcm2sbp_state) {
 
   for (size_t i = 0; i < ARRAY_SIZE(obs); i++) {
     struct cons_meas_map_shortform sig = obs[i];
-    (map + sig.cons)->sat_data[sig.sid].n_signal = sig.n_signal;
+    struct rtcm_meas_sat_signal *sat_data =
+        &(map + sig.cons)->sat_data[sig.sid];
+    sat_data->epoch = rtcm2sbp_state->cons_meas_epoch;
+    sat_data->n_signal = sig.n_signal;
+    memset(sat_data->code_mask, 0, sizeof(sat_data->code_mask));
     for (size_t j = 0; j < sig.n_signal; j++) {
-      (map + sig.cons)->sat_data[sig.sid].sig_data[j].code = sig.signal[j].code;
-      (map + sig.cons)->sat_data[sig.sid].sig_data[j].cn0 = sig.signal[j].cn0;
+      sat_data->sig_data[j].code = sig.signal[j].code;
+      sat_data->sig_data[j].cn0 = sig.signal[j].cn0;
+      sat_data->code_mask[sig.signal[j].code / 32] |=
+          1u << (sig.signal[j].code % 32);
     }
   }
 }
@@ -2962,6 +3114,8 @@ Suite *rtcm3_suite(void) {
   TCase *tc_core = tcase_create("Core");
   tcase_add_checked_fixture(tc_core, rtcm3_setup_basic, NULL);
   tcase_add_test(tc_core, test_gps_time);
+  tcase_add_test(tc_core, test_process_buffer);
+  tcase_add_test(tc_core, test_sharded_conversion);
   tcase_add_test(tc_core, test_glo_day_rollover);
   tcase_add_test(tc_core, test_1012_first);
   tcase_add_test(tc_core, test_glo_5hz);
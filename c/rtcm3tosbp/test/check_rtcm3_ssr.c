@@ -14,6 +14,8 @@
 #include <gnss-converters/sbp_rtcm3.h>
 #include <libsbp/v4/ssr.h>
 #include <math.h>
+#include <rtcm3/bits.h>
+#include <rtcm3/ssr_decode.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -918,6 +920,112 @@ START_TEST(test_ssr_phase_bias) {
 }
 END_TEST
 
+#define MAX_CAPTURED_SSR_BIASES 256
+
+typedef struct {
+  size_t n_msgs;
+  sbp_msg_type_t msg_types[MAX_CAPTURED_SSR_BIASES];
+  sbp_msg_t msgs[MAX_CAPTURED_SSR_BIASES];
+} ssr_bias_capture_t;
+
+static void ssr_bias_capture_callback(uint16_t sender_id,
+                                      sbp_msg_type_t msg_type,
+                                      const sbp_msg_t *sbp_msg,
+                                      void *context) {
+  (void)sender_id;
+  ssr_bias_capture_t *capture = (ssr_bias_capture_t *)context;
+  ck_assert_uint_lt(capture->n_msgs, MAX_CAPTURED_SSR_BIASES);
+  capture->msg_types[capture->n_msgs] = msg_type;
+  capture->msgs[capture->n_msgs] = *sbp_msg;
+  capture->n_msgs++;
+}
+
+/* Converts an SSR bias payload straight off the bitstream and through the
+ * decoded message, both have to give the same SBP messages. The payload cut
+ * short mustn't give any. */
+static void check_ssr_bias_payload(const uint8_t *payload,
+                                   uint32_t payload_length,
+                                   bool code_biases) {
+  static ssr_bias_capture_t streamed;
+  static ssr_bias_capture_t decoded;
+  static rtcm_msg_code_bias msg_code_bias;
+  static rtcm_msg_phase_bias msg_phase_bias;
+  const gps_time_t time = {.wn = 2013, .tow = 171680};
+  struct rtcm3_sbp_state state;
+
+  streamed.n_msgs = 0;
+  rtcm2sbp_init(&state, NULL, ssr_bias_capture_callback, NULL, &streamed);
+  rtcm2sbp_set_time(&time, NULL, &state);
+  rtcm2sbp_decode_payload(payload, payload_length, &state);
+
+  decoded.n_msgs = 0;
+  rtcm2sbp_init(&state, NULL, ssr_bias_capture_callback, NULL, &decoded);
+  rtcm2sbp_set_time(&time, NULL, &state);
+  if (code_biases) {
+    ck_assert_int_eq(rtcm3_decode_code_bias(payload, &msg_code_bias), RC_OK);
+    rtcm3_ssr_code_bias_to_sbp(&msg_code_bias, &state);
+  } else {
+    ck_assert_int_eq(rtcm3_decode_phase_bias(payload, &msg_phase_bias),
+                     RC_OK);
+    rtcm3_ssr_phase_bias_to_sbp(&msg_phase_bias, &state);
+  }
+
+  ck_assert_uint_gt(streamed.n_msgs, 0);
+  ck_assert_uint_eq(streamed.n_msgs, decoded.n_msgs);
+  for (size_t i = 0; i < streamed.n_msgs; i++) {
+    ck_assert_int_eq(streamed.msg_types[i], decoded.msg_types[i]);
+    if (code_biases) {
+      ck_assert_int_eq(streamed.msg_types[i], SbpMsgSsrCodeBiases);
+      ck_assert(memcmp(&streamed.msgs[i].ssr_code_biases,
+                       &decoded.msgs[i].ssr_code_biases,
+                       sizeof(sbp_msg_ssr_code_biases_t)) == 0);
+    } else {
+      ck_assert_int_eq(streamed.msg_types[i], SbpMsgSsrPhaseBiases);
+      ck_assert(memcmp(&streamed.msgs[i].ssr_phase_biases,
+                       &decoded.msgs[i].ssr_phase_biases,
+                       sizeof(sbp_msg_ssr_phase_biases_t)) == 0);
+    }
+  }
+
+  for (uint32_t length = RTCM3_MIN_MSG_LEN; length <= payload_length / 2;
+       length++) {
+    streamed.n_msgs = 0;
+    rtcm2sbp_init(&state, NULL, ssr_bias_capture_callback, NULL, &streamed);
+    rtcm2sbp_set_time(&time, NULL, &state);
+    rtcm2sbp_decode_payload(payload, length, &state);
+    ck_assert_uint_eq(streamed.n_msgs, 0);
+  }
+}
+
+START_TEST(test_ssr_bias_truncated) {
+  static uint8_t contents[MAX_FILE_SIZE];
+  FILE *fp = fopen(RELATIVE_PATH_PREFIX "/data/clk.rtcm", "rb");
+  ck_assert(fp != NULL);
+  size_t length = fread(contents, 1, sizeof(contents), fp);
+  fclose(fp);
+
+  bool code_biases_checked = false;
+  bool phase_biases_checked = false;
+  for (size_t index = rtcm2sbp_frame_boundary(contents, length, 0);
+       index < length;
+       index = rtcm2sbp_frame_boundary(contents, length, index + 1)) {
+    const uint8_t *payload = &contents[index + 3];
+    uint32_t payload_length =
+        ((uint32_t)(contents[index + 1] & 0x3) << 8) | contents[index + 2];
+    uint16_t msg_num = (uint16_t)rtcm_getbitu(payload, 0, 12);
+    if (!code_biases_checked && is_ssr_code_biases_message(msg_num)) {
+      check_ssr_bias_payload(payload, payload_length, true);
+      code_biases_checked = true;
+    } else if (!phase_biases_checked && is_ssr_phase_biases_message(msg_num)) {
+      check_ssr_bias_payload(payload, payload_length, false);
+      phase_biases_checked = true;
+    }
+  }
+  ck_assert(code_biases_checked);
+  ck_assert(phase_biases_checked);
+}
+END_TEST
+
 Suite *rtcm3_ssr_suite(void) {
   Suite *s = suite_create("RTCMv3_ssr");
 
@@ -940,6 +1048,7 @@ Suite *rtcm3_ssr_suite(void) {
   tcase_add_test(tc_ssr, test_ssr_bds_code_bias);
   tcase_add_test(tc_ssr, test_ssr_bds_phase_bias);
   tcase_add_test(tc_ssr, test_ssr_phase_bias);
+  tcase_add_test(tc_ssr, test_ssr_bias_truncated);
   suite_add_tcase(s, tc_ssr);
 
   return s;
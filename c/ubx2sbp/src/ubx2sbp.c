@@ -11,16 +11,36 @@
  */
 
 #include <getopt.h>
+#include <gnss-converters-extra/tool_io.h>
+#include <gnss-converters/spsc_ring.h>
 #include <gnss-converters/ubx_sbp.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <ubx2sbp/internal/time_truth.h>
 #include <ubx2sbp/internal/ubx2sbp.h>
 
+/* Size of the ingest ring used in threaded mode, must be a power of two */
+#define INGEST_RING_SIZE (1u << 20)
+
+/* Largest chunk the reader thread pulls from the input in one go */
+#define INGEST_CHUNK_SIZE 4096
+
+/* Longest the converter sleeps while waiting for the reader thread */
+#define INGEST_POLL_INTERVAL_NS 1000000
+
 static sbp_state_t sbp_state;
 static writefn_ptr ubx2sbp_writefn;
 
+static struct {
+  spsc_ring_t ring;
+  u8 storage[INGEST_RING_SIZE];
+  readfn_ptr readfn;
+  void *context;
+} ingest;
+
 static void sbp_write(uint16_t sender_id,
                       sbp_msg_type_t msg_type,
                       const sbp_msg_t *msg,
@@ -30,6 +50,115 @@ static void sbp_write(uint16_t sender_id,
   sbp_message_send(&sbp_state, msg_type, sender_id, msg, ubx2sbp_writefn);
 }
 
+/* Reader thread of the threaded mode. Keeps draining the input so that a slow
+ * converter or writer never stalls the source, chunks which don't fit into the
+ * ring are dropped and counted. */
+static void *ingest_thread(void *arg) {
+  (void)arg;
+  u8 chunk[INGEST_CHUNK_SIZE];
+  int n;
+  while ((n = ingest.readfn(chunk, sizeof(chunk), ingest.context)) > 0) {
+    spsc_ring_write(&ingest.ring, chunk, (size_t)n);
+  }
+  spsc_ring_close(&ingest.ring);
+  return NULL;
+}
+
+/* Converter side of the threaded mode. Hands over everything that is queued
+ * up in one batch and waits at most INGEST_POLL_INTERVAL_NS between checks
+ * for new data. Returns 0 once the reader has finished and the ring is
+ * empty. */
+static int ingest_readfn(u8 *buf, size_t len, void *context) {
+  (void)context;
+  const struct timespec interval = {.tv_sec = 0,
+                                    .tv_nsec = INGEST_POLL_INTERVAL_NS};
+  for (;;) {
+    size_t n = spsc_ring_read(&ingest.ring, buf, len);
+    if (n > 0) {
+      return (int)n;
+    }
+    if (spsc_ring_drained(&ingest.ring)) {
+      return 0;
+    }
+    nanosleep(&interval, NULL);
+  }
+}
+
+/* Output buffer used in mmap mode, collects the output into large writes */
+static tool_output_t output;
+
+/* Converter of one shard of a mapped file, see tool_convert_sharded() */
+struct ubx_shard {
+  struct ubx_sbp_state state;
+  sbp_state_t sbp_state;
+  sbp_write_fn_t writefn;
+};
+
+static void ubx_shard_sbp_write(uint16_t sender_id,
+                                sbp_msg_type_t msg_type,
+                                const sbp_msg_t *msg,
+                                void *context) {
+  struct ubx_shard *shard = context;
+  sbp_message_send(
+      &shard->sbp_state, msg_type, sender_id, msg, shard->writefn);
+}
+
+/* Every shard starts from the configuration of the serial converter passed
+ * as `context` */
+static void *ubx_shard_create(void *context,
+                              sbp_write_fn_t writefn,
+                              void *write_context) {
+  const struct ubx_sbp_state *state = context;
+  struct ubx_shard *shard = malloc(sizeof(*shard));
+  if (shard == NULL) {
+    return NULL;
+  }
+  shard->state = *state;
+  shard->state.cb_ubx_to_sbp = ubx_shard_sbp_write;
+  shard->state.context = shard;
+  sbp_state_init(&shard->sbp_state);
+  sbp_state_set_io_context(&shard->sbp_state, write_context);
+  shard->writefn = writefn;
+  return shard;
+}
+
+static void ubx_shard_process(void *converter,
+                              const uint8_t *data,
+                              size_t length) {
+  struct ubx_shard *shard = converter;
+  ubx_sbp_process_buffer(&shard->state, data, length);
+}
+
+static const tool_shard_ops_t ubx_shard_ops = {
+    .frame_boundary = ubx_sbp_frame_boundary,
+    .create = ubx_shard_create,
+    .process = ubx_shard_process,
+    .destroy = free,
+};
+
+struct mapped_conversion {
+  struct ubx_sbp_state *state;
+  unsigned jobs;
+  size_t warmup;
+};
+
+/* Offline mode, frames straight out of the mapped input file. With more than
+ * one job the file is converted in shards. */
+static bool convert_mapping(const uint8_t *data, size_t length, void *context) {
+  struct mapped_conversion *conversion = context;
+  if (conversion->jobs > 1) {
+    return tool_convert_sharded(&output,
+                                data,
+                                length,
+                                conversion->jobs,
+                                conversion->warmup,
+                                &ubx_shard_ops,
+                                conversion->state);
+  }
+  ubx_sbp_process_buffer(conversion->state, data, length);
+  return tool_output_flush(&output);
+}
+
 static void help(char *arg, const char *additional_opts_help) {
   fprintf(stderr, "Usage: %s [options]%s\n", arg, additional_opts_help);
   fprintf(stderr, "  -h this message\n");
@@ -46,6 +175,26 @@ static void help(char *arg, const char *additional_opts_help) {
           "  --time_truth requests that the converter upload any timing "
           "information to the time truth module. Option has no practical "
           "purposes other than to run fuzz testing on it.\n");
+  fprintf(stderr,
+          "  --threaded read the input on a separate thread, decoupling slow "
+          "reads from conversion. Input which arrives while the %u byte "
+          "ingest buffer is full is dropped, ring statistics are reported on "
+          "exit.\n",
+          INGEST_RING_SIZE);
+  fprintf(stderr,
+          "  --mmap FILE convert FILE instead of stdin. The file is memory "
+          "mapped and output is written in large blocks, intended for "
+          "reprocessing logs. Not compatible with --threaded.\n");
+  fprintf(stderr,
+          "  --jobs N with --mmap, split FILE at frame boundaries into N "
+          "shards (at most %u) which are converted in parallel and written "
+          "out in order. Not compatible with --time_truth.\n",
+          TOOL_MAX_JOBS);
+  fprintf(stderr,
+          "  --warmup BYTES with --jobs, amount of input each shard converts "
+          "without output before its own range so that ephemeris and time "
+          "state can settle. Defaults to %u\n",
+          TOOL_DEFAULT_WARMUP_SIZE);
 }
 
 int ubx2sbp(int argc,
@@ -64,12 +213,22 @@ int ubx2sbp(int argc,
   struct ubx_sbp_state state;
   ubx_sbp_init(&state, &sbp_write, context);
 
+  bool threaded = false;
+  bool time_truth = false;
+  const char *mmap_path = NULL;
+  unsigned jobs = 1;
+  size_t warmup = TOOL_DEFAULT_WARMUP_SIZE;
+
   int opt;
   int option_index = 0;
   static struct option long_options[] = {
       {"hnr", no_argument, 0, 0},
       {"sender_id", required_argument, 0, 's'},
       {"time_truth", no_argument, 0, 't'},
+      {"threaded", no_argument, 0, 0},
+      {"mmap", required_argument, 0, 0},
+      {"jobs", required_argument, 0, 0},
+      {"warmup", required_argument, 0, 0},
       {0, 0, 0, 0}};
 
   while ((opt = getopt_long(argc, argv, "hs:", long_options, &option_index)) !=
@@ -78,6 +237,19 @@ int ubx2sbp(int argc,
       case 0:
         if (strcmp("hnr", long_options[option_index].name) == 0) {
           ubx_set_hnr_flag(&state, true);
+        } else if (strcmp("threaded", long_options[option_index].name) == 0) {
+          threaded = true;
+        } else if (strcmp("mmap", long_options[option_index].name) == 0) {
+          mmap_path = optarg;
+        } else if (strcmp("jobs", long_options[option_index].name) == 0) {
+          jobs = (unsigned)strtoul(optarg, NULL, 0);
+          if (jobs == 0 || jobs > TOOL_MAX_JOBS) {
+            fprintf(
+                stderr, "--jobs must be between 1 and %u\n", TOOL_MAX_JOBS);
+            return 1;
+          }
+        } else if (strcmp("warmup", long_options[option_index].name) == 0) {
+          warmup = (size_t)strtoull(optarg, NULL, 0);
         }
         break;
 
@@ -91,6 +263,7 @@ int ubx2sbp(int argc,
 
       case 't':
         if (strcmp("time_truth", long_options[option_index].name) == 0) {
+          time_truth = true;
           ObservationTimeEstimator *observation_time_estimator = NULL;
           EphemerisTimeEstimator *ephemeris_time_estimator = NULL;
           UbxLeapTimeEstimator *ubx_leap_time_estimator = NULL;
@@ -120,10 +293,53 @@ int ubx2sbp(int argc,
     }
   }
 
+  if (jobs > 1 && (mmap_path == NULL || time_truth)) {
+    fprintf(stderr, "--jobs requires --mmap and excludes --time_truth\n");
+    return 1;
+  }
+
+  if (mmap_path != NULL && threaded) {
+    fprintf(stderr, "--mmap and --threaded can't be combined\n");
+    return 1;
+  }
+
+  if (mmap_path != NULL) {
+    tool_output_init(&output, writefn, context);
+    sbp_state_set_io_context(&sbp_state, &output);
+    ubx2sbp_writefn = tool_output_writefn;
+    struct mapped_conversion conversion = {
+        .state = &state, .jobs = jobs, .warmup = warmup};
+    return tool_convert_mapped_file(mmap_path, convert_mapping, &conversion)
+               ? 0
+               : 1;
+  }
+
+  /* only joined when started, zeroed so the compiler can tell it is set */
+  pthread_t reader;
+  memset(&reader, 0, sizeof(reader));
+  if (threaded) {
+    spsc_ring_init(&ingest.ring, ingest.storage, sizeof(ingest.storage));
+    ingest.readfn = readfn;
+    ingest.context = context;
+    if (pthread_create(&reader, NULL, ingest_thread, NULL) != 0) {
+      fprintf(stderr, "Unable to start reader thread\n");
+      return 1;
+    }
+    readfn = ingest_readfn;
+  }
+
   int ret;
   do {
     ret = ubx_sbp_process(&state, readfn);
   } while (ret >= 0);
 
+  if (threaded) {
+    pthread_join(reader, NULL);
+    fprintf(stderr,
+            "Ingest ring: %zu bytes peak occupancy, %zu bytes dropped\n",
+            spsc_ring_high_water(&ingest.ring),
+            spsc_ring_dropped(&ingest.ring));
+  }
+
   return 0;
 }
@@ -28,6 +28,8 @@
 #include <ubx/decode.h>
 #include <ubx/encode.h>
 #include <ubx/ubx_messages.h>
+#include <ubx2sbp/internal/ubx2sbp.h>
+#include <unistd.h>
 
 #include "config.h"
 
@@ -675,6 +677,66 @@ void test_UBX(struct ubx_sbp_state *state, const char *filename) {
   } while (ret > 0);
 }
 
+// Running digest of every SBP message produced by a conversion, used to
+// compare the streaming and in-place buffer conversion paths.
+struct output_digest {
+  int n_msgs;
+  u16 crc;
+  bool muted;
+};
+
+static void ubx_sbp_callback_digest(uint16_t sender_id,
+                                    sbp_msg_type_t msg_type,
+                                    const sbp_msg_t *sbp_msg,
+                                    void *context) {
+  struct output_digest *digest = context;
+  uint8_t encoded[SBP_MAX_PAYLOAD_LEN];
+  uint8_t written;
+
+  if (digest->muted) {
+    return;
+  }
+
+  s8 ret = sbp_message_encode(
+      encoded, SBP_MAX_PAYLOAD_LEN, &written, msg_type, sbp_msg);
+  ck_assert(ret == SBP_OK);
+
+  uint8_t tmpbuf[5];
+  tmpbuf[0] = (uint8_t)msg_type;
+  tmpbuf[1] = (uint8_t)(((uint16_t)msg_type) >> 8);
+  tmpbuf[2] = (uint8_t)sender_id;
+  tmpbuf[3] = (uint8_t)(sender_id >> 8);
+  tmpbuf[4] = (uint8_t)written;
+
+  digest->crc = crc16_ccitt(tmpbuf, sizeof(tmpbuf), digest->crc);
+  digest->crc = crc16_ccitt(encoded, written, digest->crc);
+  digest->n_msgs++;
+}
+
+static void check_process_buffer(const char *filename) {
+  static uint8_t contents[MAX_FILE_SIZE];
+  struct output_digest streamed = {0, 0, false};
+  struct output_digest buffered = {0, 0, false};
+  struct ubx_sbp_state state;
+
+  ubx_sbp_init(&state, ubx_sbp_callback_digest, &streamed);
+  test_UBX(&state, filename);
+  fclose(fp);
+
+  fp = fopen(filename, "rb");
+  ck_assert(fp != NULL);
+  size_t length = fread(contents, sizeof(uint8_t), sizeof(contents), fp);
+  fclose(fp);
+  ck_assert_uint_gt(length, 0);
+
+  ubx_sbp_init(&state, ubx_sbp_callback_digest, &buffered);
+  ck_assert_uint_le(ubx_sbp_process_buffer(&state, contents, length), length);
+
+  ck_assert_int_gt(streamed.n_msgs, 0);
+  ck_assert_int_eq(buffered.n_msgs, streamed.n_msgs);
+  ck_assert_uint_eq(buffered.crc, streamed.crc);
+}
+
 static int create_esf_raw_imu_messages(uint8_t *dest,
                                        uint32_t starting_msss,
                                        double sample_interval_seconds,
@@ -951,6 +1013,226 @@ START_TEST(test_nav_vel_ecef) {
 }
 END_TEST
 
+/* Reference mapping, as originally written out signal by signal */
+static code_t reference_gnssid_sigid(u8 gnss_id, u8 sig_id) {
+  if ((gnss_id == UBX_GNSS_ID_GPS) && (sig_id == 0)) return CODE_GPS_L1CA;
+  if ((gnss_id == UBX_GNSS_ID_GPS) && (sig_id == 3)) return CODE_GPS_L2CL;
+  if ((gnss_id == UBX_GNSS_ID_GPS) && (sig_id == 4)) return CODE_GPS_L2CM;
+  if ((gnss_id == UBX_GNSS_ID_SBAS) && (sig_id == 0)) return CODE_SBAS_L1CA;
+  if ((gnss_id == UBX_GNSS_ID_GAL) && (sig_id == 0)) return CODE_GAL_E1C;
+  if ((gnss_id == UBX_GNSS_ID_GAL) && (sig_id == 1)) return CODE_GAL_E1B;
+  if ((gnss_id == UBX_GNSS_ID_GAL) && (sig_id == 5)) return CODE_GAL_E7I;
+  if ((gnss_id == UBX_GNSS_ID_GAL) && (sig_id == 6)) return CODE_GAL_E7Q;
+  if ((gnss_id == UBX_GNSS_ID_BDS) && (sig_id == 0)) return CODE_BDS2_B1;
+  if ((gnss_id == UBX_GNSS_ID_BDS) && (sig_id == 1)) return CODE_BDS2_B1;
+  if ((gnss_id == UBX_GNSS_ID_BDS) && (sig_id == 2)) return CODE_BDS2_B2;
+  if ((gnss_id == UBX_GNSS_ID_BDS) && (sig_id == 3)) return CODE_BDS2_B2;
+  if ((gnss_id == UBX_GNSS_ID_QZSS) && (sig_id == 0)) return CODE_QZS_L1CA;
+  if ((gnss_id == UBX_GNSS_ID_QZSS) && (sig_id == 4)) return CODE_QZS_L2CM;
+  if ((gnss_id == UBX_GNSS_ID_QZSS) && (sig_id == 5)) return CODE_QZS_L2CL;
+  if ((gnss_id == UBX_GNSS_ID_GLO) && (sig_id == 0)) return CODE_GLO_L1OF;
+  if ((gnss_id == UBX_GNSS_ID_GLO) && (sig_id == 2)) return CODE_GLO_L2OF;
+  return CODE_INVALID;
+}
+
+START_TEST(test_convert_gnssid_sigid) {
+  for (int gnss_id = 0; gnss_id <= UINT8_MAX; gnss_id++) {
+    for (int sig_id = 0; sig_id <= UINT8_MAX; sig_id++) {
+      ck_assert_int_eq(ubx_convert_gnssid_sigid((u8)gnss_id, (u8)sig_id),
+                       reference_gnssid_sigid((u8)gnss_id, (u8)sig_id));
+    }
+  }
+}
+END_TEST
+
+START_TEST(test_process_buffer) {
+  check_process_buffer(RELATIVE_PATH_PREFIX "/data/nav_pvt_corrupted.ubx");
+  check_process_buffer(RELATIVE_PATH_PREFIX "/data/rxm_rawx.ubx");
+  check_process_buffer(RELATIVE_PATH_PREFIX "/data/rxm_sfrbx_gps.ubx");
+}
+END_TEST
+
+START_TEST(test_sharded_conversion) {
+  static uint8_t contents[MAX_FILE_SIZE];
+  const char *filename = RELATIVE_PATH_PREFIX "/data/rxm_sfrbx_gps.ubx";
+  const size_t n_shards = 3;
+  struct ubx_sbp_state state;
+
+  fp = fopen(filename, "rb");
+  ck_assert(fp != NULL);
+  size_t length = fread(contents, sizeof(uint8_t), sizeof(contents), fp);
+  fclose(fp);
+
+  struct output_digest serial = {0, 0, false};
+  ubx_sbp_init(&state, ubx_sbp_callback_digest, &serial);
+  ubx_sbp_process_buffer(&state, contents, length);
+
+  size_t first = ubx_sbp_frame_boundary(contents, length, 0);
+  ck_assert_uint_lt(first, length);
+  ck_assert_uint_eq(contents[first], UBX_SYNC_CHAR_1);
+  ck_assert_uint_eq(ubx_sbp_frame_boundary(contents, length, length), length);
+
+  /* Each shard replays everything before its range with the output muted,
+   * then keeps the output of its own frames only */
+  struct output_digest sharded = {0, 0, false};
+  size_t begin = 0;
+  for (size_t i = 0; i < n_shards; i++) {
+    size_t end = length;
+    if (i + 1 < n_shards) {
+      end = ubx_sbp_frame_boundary(
+          contents, length, length / n_shards * (i + 1));
+      ck_assert_uint_gt(end, begin);
+      ck_assert_uint_eq(contents[end], UBX_SYNC_CHAR_1);
+      ck_assert_uint_eq(contents[end + 1], UBX_SYNC_CHAR_2);
+    }
+
+    ubx_sbp_init(&state, ubx_sbp_callback_digest, &sharded);
+    sharded.muted = true;
+    ubx_sbp_process_buffer(&state, contents, begin);
+    sharded.muted = false;
+    ubx_sbp_process_buffer(&state, &contents[begin], end - begin);
+    begin = end;
+  }
+
+  ck_assert_int_gt(serial.n_msgs, 0);
+  ck_assert_int_eq(sharded.n_msgs, serial.n_msgs);
+  ck_assert_uint_eq(sharded.crc, serial.crc);
+}
+END_TEST
+
+struct tool_output {
+  uint8_t data[MAX_FILE_SIZE];
+  size_t length;
+};
+
+static int tool_writefn(uint8_t *buff, uint32_t n, void *context) {
+  struct tool_output *output = context;
+  ck_assert_uint_le(output->length + n, sizeof(output->data));
+  memcpy(&output->data[output->length], buff, n);
+  output->length += n;
+  return (int)n;
+}
+
+static void run_ubx2sbp(int argc, char **argv, struct tool_output *output) {
+  output->length = 0;
+  optind = 0;
+  ck_assert_int_eq(ubx2sbp(argc, argv, "", NULL, tool_writefn, output), 0);
+}
+
+START_TEST(test_sharded_conversion_warmup) {
+  static struct tool_output serial;
+  static struct tool_output sharded;
+  char arg0[] = "ubx2sbp";
+  char arg_mmap[] = "--mmap";
+  char arg_path[] = RELATIVE_PATH_PREFIX "/data/nav_pvt_fix_type.ubx";
+  char arg_jobs[] = "--jobs";
+  char arg_n_jobs[] = "3";
+  char arg_warmup[] = "--warmup";
+  /* 16 NAV-PVT frames of 100 bytes, so every shard but the first replays a
+   * single frame before its own range */
+  char arg_warmup_size[] = "150";
+
+  char *serial_argv[] = {arg0, arg_mmap, arg_path};
+  run_ubx2sbp(3, serial_argv, &serial);
+  ck_assert_uint_gt(serial.length, 0);
+
+  char *sharded_argv[] = {arg0,
+                          arg_mmap,
+                          arg_path,
+                          arg_jobs,
+                          arg_n_jobs,
+                          arg_warmup,
+                          arg_warmup_size};
+  run_ubx2sbp(7, sharded_argv, &sharded);
+
+  /* output of the warm-up frames is dropped and every frame comes out exactly
+   * once, in file order */
+  ck_assert_uint_eq(sharded.length, serial.length);
+  ck_assert_int_eq(memcmp(sharded.data, serial.data, serial.length), 0);
+}
+END_TEST
+
+static size_t read_fixture(const char *filename, uint8_t *data, size_t size) {
+  FILE *fixture = fopen(filename, "rb");
+  ck_assert(fixture != NULL);
+  size_t length = fread(data, sizeof(uint8_t), size, fixture);
+  fclose(fixture);
+  ck_assert_uint_gt(length, 0);
+  return length;
+}
+
+START_TEST(test_sharded_conversion_mixed_nav) {
+  static struct tool_output serial;
+  static struct tool_output sharded;
+  uint8_t nav_pvt[1600];
+  uint8_t nav_att[140];
+  uint8_t nav_velecef[128];
+  uint8_t hnr_pvt[180];
+
+  /* the NAV-PVT fixture holds 16 frames of 100 bytes with changing fix types,
+   * the others a NAV-PVT frame followed by the message of interest */
+  ck_assert_uint_eq(
+      read_fixture(RELATIVE_PATH_PREFIX "/data/nav_pvt_fix_type.ubx",
+                   nav_pvt,
+                   sizeof(nav_pvt)),
+      sizeof(nav_pvt));
+  ck_assert_uint_eq(read_fixture(RELATIVE_PATH_PREFIX "/data/nav_att.ubx",
+                                 nav_att,
+                                 sizeof(nav_att)),
+                    sizeof(nav_att));
+  ck_assert_uint_eq(read_fixture(RELATIVE_PATH_PREFIX "/data/nav_velecef.ubx",
+                                 nav_velecef,
+                                 sizeof(nav_velecef)),
+                    sizeof(nav_velecef));
+  ck_assert_uint_eq(read_fixture(RELATIVE_PATH_PREFIX "/data/hnr_pvt.ubx",
+                                 hnr_pvt,
+                                 sizeof(hnr_pvt)),
+                    sizeof(hnr_pvt));
+
+  /* NAV-ATT, NAV-VELECEF and HNR-PVT output takes the fix type, flags and
+   * satellite count of the last NAV-PVT, so each shard has to carry its own
+   * copy for the output to match the serial run */
+  strncpy(tmp_file_name, "XXXXXX", FILENAME_MAX);
+  int fd = mkstemp(tmp_file_name);
+  fp = fdopen(fd, "wb");
+  for (int i = 0; i < 2000; i++) {
+    write_bytes_to_file(&nav_pvt[(i % 16) * 100], 100, fp);
+    write_bytes_to_file(&nav_att[100], 40, fp);
+    write_bytes_to_file(&nav_velecef[100], 28, fp);
+    write_bytes_to_file(&hnr_pvt[100], 80, fp);
+  }
+  fclose(fp);
+
+  char arg0[] = "ubx2sbp";
+  char arg_mmap[] = "--mmap";
+  char arg_jobs[] = "--jobs";
+  char arg_n_jobs[] = "4";
+  char arg_warmup[] = "--warmup";
+  /* one 248 byte group of frames, enough to see the previous NAV-PVT */
+  char arg_warmup_size[] = "248";
+  char arg_hnr[] = "--hnr";
+
+  for (int hnr = 0; hnr <= 1; hnr++) {
+    char *serial_argv[] = {arg0, arg_mmap, tmp_file_name, arg_hnr};
+    run_ubx2sbp(3 + hnr, serial_argv, &serial);
+    ck_assert_uint_gt(serial.length, 0);
+
+    char *sharded_argv[] = {arg0,
+                            arg_mmap,
+                            tmp_file_name,
+                            arg_jobs,
+                            arg_n_jobs,
+                            arg_warmup,
+                            arg_warmup_size,
+                            arg_hnr};
+    run_ubx2sbp(7 + hnr, sharded_argv, &sharded);
+
+    ck_assert_uint_eq(sharded.length, serial.length);
+    ck_assert_int_eq(memcmp(sharded.data, serial.data, serial.length), 0);
+  }
+}
+END_TEST
+
 START_TEST(test_rxm_rawx) {
   struct ubx_sbp_state state;
   ubx_sbp_init(&state, ubx_sbp_callback_rxm_rawx, NULL);
@@ -967,6 +1249,21 @@ START_TEST(test_rxm_sfrbx_gps) {
 }
 END_TEST
 
+START_TEST(test_rxm_sfrbx_gps_skip_unchanged) {
+  struct ubx_sbp_state state;
+  ubx_sbp_init(&state, ubx_sbp_callback_rxm_sfrbx_gps, NULL);
+
+  test_UBX(&state, RELATIVE_PATH_PREFIX "/data/rxm_sfrbx_gps.ubx");
+  u32 emitted = state.eph_data.eph_emitted;
+  ck_assert_uint_gt(emitted, 0);
+
+  /* Replaying the same subframes must not produce any new ephemeris */
+  test_UBX(&state, RELATIVE_PATH_PREFIX "/data/rxm_sfrbx_gps.ubx");
+  ck_assert_uint_eq(state.eph_data.eph_emitted, emitted);
+  ck_assert_uint_gt(state.eph_data.eph_skipped, 0);
+}
+END_TEST
+
 START_TEST(test_rxm_sfrbx_glo) {
   struct ubx_sbp_state state;
   ubx_sbp_init(&state, ubx_sbp_callback_rxm_sfrbx_glo, NULL);
@@ -975,6 +1272,22 @@ START_TEST(test_rxm_sfrbx_glo) {
 }
 END_TEST
 
+START_TEST(test_rxm_sfrbx_glo_skip_unchanged) {
+  struct ubx_sbp_state state;
+  ubx_sbp_init(&state, ubx_sbp_callback_rxm_sfrbx_glo, NULL);
+
+  test_UBX(&state, RELATIVE_PATH_PREFIX "/data/rxm_sfrbx_glo.ubx");
+  u32 emitted = state.eph_data.eph_emitted;
+  u32 skipped = state.eph_data.eph_skipped;
+  ck_assert_uint_gt(emitted, 0);
+
+  /* Replaying the same subframes must not produce any new ephemeris */
+  test_UBX(&state, RELATIVE_PATH_PREFIX "/data/rxm_sfrbx_glo.ubx");
+  ck_assert_uint_eq(state.eph_data.eph_emitted, emitted);
+  ck_assert_uint_gt(state.eph_data.eph_skipped, skipped);
+}
+END_TEST
+
 START_TEST(test_rxm_sfrbx_bds) {
   struct ubx_sbp_state state;
   ubx_sbp_init(&state, ubx_sbp_callback_rxm_sfrbx_bds, NULL);
@@ -983,6 +1296,22 @@ START_TEST(test_rxm_sfrbx_bds) {
 }
 END_TEST
 
+START_TEST(test_rxm_sfrbx_bds_skip_unchanged) {
+  struct ubx_sbp_state state;
+  ubx_sbp_init(&state, ubx_sbp_callback_rxm_sfrbx_bds, NULL);
+
+  test_UBX(&state, RELATIVE_PATH_PREFIX "/data/rxm_sfrbx_bds.ubx");
+  u32 emitted = state.eph_data.eph_emitted;
+  u32 skipped = state.eph_data.eph_skipped;
+  ck_assert_uint_gt(emitted, 0);
+
+  /* Replaying the same subframes must not produce any new ephemeris */
+  test_UBX(&state, RELATIVE_PATH_PREFIX "/data/rxm_sfrbx_bds.ubx");
+  ck_assert_uint_eq(state.eph_data.eph_emitted, emitted);
+  ck_assert_uint_gt(state.eph_data.eph_skipped, skipped);
+}
+END_TEST
+
 START_TEST(test_rxm_sfrbx_gal) {
   struct ubx_sbp_state state;
   ubx_sbp_init(&state, ubx_sbp_callback_rxm_sfrbx_gal, NULL);
@@ -991,6 +1320,22 @@ START_TEST(test_rxm_sfrbx_gal) {
 }
 END_TEST
 
+START_TEST(test_rxm_sfrbx_gal_skip_unchanged) {
+  struct ubx_sbp_state state;
+  ubx_sbp_init(&state, ubx_sbp_callback_rxm_sfrbx_gal, NULL);
+
+  test_UBX(&state, RELATIVE_PATH_PREFIX "/data/rxm_sfrbx_gal.ubx");
+  u32 emitted = state.eph_data.eph_emitted;
+  u32 skipped = state.eph_data.eph_skipped;
+  ck_assert_uint_gt(emitted, 0);
+
+  /* Replaying the same subframes must not produce any new ephemeris */
+  test_UBX(&state, RELATIVE_PATH_PREFIX "/data/rxm_sfrbx_gal.ubx");
+  ck_assert_uint_eq(state.eph_data.eph_emitted, emitted);
+  ck_assert_uint_gt(state.eph_data.eph_skipped, skipped);
+}
+END_TEST
+
 START_TEST(test_rxm_sfrbx_sbas) {
   struct ubx_sbp_state state;
   ubx_sbp_init(&state, ubx_sbp_callback_rxm_sfrbx_sbas, NULL);
@@ -1256,6 +1601,99 @@ START_TEST(test_esf_raw) {
 }
 END_TEST
 
+START_TEST(test_esf_raw_batch) {
+  struct ubx_sbp_state state;
+  ubx_sbp_init(&state, NULL, NULL);
+
+  uint8_t buffer[2048];
+  // 21 complete samples is as many as a single ESF-RAW can hold
+  int n_bytes = create_esf_raw_imu_messages(buffer, 4711, 0.01, 21);
+
+  swiftnav_bytestream_t frame;
+  swiftnav_bytestream_init(&frame, &buffer[2], n_bytes - 4);
+
+  struct ubx_sbp_imu_msg msgs[UBX_ESF_RAW_MAX_SBP_MSGS];
+  size_t n_msgs = ubx_convert_esf_raw(&state, &frame, msgs, ARRAY_SIZE(msgs));
+  ck_assert_uint_eq(n_msgs, UBX_ESF_RAW_MAX_SBP_MSGS);
+
+  // an IMU_AUX precedes every 20th IMU_RAW
+  u32 last_tow = 0;
+  for (size_t i = 0; i < n_msgs; i++) {
+    if (i == 0 || i == 21) {
+      ck_assert_int_eq(msgs[i].msg_type, SbpMsgImuAux);
+      continue;
+    }
+    ck_assert_int_eq(msgs[i].msg_type, SbpMsgImuRaw);
+    ck_assert_uint_gt(msgs[i].msg.imu_raw.tow, last_tow);
+    last_tow = msgs[i].msg.imu_raw.tow;
+  }
+
+  // a short output buffer is filled and the rest of the frame discarded
+  swiftnav_bytestream_init(&frame, &buffer[2], n_bytes - 4);
+  n_msgs = ubx_convert_esf_raw(&state, &frame, msgs, 5);
+  ck_assert_uint_eq(n_msgs, 5);
+  ck_assert_int_eq(msgs[0].msg_type, SbpMsgImuRaw);
+}
+END_TEST
+
+START_TEST(test_esf_raw_batch_temperature) {
+  struct ubx_sbp_state state;
+  ubx_sbp_init(&state, NULL, NULL);
+
+  ubx_esf_raw msg_esf_raw;
+  memset(&msg_esf_raw, 0, sizeof(ubx_esf_raw));
+  msg_esf_raw.msss = 4711;
+  msg_esf_raw.class_id = UBX_CLASS_ESF;
+  msg_esf_raw.msg_id = UBX_MSG_ESF_RAW;
+
+  uint8_t sensor_tag[] = {ESF_X_AXIS_ACCEL_SPECIFIC_FORCE,
+                          ESF_Y_AXIS_ACCEL_SPECIFIC_FORCE,
+                          ESF_Z_AXIS_ACCEL_SPECIFIC_FORCE,
+                          ESF_X_AXIS_GYRO_ANG_RATE,
+                          ESF_Y_AXIS_GYRO_ANG_RATE,
+                          ESF_Z_AXIS_GYRO_ANG_RATE};
+  // 20 degrees, 20 IMU samples, 30 degrees and one more IMU sample: the
+  // IMU_AUX preceding the 21st IMU_RAW must carry the second temperature, the
+  // first one the temperature read before it
+  int n_data = 0;
+  for (int sample_idx = 0; sample_idx < 21; sample_idx++) {
+    if (sample_idx == 0 || sample_idx == 20) {
+      msg_esf_raw.data[n_data] =
+          (ESF_GYRO_TEMP << 24) | (sample_idx == 0 ? 2000 : 3000);
+      msg_esf_raw.sensor_time_tag[n_data] = 1234 + sample_idx * 256;
+      n_data++;
+    }
+    for (int sensor_idx = 0; sensor_idx < 6; sensor_idx++) {
+      msg_esf_raw.data[n_data] = (sensor_tag[sensor_idx] << 24) | 0;
+      msg_esf_raw.sensor_time_tag[n_data] = 1234 + sample_idx * 256;
+      n_data++;
+    }
+  }
+  msg_esf_raw.length = 4 + 8 * n_data;
+
+  uint8_t buffer[2048];
+  int n_bytes = ubx_encode_esf_raw(&msg_esf_raw, buffer);
+
+  swiftnav_bytestream_t frame;
+  swiftnav_bytestream_init(&frame, buffer, n_bytes);
+
+  struct ubx_sbp_imu_msg msgs[UBX_ESF_RAW_MAX_SBP_MSGS];
+  size_t n_msgs = ubx_convert_esf_raw(&state, &frame, msgs, ARRAY_SIZE(msgs));
+  ck_assert_uint_eq(n_msgs, UBX_ESF_RAW_MAX_SBP_MSGS);
+
+  ck_assert_int_eq(msgs[0].msg_type, SbpMsgImuAux);
+  ck_assert_int_eq(msgs[0].msg.imu_aux.temp,
+                   ubx_convert_temperature_to_bmi160(20.0));
+  ck_assert_int_eq(msgs[21].msg_type, SbpMsgImuAux);
+  ck_assert_int_eq(msgs[21].msg.imu_aux.temp,
+                   ubx_convert_temperature_to_bmi160(30.0));
+
+  // the last temperature of the frame carries over to the next one
+  ck_assert(state.esf_state.temperature_set);
+  ck_assert(fabs(state.esf_state.last_imu_temp - 30.0) < 1e-9);
+}
+END_TEST
+
 START_TEST(test_convert_temperature) {
   /* Check that the conversion yields the same results that would be expected
    * for the BMI160 IMU */
@@ -1377,6 +1815,10 @@ Suite *ubx_suite(void) {
   tcase_add_test(tc_nav, test_nav_vel_ecef);
   tcase_add_test(tc_nav, test_nav_sat);
   tcase_add_test(tc_nav, test_nav_status);
+  tcase_add_test(tc_nav, test_process_buffer);
+  tcase_add_test(tc_nav, test_sharded_conversion);
+  tcase_add_test(tc_nav, test_sharded_conversion_warmup);
+  tcase_add_test(tc_nav, test_sharded_conversion_mixed_nav);
   tcase_add_checked_fixture(tc_nav, NULL, tmp_file_teardown);
   suite_add_tcase(s, tc_nav);
 
@@ -1385,6 +1827,8 @@ Suite *ubx_suite(void) {
   tcase_add_test(tc_esf, test_imu_timestamps_msss_rollover);
   tcase_add_test(tc_esf, test_esf_meas);
   tcase_add_test(tc_esf, test_esf_raw);
+  tcase_add_test(tc_esf, test_esf_raw_batch);
+  tcase_add_test(tc_esf, test_esf_raw_batch_temperature);
   tcase_add_test(tc_esf, test_convert_temperature);
   tcase_add_test(tc_esf, test_encode_negative_temperature);
   tcase_add_test(tc_esf, test_encode_positive_temperature);
@@ -1396,11 +1840,16 @@ Suite *ubx_suite(void) {
   suite_add_tcase(s, tc_esf);
 
   TCase *tc_rxm = tcase_create("UBX_RXM");
+  tcase_add_test(tc_rxm, test_convert_gnssid_sigid);
   tcase_add_test(tc_rxm, test_rxm_rawx);
   tcase_add_test(tc_rxm, test_rxm_sfrbx_gps);
+  tcase_add_test(tc_rxm, test_rxm_sfrbx_gps_skip_unchanged);
   tcase_add_test(tc_rxm, test_rxm_sfrbx_glo);
+  tcase_add_test(tc_rxm, test_rxm_sfrbx_glo_skip_unchanged);
   tcase_add_test(tc_rxm, test_rxm_sfrbx_bds);
+  tcase_add_test(tc_rxm, test_rxm_sfrbx_bds_skip_unchanged);
   tcase_add_test(tc_rxm, test_rxm_sfrbx_gal);
+  tcase_add_test(tc_rxm, test_rxm_sfrbx_gal_skip_unchanged);
   tcase_add_test(tc_rxm, test_rxm_sfrbx_sbas);
   tcase_add_test(tc_rxm, test_rxm_sfrbx_sbas_f9_series);
   suite_add_tcase(s, tc_rxm);